@@ -12,18 +12,60 @@
 #define ESP32MODULES__CONNECTIVITY_BLUETOOTHLE_HPP_
 
 // Standard header
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
+#include <string_view>
 
 // Platform header
 #include <BLEServer.h>
+#include <esp_timer.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandFrame.hpp>
+#include <esp32-modules/connectivity/CommandRouter.hpp>
+#include <esp32-modules/connectivity/ConnectionManager.hpp>
+#include <esp32-modules/connectivity/SendQueue.hpp>
+#include <esp32-modules/core/containers/FrameRing.hpp>
+#include <esp32-modules/core/scheduling/TaskEvent.hpp>
+
+// Size of the receiving buffer in bytes (power of two). Each received payload takes its length plus
+// six bytes (length prefix and receive timestamp).
+#ifndef ESP32MODULES_BLE_RX_BUFFER_SIZE
+#define ESP32MODULES_BLE_RX_BUFFER_SIZE 2048
+#endif
+
+// Size of the sending buffer in bytes (power of two). Each queued message takes its length plus two
+// bytes.
+#ifndef ESP32MODULES_BLE_TX_BUFFER_SIZE
+#define ESP32MODULES_BLE_TX_BUFFER_SIZE 2048
+#endif
+
+// Maximum number of notifications handed to the BLE stack but not yet sent (i.e. without their
+// ESP_GATTS_CONF_EVT).
+#ifndef ESP32MODULES_BLE_TX_MAX_IN_FLIGHT
+#define ESP32MODULES_BLE_TX_MAX_IN_FLIGHT 4
+#endif
+
+// Maximum number of receivers with a sending characteristic at the same time (each one needs the
+// completion events of its GATT interface).
+#ifndef ESP32MODULES_BLE_MAX_TRANSMITTERS
+#define ESP32MODULES_BLE_MAX_TRANSMITTERS 2
+#endif
 
 namespace Esp32Modules::Connectivity::BluetoothLE
 {
+/** Protocol of the received commands. */
+enum class CommandProtocol
+{
+  TEXT,   //!< One "token parameters" command per write.
+  BINARY  //!< Binary frames (see CommandFrame.hpp), batched and fragmented arbitrarily.
+};
+
 /**
  * @brief Sets up a BLE service to receive commands and dispatch them to callbacks registered by the
  * application.
@@ -32,9 +74,25 @@ namespace Esp32Modules::Connectivity::BluetoothLE
  * commands to the device. A command consists of a token followed by a space and optionally
  * parameters. The raw string of parameters will be passed to the registered callback.
  *
+ * Alternatively, commands can be sent as compact binary frames (id, length, payload and CRC). Any
+ * number of frames may be batched into a single write and frames may be split across several
+ * MTU-sized writes - the receiver reassembles them. This saves a round trip per command when
+ * sending bulk updates.
+ *
+ * Optionally, a second characteristic notifies peers about messages sent by the application (e.g.
+ * responses or telemetry). Messages are queued and coalesced into notifications of the negotiated
+ * MTU, which are only handed to the BLE stack as long as it completes them. The completions are
+ * received via the custom GATT server handler of the BLE device (see
+ * BLEDevice::setCustomGattsHandler()), which must not be replaced by the application. It serves up
+ * to ESP32MODULES_BLE_MAX_TRANSMITTERS receivers at a time, further ones cannot send (i.e. Send()
+ * always fails).
+ *
  * Note that the BLE device runs asynchronously in the background and pushes received payloads to a
- * thread-safe queue. The application is responsible to regularily check for updates by calling the
- * ProcessPendingCommands() method.
+ * bounded, lock-free ring buffer (without heap allocations). The application is responsible to
+ * regularily check for updates by calling the ProcessPendingCommands() method - or to let a
+ * TaskEvent call it as soon as payloads were received (see SetReceiveEvent()). If the application
+ * falls behind, payloads are dropped according to the overflow policy - see GetReceiveStatistics()
+ * to size the buffer.
  *
  */
 class BleCommandReceiver
@@ -46,16 +104,37 @@ class BleCommandReceiver
    * @param deviceName Name of the BLE device (visible on the interface).
    * @param serviceUuid Uuid of the BLE service (visible on the interface).
    * @param rxUuid Uuid of the writable, receiving BLE characteristic (visible on the interface).
+   * @param rxOverflowPolicy Payloads to be dropped (or rejected) if the receiving buffer is full.
+   * Note that the BLE library acknowledges a write before passing it on, so the peer is not told
+   * about rejected payloads either (they are only counted separately, see ReceiveStatistics).
+   * @param protocol Protocol of the received commands.
+   * @param txUuid Uuid of the notifying, sending BLE characteristic - empty to send nothing.
+   * @param advertising Timing of the (re-)advertising.
    */
   BleCommandReceiver(const std::string& deviceName, const std::string& serviceUuid,
-                     const std::string& rxUuid);
-  ~BleCommandReceiver() = default;
+                     const std::string& rxUuid,
+                     const Core::Containers::OverflowPolicy rxOverflowPolicy =
+                         Core::Containers::OverflowPolicy::DROP_NEWEST,
+                     const CommandProtocol protocol = CommandProtocol::TEXT,
+                     const std::string& txUuid = {},
+                     const AdvertisingConfig& advertising = {});
+  ~BleCommandReceiver();
+
+  /** Type of the receiving queue (lock-free for one producer and one consumer). */
+  using BleReceivingQueue = Core::Containers::FrameRing<ESP32MODULES_BLE_RX_BUFFER_SIZE>;
 
-  /** Type of the receiving queue (not thread-safe). */
-  using BleReceivingQueue = std::queue<std::string>;
+  /** Maximum length of a characteristic value (and thus of a payload or notification). */
+  static constexpr size_t MAX_VALUE_SIZE{512};
 
-  /** Type of a callback triggered when processing pending commands. */
-  using BleCommandCallback = std::function<void(const std::string&)>;
+  /** Type of the sending queue (coalescing messages into notifications). */
+  using BleSendingQueue = SendQueue<ESP32MODULES_BLE_TX_BUFFER_SIZE, MAX_VALUE_SIZE>;
+
+  /**
+   * @brief Type of a callback triggered when processing pending commands.
+   *
+   * The parameters are a view into the received payload, only valid during the callback.
+   */
+  using BleCommandCallback = CommandRouter::Callback;
 
   /**
    * @brief Registers a new callback for a given command token.
@@ -67,21 +146,175 @@ class BleCommandReceiver
    * @return true if the callback was registered sucessfully, false otherwise (e.g. if the token was
    * already registered).
    */
-  bool RegisterCallback(const std::string& token, const BleCommandCallback& cb);
+  bool RegisterCallback(const std::string_view token, BleCommandCallback cb);
 
   /**
-   * @brief Process any pending commands received since the last call.
+   * @brief Dispatches the text commands via the given router (e.g. one shared with other
+   * transports) instead of the own one.
+   *
+   * Callbacks registered before are kept by the own router and thus no longer executed.
    *
    * @note Thread-safe.
+   *
+   * @param router Router to be used, has to outlive the receiver.
+   */
+  void SetRouter(CommandRouter& router);
+
+  /**
+   * @brief Type of a callback triggered when processing pending binary frames.
+   *
+   * The payload is only valid during the callback.
+   */
+  using BleFrameCallback = std::function<void(const uint8_t* payload, size_t length)>;
+
+  /**
+   * @brief Registers a new callback for a given frame id (CommandProtocol::BINARY only).
+   *
+   * @note Thread-safe.
+   *
+   * @param id Id by which the command is identified.
+   * @param cb Callback to be called when processing pending frames with the id.
+   * @return true if the callback was registered sucessfully, false otherwise (e.g. if the id was
+   * already registered).
+   */
+  bool RegisterFrameCallback(const uint8_t id, BleFrameCallback cb);
+
+  /**
+   * @brief Process any pending commands received since the last call.
+   *
+   * A frame left incomplete by a disconnected peer is dropped before the writes of the next peer
+   * are decoded. Connection events are processed as well (see ProcessConnectionEvents()), and the
+   * receive event (if set) is also signaled on connects, disconnects and when the advertising is
+   * due to be restarted or backed off - so calling this method on the receive event suffices.
+   *
+   * @note Only to be called from a single context.
    */
   void ProcessPendingCommands();
 
+  /**
+   * @brief Sets an event signaled whenever a payload was received (e.g. one calling
+   * ProcessPendingCommands() instead of polling for commands).
+   *
+   * @note Thread-safe.
+   *
+   * @param event Event to be signaled - nullptr to stop signaling.
+   */
+  void SetReceiveEvent(Core::Scheduling::TaskEvent* event);
+
+  /**
+   * @brief Counters of the receiving queue (e.g. to size ESP32MODULES_BLE_RX_BUFFER_SIZE).
+   */
+  struct ReceiveStatistics
+  {
+    uint32_t enqueued;      //!< Number of payloads (and disconnects) queued.
+    uint32_t dispatched;    //!< Number of payloads (and disconnects) taken from the queue.
+    uint32_t dropped;       //!< Number of payloads dropped (queue full or too large).
+    uint32_t rejected;      //!< Number of payloads rejected (with OverflowPolicy::REJECT).
+    uint32_t peakDepth;     //!< Maximum number of bytes queued (including overhead).
+    uint32_t maxLatency;    //!< Longest time from queuing to dispatching in microseconds.
+    uint64_t totalLatency;  //!< Sum of all times from queuing to dispatching in microseconds.
+  };
+
+  /**
+   * @brief Provides the counters of the receiving queue.
+   *
+   * @note The latencies are only consistent in the context processing the pending commands.
+   *
+   * @return Current statistics.
+   */
+  ReceiveStatistics GetReceiveStatistics() const;
+
+  /**
+   * @brief Provides the counters of the frame decoder (decoded and corrupted frames).
+   *
+   * @note Only to be called from the context processing the pending commands.
+   *
+   * @return Current statistics.
+   */
+  FrameDecoder::Statistics GetFrameStatistics() const;
+
+  /**
+   * @brief Queues a message to be notified to the connected peer.
+   *
+   * @note Thread-safe for a single thread sending messages.
+   *
+   * @param data Content of the message.
+   * @param length Size of the message (at most MAX_VALUE_SIZE).
+   * @return true if the message was queued, false if there is no sending characteristic (or no
+   * transmitter slot, see ESP32MODULES_BLE_MAX_TRANSMITTERS) or the message was rejected (too large
+   * or queue full).
+   */
+  bool Send(const uint8_t* data, const size_t length);
+
+  /**
+   * @brief Queues a message to be notified to the connected peer (see above).
+   */
+  bool Send(const std::string_view message);
+
+  /**
+   * @brief Notifies the queued messages as far as the BLE stack keeps up.
+   *
+   * To be called regularily (e.g. by a cyclic task). Messages queued while no peer is connected
+   * are kept until the next peer connects - or until the queue overflows.
+   *
+   * @note Only to be called from a single context.
+   */
+  void ProcessPendingTransmissions();
+
+  /**
+   * @brief Processes connects and disconnects of peers and restarts the advertising if necessary.
+   *
+   * Called by ProcessPendingCommands(), so only needed if no commands are processed. Advertising
+   * is restarted without blocking the BLE stack on the first call after the restart delay passed.
+   *
+   * @note Only to be called from the context processing the pending commands.
+   */
+  void ProcessConnectionEvents();
+
+  /**
+   * @brief Sets a callback executed on connection state changes (in ProcessConnectionEvents()).
+   *
+   * @note Not thread-safe, to be set up before processing connection events.
+   *
+   * @param callback Callback to be executed - nullptr for none.
+   */
+  void SetConnectionCallback(ConnectionManager::StateCallback callback);
+
+  /** @brief Current connection state (as of the last call of ProcessConnectionEvents()). */
+  ConnectionState GetConnectionState() const;
+
+  /** @brief Provides the counters of the connection handling. */
+  ConnectionManager::Statistics GetConnectionStatistics() const;
+
+  /**
+   * @brief Provides the counters of the sending queue (messages, notifications, stalls).
+   *
+   * @note Only to be called from the context processing the pending transmissions.
+   *
+   * @return Current statistics - all zero if there is no sending characteristic.
+   */
+  BleSendingQueue::Statistics GetSendStatistics() const;
+
  private:
   std::unique_ptr<BLEServer> mBLEServer;  //!< Underlying BLE server providing the characteristic.
-  std::mutex mMutex;  //!< Mutex to make the receiving queue and callbacks thread-safe.
-  std::map<std::string, BleCommandCallback>
-      mCallbacks;              //!< List of known callbacks per command token.
+  std::mutex mMutex;                    //!< Mutex to make the frame callbacks thread-safe.
+  CommandRouter mOwnRouter;             //!< Router used unless another one is set.
+  std::atomic<CommandRouter*> mRouter;  //!< Router dispatching the text commands.
+  std::map<uint8_t, BleFrameCallback> mFrameCallbacks;  //!< Known callbacks per frame id.
+  const CommandProtocol mProtocol;                      //!< Protocol of the received commands.
+  FrameDecoder mFrameDecoder;  //!< Reassembles binary frames from the received payloads.
   BleReceivingQueue mRxQueue;  //!< Receiving queue.
+  uint32_t mMaxRxLatency;      //!< Longest time from queuing to dispatching.
+  uint64_t mTotalRxLatency;    //!< Sum of all times from queuing to dispatching.
+  std::atomic<Core::Scheduling::TaskEvent*>
+      mReceiveEvent;  //!< Event signaled on received payloads (optional).
+  std::unique_ptr<BleSendingQueue>
+      mTxQueue;                     //!< Sending queue (only if there is a sending characteristic).
+  ConnectionManager mConnection;    //!< Handles connects, disconnects and advertising.
+  esp_timer_handle_t mUpdateTimer;  //!< Signals the receive event when an update is due.
+
+  /** (Re-)starts advertising with the given interval in milliseconds. */
+  void Advertise(const uint16_t interval);
 };
 
 }  // namespace Esp32Modules::Connectivity::BluetoothLE
@@ -0,0 +1,153 @@
+/**
+ * @file CommandFrame.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a compact binary framing of commands (encoding and reassembling decoding).
+ * @version 0.1
+ * @date 2021-09-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_COMMANDFRAME_HPP_
+#define ESP32MODULES__CONNECTIVITY_COMMANDFRAME_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+
+// Maximum payload size of a single binary command frame in bytes.
+#ifndef ESP32MODULES_COMMAND_FRAME_MAX_PAYLOAD
+#define ESP32MODULES_COMMAND_FRAME_MAX_PAYLOAD 256
+#endif
+
+namespace Esp32Modules::Connectivity
+{
+/**
+ * Layout of a frame (multi-byte fields are little-endian):
+ *
+ *   | sync (0xA5) | id | length (2) | payload (length) | CRC-16 (2) |
+ *
+ * The CRC (CRC-16/CCITT-FALSE) covers the id, the length and the payload. Frames are simply
+ * concatenated, so several of them fit into a single write and a frame may be split across writes.
+ */
+constexpr uint8_t FRAME_SYNC{0xA5};
+/** Number of bytes preceding the payload. */
+constexpr size_t FRAME_HEADER_SIZE{4};
+/** Number of bytes following the payload. */
+constexpr size_t FRAME_TRAILER_SIZE{2};
+/** Maximum payload size of a single frame. */
+constexpr size_t FRAME_MAX_PAYLOAD{ESP32MODULES_COMMAND_FRAME_MAX_PAYLOAD};
+/** Maximum size of an encoded frame. */
+constexpr size_t FRAME_MAX_SIZE{FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_TRAILER_SIZE};
+
+static_assert(FRAME_MAX_PAYLOAD <= 0xFFFF, "The payload length must fit 16 bits.");
+
+/**
+ * @brief Continues a CRC-16/CCITT-FALSE checksum over the given data.
+ *
+ * @param data Data to be covered.
+ * @param length Number of bytes.
+ * @param crc Checksum of the preceding data (initial value by default).
+ * @return Updated checksum.
+ */
+uint16_t Crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Encodes a command as frame.
+ *
+ * @param id Identifies the command.
+ * @param payload Parameters of the command.
+ * @param length Number of payload bytes (at most FRAME_MAX_PAYLOAD).
+ * @param buffer Buffer to write the frame to (e.g. behind already encoded frames of a batch).
+ * @param size Size of the buffer.
+ * @return Number of bytes written - 0 if the payload is too long or the buffer is too small.
+ */
+size_t EncodeFrame(uint8_t id, const uint8_t* payload, size_t length, uint8_t* buffer, size_t size);
+
+/**
+ * @brief Decoded frame (the payload is only valid until the decoder is used again).
+ */
+struct CommandFrame
+{
+  uint8_t id;              //!< Identifies the command.
+  const uint8_t* payload;  //!< Parameters of the command.
+  size_t length;           //!< Number of payload bytes.
+};
+
+/**
+ * @brief Reassembles frames from a stream of arbitrarily split writes.
+ *
+ * Bytes are collected in a buffer of the maximum frame size (no heap allocations). Corrupt frames
+ * (invalid length or CRC) and bytes in between frames are skipped by searching for the next sync
+ * byte, so the decoder recovers from lost or damaged writes.
+ *
+ * @note Not thread-safe.
+ */
+class FrameDecoder
+{
+ public:
+  /** Counters of the decoder. */
+  struct Statistics
+  {
+    uint32_t frames;     //!< Number of valid frames decoded.
+    uint32_t corrupted;  //!< Number of frames rejected due to an invalid length or CRC.
+    uint32_t skipped;    //!< Number of bytes skipped while searching for the next frame.
+  };
+
+  FrameDecoder() : mBuffer{}, mFill{0}, mConsumed{0}, mStatistics{} {}
+  ~FrameDecoder() = default;
+
+  FrameDecoder(const FrameDecoder&) = delete;
+  FrameDecoder& operator=(const FrameDecoder&) = delete;
+
+  /**
+   * @brief Feeds received bytes and calls @p handler(const CommandFrame&) for each complete frame.
+   *
+   * @note The handler must not feed the same decoder.
+   *
+   * @param data Received bytes.
+   * @param length Number of received bytes.
+   * @param handler Handler of the decoded frames.
+   */
+  template <typename Handler>
+  void Feed(const uint8_t* data, size_t length, Handler&& handler)
+  {
+    do
+    {
+      const size_t taken = Append(data, length);
+      data += taken;
+      length -= taken;
+      CommandFrame frame{};
+      while (Extract(frame))
+      {
+        handler(frame);
+      }
+    } while (length > 0);
+  }
+
+  /**
+   * @brief Drops a partially received frame (e.g. after the peer disconnected).
+   */
+  void Reset();
+
+  /** @brief Provides the counters of the decoder. */
+  Statistics GetStatistics() const { return mStatistics; }
+
+ private:
+  uint8_t mBuffer[FRAME_MAX_SIZE];  //!< Bytes of the frame being reassembled.
+  size_t mFill;                     //!< Number of bytes in the buffer.
+  size_t mConsumed;                 //!< Size of the last extracted frame (removed lazily).
+  Statistics mStatistics;           //!< Counters of the decoder.
+
+  /** Copies as many bytes as fit into the buffer and returns their number. */
+  size_t Append(const uint8_t* data, size_t length);
+
+  /** Extracts the next complete frame from the buffer (if any). */
+  bool Extract(CommandFrame& frame);
+
+  /** Removes the given number of bytes from the front of the buffer. */
+  void Discard(size_t count);
+};
+}  // namespace Esp32Modules::Connectivity
+
+#endif  // ESP32MODULES__CONNECTIVITY_COMMANDFRAME_HPP_
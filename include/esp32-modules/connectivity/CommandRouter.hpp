@@ -0,0 +1,98 @@
+/**
+ * @file CommandRouter.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a transport-agnostic router dispatching commands to registered callbacks.
+ * @version 0.1
+ * @date 2021-09-25
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_COMMANDROUTER_HPP_
+#define ESP32MODULES__CONNECTIVITY_COMMANDROUTER_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+// Project header
+#include <esp32-modules/connectivity/CommandTable.hpp>
+
+namespace Esp32Modules::Connectivity
+{
+/**
+ * @brief Dispatches "token parameters" commands to the callbacks registered for their tokens.
+ *
+ * A single router can be shared by several transports (e.g. BLE writes, HTTP request bodies and
+ * serial lines), so each command is registered once and every transport uses the same dispatch
+ * path: the command is split without copies and its callback looked up in a CommandTable.
+ *
+ * @note Thread-safe. Callbacks are executed outside of the internal lock in the context of the
+ * dispatching transport.
+ */
+class CommandRouter
+{
+ public:
+  /** Type of a callback receiving the parameters of its command. */
+  using Callback = CommandTable::Callback;
+
+  /** Outcome of dispatching a command. */
+  enum class DispatchResult : uint8_t
+  {
+    OK,               //!< The callback of the command was executed.
+    UNKNOWN_COMMAND,  //!< No callback is registered for the token.
+    EMPTY_COMMAND     //!< The command has no token.
+  };
+
+  /** Counters of the router. */
+  struct Statistics
+  {
+    uint32_t dispatched;  //!< Number of commands dispatched to their callbacks.
+    uint32_t unknown;     //!< Number of commands without a callback (or without a token).
+  };
+
+  CommandRouter() : mMutex{}, mTable{}, mDispatched{0}, mUnknown{0} {}
+  ~CommandRouter() = default;
+
+  CommandRouter(const CommandRouter&) = delete;
+  CommandRouter& operator=(const CommandRouter&) = delete;
+
+  /**
+   * @brief Registers a new callback for a given command token.
+   *
+   * @param token Token by which the command is identified.
+   * @param callback Callback to be executed for the command.
+   * @return true if the callback was registered, false if the token was already registered.
+   */
+  bool Register(const std::string_view token, Callback callback);
+
+  /**
+   * @brief Splits the command and executes the callback of its token.
+   *
+   * @param command Received command ("token parameters").
+   * @return Outcome of the dispatch.
+   */
+  DispatchResult Dispatch(const std::string_view command);
+
+  /**
+   * @brief Executes the callback of an already split command.
+   *
+   * @param command Token and parameters of the command.
+   * @return Outcome of the dispatch.
+   */
+  DispatchResult Dispatch(const CommandView& command);
+
+  /** @brief Provides the counters of the router. */
+  Statistics GetStatistics() const;
+
+ private:
+  std::mutex mMutex;                  //!< Protects the table.
+  CommandTable mTable;                //!< Registered callbacks per token.
+  std::atomic<uint32_t> mDispatched;  //!< Number of commands dispatched.
+  std::atomic<uint32_t> mUnknown;     //!< Number of commands without a callback.
+};
+}  // namespace Esp32Modules::Connectivity
+
+#endif  // ESP32MODULES__CONNECTIVITY_COMMANDROUTER_HPP_
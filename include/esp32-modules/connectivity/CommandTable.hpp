@@ -0,0 +1,120 @@
+/**
+ * @file CommandTable.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a lookup table mapping command tokens to callbacks.
+ * @version 0.1
+ * @date 2021-09-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_COMMANDTABLE_HPP_
+#define ESP32MODULES__CONNECTIVITY_COMMANDTABLE_HPP_
+
+// Standard header
+#include <cstdint>
+#include <forward_list>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Esp32Modules::Connectivity
+{
+/**
+ * @brief Hashes a command token (32 bit FNV-1a).
+ *
+ * As it is constexpr, hashes of literal tokens can be determined at compile time.
+ *
+ * @param token Token to be hashed.
+ * @return Hash of the token.
+ */
+constexpr uint32_t HashToken(const std::string_view token)
+{
+  uint32_t hash{2166136261u};
+  for (const char c : token)
+  {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Command split into its token and its parameters (views into the received payload).
+ */
+struct CommandView
+{
+  std::string_view token;       //!< Identifies the command.
+  std::string_view parameters;  //!< Everything after the first space (empty if there is none).
+};
+
+/**
+ * @brief Splits a "token parameters" command without copying it.
+ *
+ * @param command Received command.
+ * @return Views of the token and the parameters.
+ */
+CommandView ParseCommand(const std::string_view command);
+
+/**
+ * @brief Flat table of command callbacks sorted by the hashes of their tokens.
+ *
+ * Looking up a token is a binary search over a contiguous array of hashes followed by a single
+ * string comparison, without any allocations. Callbacks are kept at stable addresses, so they may
+ * be executed while further callbacks are registered.
+ *
+ * @note Not thread-safe.
+ */
+class CommandTable
+{
+ public:
+  /** Type of a callback receiving the parameters of its command. */
+  using Callback = std::function<void(std::string_view)>;
+
+  CommandTable() = default;
+  ~CommandTable() = default;
+
+  CommandTable(const CommandTable&) = delete;
+  CommandTable& operator=(const CommandTable&) = delete;
+
+  /**
+   * @brief Adds the callback for the given token.
+   *
+   * @param token Token by which the command is identified.
+   * @param callback Callback to be executed for the command.
+   * @return true if the callback was added, false if the token was already registered.
+   */
+  bool Register(const std::string_view token, Callback callback);
+
+  /**
+   * @brief Looks up the callback of the given token.
+   *
+   * @param token Token by which the command is identified.
+   * @return Callback - nullptr if the token is not registered.
+   */
+  Callback* Find(const std::string_view token);
+
+  /** @brief Number of registered tokens. */
+  size_t Size() const { return mIndex.size(); }
+
+ private:
+  /** Registered command. */
+  struct Command
+  {
+    std::string token;  //!< Token by which the command is identified.
+    Callback callback;  //!< Callback to be executed.
+  };
+
+  /** Entry of the sorted lookup index. */
+  struct IndexEntry
+  {
+    uint32_t hash;     //!< Hash of the token.
+    Command* command;  //!< Registered command.
+  };
+
+  std::forward_list<Command> mCommands;  //!< Storage of the commands (stable addresses).
+  std::vector<IndexEntry> mIndex;        //!< Commands sorted by the hashes of their tokens.
+};
+}  // namespace Esp32Modules::Connectivity
+
+#endif  // ESP32MODULES__CONNECTIVITY_COMMANDTABLE_HPP_
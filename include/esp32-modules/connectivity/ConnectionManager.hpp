@@ -0,0 +1,168 @@
+/**
+ * @file ConnectionManager.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a non-blocking state machine handling BLE connections and advertising.
+ * @version 0.1
+ * @date 2021-10-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_CONNECTIONMANAGER_HPP_
+#define ESP32MODULES__CONNECTIVITY_CONNECTIONMANAGER_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Project header
+#include <esp32-modules/core/time/Clock.hpp>
+
+namespace Esp32Modules::Connectivity::BluetoothLE
+{
+/** State of the connection to a peer. */
+enum class ConnectionState : uint8_t
+{
+  IDLE,         //!< Neither connected nor advertising (not started yet).
+  ADVERTISING,  //!< Advertising and waiting for a peer to connect.
+  CONNECTED,    //!< A peer is connected.
+  DISCONNECTED  //!< The peer disconnected, advertising is restarted soon.
+};
+
+/** Returned by ConnectionManager::TimeUntilUpdate() if no update is due at all. */
+constexpr uint32_t NO_UPDATE_DUE{UINT32_MAX};
+
+/**
+ * @brief Timing of the advertising (all durations in milliseconds).
+ *
+ * Advertising starts fast to let peers reconnect quickly and backs off to save power (and air
+ * time) if nobody connects: the interval is doubled after each backoff step until the maximum is
+ * reached.
+ */
+struct AdvertisingConfig
+{
+  uint32_t restartDelay{500};   //!< Delay after a disconnect before readvertising.
+  uint16_t minInterval{20};     //!< Initial advertising interval.
+  uint16_t maxInterval{1000};   //!< Advertising interval after backing off completely.
+  uint32_t backoffStep{30000};  //!< Time advertised with an interval before it is doubled.
+};
+
+/**
+ * @brief Tracks the connection to a peer and (re-)starts the advertising without blocking.
+ *
+ * The BLE stack reports connects and disconnects from its own task (lock-free), while Update()
+ * drives the state machine in the context of the application: it restarts advertising once the
+ * restart delay passed, backs off the advertising interval and reports state changes to the
+ * application.
+ *
+ * The BLE stack itself is only accessed via the given advertising function, so the state machine
+ * can be run on any clock (e.g. a SimulatedClock).
+ */
+class ConnectionManager
+{
+ public:
+  /**
+   * @brief Function (re-)starting the advertising with the given interval in milliseconds.
+   */
+  using AdvertisingFunction = std::function<void(uint16_t interval)>;
+
+  /**
+   * @brief Callback executed on state changes (in the context of Update()).
+   */
+  using StateCallback = std::function<void(ConnectionState state)>;
+
+  /** Counters of the manager. */
+  struct Statistics
+  {
+    uint32_t connects;          //!< Number of peers connected.
+    uint32_t disconnects;       //!< Number of peers disconnected.
+    uint32_t readvertiseDelay;  //!< Time from the last disconnect until advertising again.
+  };
+
+  /**
+   * @brief Sets up the (idle) state machine.
+   *
+   * @param advertise Function (re-)starting the advertising.
+   * @param config Timing of the advertising.
+   * @param clock Clock to run on - nullptr for the system clock.
+   */
+  ConnectionManager(AdvertisingFunction advertise, const AdvertisingConfig& config = {},
+                    Core::Time::Clock* clock = nullptr);
+  ~ConnectionManager() = default;
+
+  ConnectionManager(const ConnectionManager&) = delete;
+  ConnectionManager& operator=(const ConnectionManager&) = delete;
+
+  /**
+   * @brief Starts advertising (unless already started).
+   */
+  void Start();
+
+  /**
+   * @brief Signals that a peer connected (lock-free, e.g. from the BLE task).
+   */
+  void OnConnect();
+
+  /**
+   * @brief Signals that the peer disconnected (lock-free, e.g. from the BLE task).
+   */
+  void OnDisconnect();
+
+  /**
+   * @brief Processes the signaled connects and disconnects and drives the advertising.
+   *
+   * To be called regularily (e.g. by a cyclic task), the advertising is restarted on the first
+   * call after the restart delay passed.
+   */
+  void Update();
+
+  /**
+   * @brief Provides the time until Update() has something to do (e.g. to schedule a wake-up).
+   *
+   * @return Milliseconds until the next update is due (0 if connects or disconnects are pending),
+   * NO_UPDATE_DUE if there is nothing to do until the next connect or disconnect.
+   */
+  uint32_t TimeUntilUpdate() const;
+
+  /**
+   * @brief Sets the callback executed on state changes (e.g. to (re-)send a state to the peer).
+   *
+   * @note Not thread-safe, to be set up before calling Update().
+   *
+   * @param callback Callback to be executed - nullptr for none.
+   */
+  void SetStateCallback(StateCallback callback);
+
+  /** @brief Current state (as of the last call of Update()). */
+  ConnectionState GetState() const { return mState; }
+
+  /** @brief Current advertising interval in milliseconds. */
+  uint16_t GetAdvertisingInterval() const { return mInterval; }
+
+  /** @brief Provides the counters of the manager. */
+  Statistics GetStatistics() const { return mStatistics; }
+
+ private:
+  AdvertisingFunction mAdvertise;         //!< (Re-)starts the advertising.
+  const AdvertisingConfig mConfig;        //!< Timing of the advertising.
+  Core::Time::Clock& mClock;              //!< Clock to run on.
+  StateCallback mStateCallback;           //!< Executed on state changes (optional).
+  std::atomic<bool> mLinkUp;              //!< Connection state as signaled by the stack.
+  std::atomic<uint8_t> mLinkEvents;       //!< Connects and disconnects not yet processed.
+  std::atomic<uint32_t> mDisconnectTime;  //!< Time of the last disconnect.
+  ConnectionState mState;                 //!< Current state.
+  uint16_t mInterval;                     //!< Current advertising interval.
+  uint32_t mIntervalStart;                //!< Time the current interval was set.
+  Statistics mStatistics;                 //!< Counters of the manager.
+
+  /** Moves to the given state and notifies the application. */
+  void Transition(const ConnectionState state);
+
+  /** (Re-)starts the advertising with the given interval. */
+  void Advertise(const uint16_t interval);
+};
+
+}  // namespace Esp32Modules::Connectivity::BluetoothLE
+
+#endif  // ESP32MODULES__CONNECTIVITY_CONNECTIONMANAGER_HPP_
@@ -0,0 +1,154 @@
+/**
+ * @file EventHub.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a publish/subscribe hub fanning out Server-Sent Events to subscribers.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_EVENTHUB_HPP_
+#define ESP32MODULES__CONNECTIVITY_EVENTHUB_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Maximum number of events queued per subscriber before it is dropped as too slow.
+#ifndef ESP32MODULES_HTTP_EVENT_QUEUE_LENGTH
+#define ESP32MODULES_HTTP_EVENT_QUEUE_LENGTH 8
+#endif
+
+// Maximum number of subscribers of a hub.
+#ifndef ESP32MODULES_HTTP_MAX_SUBSCRIBERS
+#define ESP32MODULES_HTTP_MAX_SUBSCRIBERS 4
+#endif
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Fans out events in the Server-Sent Events (SSE) format to all subscribers.
+ *
+ * Each published event is serialized once and shared by the queues of all subscribers, which are
+ * drained independently (e.g. whenever the TCP connection of a subscriber can take more data).
+ * The queues are bounded: a subscriber not keeping up is dropped instead of buffering events for
+ * it, so a slow client cannot exhaust the memory or hold back the others (SSE clients reconnect on
+ * their own).
+ *
+ * Independent of the platform, so it can also be used (and tested) on the host.
+ *
+ * @note Thread-safe, events may be published from any task.
+ */
+class EventHub
+{
+ public:
+  /** @brief Identifies a subscriber. */
+  using SubscriberId = uint32_t;
+
+  /** @brief Identifier indicating that no subscriber could be added. */
+  static constexpr SubscriberId NO_SUBSCRIBER{0};
+
+  /** Counters of the hub. */
+  struct Statistics
+  {
+    uint32_t published;  //!< Number of events published.
+    uint32_t delivered;  //!< Number of events completely read by subscribers.
+    uint32_t dropped;    //!< Number of subscribers dropped for not keeping up.
+  };
+
+  /**
+   * @brief Sets up the hub (allocating all queues up front).
+   *
+   * @param queueLength Maximum number of events queued per subscriber.
+   * @param maxSubscribers Maximum number of subscribers.
+   */
+  explicit EventHub(const size_t queueLength = ESP32MODULES_HTTP_EVENT_QUEUE_LENGTH,
+                    const size_t maxSubscribers = ESP32MODULES_HTTP_MAX_SUBSCRIBERS);
+  ~EventHub() = default;
+
+  EventHub(const EventHub&) = delete;
+  EventHub& operator=(const EventHub&) = delete;
+
+  /**
+   * @brief Adds a subscriber, receiving all events published from now on.
+   *
+   * @return Identifier of the subscriber - NO_SUBSCRIBER if the maximum is reached.
+   */
+  SubscriberId Subscribe();
+
+  /**
+   * @brief Removes the subscriber (if not dropped already).
+   *
+   * @param id Identifier of the subscriber.
+   */
+  void Unsubscribe(const SubscriberId id);
+
+  /**
+   * @brief Indicates whether the subscriber is still served (i.e. neither removed nor dropped).
+   *
+   * @param id Identifier of the subscriber.
+   * @return true if subscribed, false otherwise.
+   */
+  bool IsSubscribed(const SubscriberId id) const;
+
+  /**
+   * @brief Serializes the event and queues it for all subscribers.
+   *
+   * @param data Data of the event (may span multiple lines).
+   * @param event Type of the event - empty for the default type ("message").
+   * @return Number of subscribers the event was queued for.
+   */
+  size_t Publish(const std::string_view data, const std::string_view event = {});
+
+  /**
+   * @brief Reads queued events of the subscriber (serialized, continuing partially read ones).
+   *
+   * @param id Identifier of the subscriber.
+   * @param buffer Buffer to copy the events to.
+   * @param capacity Capacity of the buffer.
+   * @return Number of bytes copied - 0 if nothing is queued (or the subscriber is gone).
+   */
+  size_t Read(const SubscriberId id, uint8_t* buffer, const size_t capacity);
+
+  /** @brief Number of current subscribers. */
+  size_t GetSubscriberCount() const;
+
+  /** @brief Provides the counters of the hub. */
+  Statistics GetStatistics() const;
+
+ private:
+  /** Serialized event, shared by all queues. */
+  using Event = std::shared_ptr<const std::string>;
+
+  /** Subscriber with its queue of events. */
+  struct Subscriber
+  {
+    SubscriberId id;           //!< Identifier - NO_SUBSCRIBER if the slot is free.
+    std::vector<Event> queue;  //!< Ring of queued events.
+    size_t head;               //!< Index of the oldest event.
+    size_t count;              //!< Number of queued events.
+    size_t offset;             //!< Bytes of the oldest event already read.
+  };
+
+  mutable std::mutex mMutex;             //!< Protects all members below.
+  std::vector<Subscriber> mSubscribers;  //!< Slots of the subscribers.
+  SubscriberId mNextId;                  //!< Identifier of the next subscriber.
+  uint32_t mNextEventId;                 //!< Identifier of the next event.
+  Statistics mStatistics;                //!< Counters of the hub.
+
+  /** Looks up the slot of the subscriber - nullptr if it is gone. */
+  Subscriber* Find(const SubscriberId id);
+
+  /** Frees the slot of the subscriber (releasing its events). */
+  static void Release(Subscriber& subscriber);
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_EVENTHUB_HPP_
@@ -12,9 +12,12 @@
 #define ESP32MODULES__CONNECTIVITY_HTTP_HPP_
 
 // Standard header
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Platform header
 #include <HTTPClient.h>
@@ -22,10 +25,75 @@
 // Third-party header
 #include <ESPAsyncWebServer.h>
 
+// Project header
+#include <esp32-modules/connectivity/CommandRouter.hpp>
+#include <esp32-modules/connectivity/EventHub.hpp>
+#include <esp32-modules/connectivity/HttpBodySink.hpp>
+#include <esp32-modules/connectivity/HttpConnectionPool.hpp>
+#include <esp32-modules/connectivity/HttpMetrics.hpp>
+#include <esp32-modules/connectivity/HttpRequest.hpp>
+#include <esp32-modules/connectivity/HttpResponse.hpp>
+#include <esp32-modules/connectivity/PathRouter.hpp>
+#include <esp32-modules/connectivity/ResponseCache.hpp>
+#include <esp32-modules/connectivity/StaticFileHandler.hpp>
+#include <esp32-modules/filesystem/Files.hpp>
+
 namespace Esp32Modules::Connectivity::Http
 {
+/**
+ * @brief Refers to the body of a request without owning (or copying) it.
+ *
+ * The body is either a contiguous buffer or a stream of known length (e.g. a file opened via
+ * Filesystem::RegularFile::OpenForReading()), which is sent piece by piece. The referenced data has
+ * to outlive the request.
+ */
+class RequestBody
+{
+ public:
+  /** @brief Refers to an empty body. */
+  RequestBody() : mData{nullptr}, mStream{nullptr}, mLength{0} {}
+
+  /** @brief Refers to a buffer of the given length. */
+  RequestBody(const uint8_t* data, const size_t length)
+      : mData{data}, mStream{nullptr}, mLength{length}
+  {
+  }
+
+  /** @brief Refers to the characters of a string. */
+  RequestBody(const std::string_view data)
+      : RequestBody{reinterpret_cast<const uint8_t*>(data.data()), data.size()}
+  {
+  }
+
+  /** @brief Refers to the characters of a string. */
+  RequestBody(const std::string& data) : RequestBody{std::string_view{data}} {}
+
+  /** @brief Refers to the next @p length bytes of the stream. */
+  RequestBody(Stream& stream, const size_t length)
+      : mData{nullptr}, mStream{&stream}, mLength{length}
+  {
+  }
+
+  /** @brief Buffer of the body (nullptr if streamed). */
+  const uint8_t* GetData() const { return mData; }
+
+  /** @brief Stream providing the body (nullptr if buffered). */
+  Stream* GetStream() const { return mStream; }
+
+  /** @brief Length of the body in bytes. */
+  size_t GetLength() const { return mLength; }
+
+ private:
+  const uint8_t* mData;  //!< Buffered body.
+  Stream* mStream;       //!< Streamed body.
+  size_t mLength;        //!< Length of the body.
+};
+
 /**
  * @brief Provides methods to issue HTTP requests towards an existing server.
+ *
+ * Connections are kept alive and reused for subsequent requests to the same server (see
+ * HttpConnectionPool), which saves a TCP (and TLS) handshake per request.
  */
 class HttpClient
 {
@@ -49,16 +117,130 @@ class HttpClient
    * @param result Result string obtained from the URL.
    * @return HTTP response code (below zero if an error occurred on client side).
    */
-  int Get(const std::string url, std::string& result);
+  int Get(const std::string& url, std::string& result);
+
+  /** @brief Receives chunks of a response body (see Http::ChunkSink). */
+  using ChunkSink = Http::ChunkSink;
+
+  /**
+   * @brief Send an HTTP GET request to the specified URL and stream the response body to the sink.
+   *
+   * The body is passed on in chunks of at most the size of a TCP segment as soon as they are
+   * received (both for plain and chunked transfer encoding), so the memory used does not depend on
+   * the size of the body.
+   *
+   * @param url URL to be queried.
+   * @param sink Sink receiving the chunks of the body.
+   * @return HTTP response code (below zero if an error occurred on client side, e.g. if the sink
+   * aborted the transfer).
+   */
+  int Get(const std::string& url, const ChunkSink& sink);
+
+  /**
+   * @brief Send an HTTP GET request to the specified URL and stream the response body to the file.
+   *
+   * The file is only (over-)written on success (2xx), e.g. to download firmware or datasets that do
+   * not fit into the memory.
+   *
+   * @param url URL to be queried.
+   * @param file File to write the body to.
+   * @return HTTP response code (below zero if an error occurred on client side, e.g. if writing the
+   * file failed).
+   */
+  int Get(const std::string& url, Filesystem::RegularFile& file);
+
+  /**
+   * @brief Send an HTTP request with the given method to the specified URL.
+   *
+   * Neither the request nor the response body is copied: the request body is sent straight from
+   * its buffer or stream and the response body is streamed to the sink.
+   *
+   * @param method Method of the request (e.g. "POST").
+   * @param url URL to be queried.
+   * @param body Body of the request.
+   * @param sink Sink receiving the chunks of the response body - nullptr to discard it.
+   * @param headers Header fields to be sent along.
+   * @param responseHeaders Names of the response header fields of interest, their values are filled
+   * in (empty if not received) - nullptr if not of interest.
+   * @return HTTP response code (below zero if an error occurred on client side).
+   */
+  int Send(const char* method, const std::string& url, const RequestBody& body,
+           const ChunkSink& sink = nullptr, const HttpHeaders& headers = {},
+           HttpHeaders* responseHeaders = nullptr);
+
+  /** @{ */
+  /**
+   * @brief Send an HTTP POST, PUT or PATCH request to the specified URL (see Send()).
+   */
+  int Post(const std::string& url, const RequestBody& body, const ChunkSink& sink = nullptr,
+           const HttpHeaders& headers = {}, HttpHeaders* responseHeaders = nullptr);
+  int Put(const std::string& url, const RequestBody& body, const ChunkSink& sink = nullptr,
+          const HttpHeaders& headers = {}, HttpHeaders* responseHeaders = nullptr);
+  int Patch(const std::string& url, const RequestBody& body, const ChunkSink& sink = nullptr,
+            const HttpHeaders& headers = {}, HttpHeaders* responseHeaders = nullptr);
+  /** @} */
+
+  /**
+   * @brief Send an HTTP DELETE request to the specified URL (see Send()).
+   */
+  int Delete(const std::string& url, const ChunkSink& sink = nullptr,
+             const HttpHeaders& headers = {}, HttpHeaders* responseHeaders = nullptr);
+
+  /**
+   * @brief Verifies HTTPS servers with the given root certificate.
+   *
+   * Without a certificate, HTTPS requests are encrypted but the server is not verified (as with
+   * plain HTTPClient), unless verification is required (see SetVerificationRequired()).
+   *
+   * @param caCert PEM encoded certificate, has to outlive the client - nullptr to not verify.
+   */
+  void SetCACertificate(const char* caCert);
+
+  /**
+   * @brief Refuses HTTPS requests to servers that cannot be verified.
+   *
+   * Opt-in: if required, HTTPS requests without a root certificate (see SetCACertificate()) fail
+   * with HTTPC_ERROR_CONNECTION_REFUSED instead of talking to an unverified server.
+   *
+   * @param required True to refuse unverified HTTPS, false to allow it (default).
+   */
+  void SetVerificationRequired(const bool required);
+
+  /**
+   * @brief Provides the counters of the connection pool (e.g. how often connections were reused).
+   *
+   * @return Current statistics.
+   */
+  HttpConnectionPool::Statistics GetConnectionStatistics() const;
+
+  /**
+   * @brief Records the requests in the metrics, per host of the URLs.
+   *
+   * Resolving the host and connecting are recorded for requests opening a new connection only
+   * (reusing a pooled one costs neither), separately from sending the request until the status is
+   * received and from receiving the body.
+   *
+   * @param metrics Metrics to record in, has to outlive the client - nullptr to stop recording.
+   */
+  void SetMetrics(HttpMetrics* metrics) { mMetrics = metrics; }
 
  private:
-  HTTPClient mClient;
+  const char* mCACert;         //!< Root certificate to verify HTTPS servers with (optional).
+  bool mVerificationRequired;  //!< Indicates that unverified HTTPS is refused.
+  HttpConnectionPool mPool;    //!< Connections kept alive for subsequent requests.
+  HttpMetrics* mMetrics;       //!< Metrics recorded in (optional).
 };
 
 class HttpServer
 {
  public:
-  HttpServer(const uint16_t port);
+  /**
+   * @brief Sets up the server.
+   *
+   * @param port Port to listen on.
+   * @param cacheSize Maximum number of bytes taken by cached responses (see SetCachedRoute()).
+   */
+  HttpServer(const uint16_t port, const size_t cacheSize = ESP32MODULES_HTTP_CACHE_SIZE);
 
   ~HttpServer();
 
@@ -67,10 +249,20 @@ class HttpServer
    *
    * Function signature explanation:
    *   Parameters: None.
-   *   Return value: Serialized response.
+   *   Return value: Serialized response (sent as text/plain with status 200).
    */
   using OnRequestWithoutParams = std::function<std::string()>;
 
+  /**
+   * @brief Represents the callback to be executed on an HTTP request, describing the response.
+   *
+   * Function signature explanation:
+   *   Parameters: Response to be filled (status, content type, headers and (streamed) body).
+   *   Return value: None.
+   */
+  using OnRequest = std::function<void(HttpResponse&)>;
+
+  /** @{ */
   /**
    * @brief Registers a callback to be executed on a void HTTP request with the given path.
    *
@@ -80,9 +272,163 @@ class HttpServer
    */
   void SetCallback(const std::string& path, const WebRequestMethod methodType,
                    const OnRequestWithoutParams& cb);
+  void SetCallback(const std::string& path, const WebRequestMethod methodType,
+                   const OnRequest& cb);
+  /** @} */
+
+  /**
+   * @brief Dispatches the bodies of POST requests to the given path as commands via the router.
+   *
+   * The body is a single "token parameters" command. Responds with 200 if the command was
+   * dispatched, 404 if its token is unknown, 400 if it is empty and 413 if the body exceeds a
+   * single chunk of the server.
+   *
+   * @param path Path on the parent URL used to identify the request.
+   * @param router Router dispatching the commands, has to outlive the server.
+   */
+  void SetCommandRoute(const std::string& path, CommandRouter& router);
+
+  /**
+   * @brief Represents the callback to be executed on a routed HTTP request.
+   *
+   * Function signature explanation:
+   *   Parameters: Request (captures, parameters and headers), response to be filled.
+   *   Return value: None.
+   */
+  using OnRoutedRequest = std::function<void(const HttpRequest&, HttpResponse&)>;
+
+  /**
+   * @brief Represents the callback receiving the body of a routed HTTP request piece by piece.
+   *
+   * Executed for each piece as it is received, before the request callback.
+   *
+   * Function signature explanation:
+   *   Parameters: Request, piece of the body, length of the piece, offset of the piece within the
+   *   body, total length of the body.
+   *   Return value: None.
+   */
+  using OnBodyChunk =
+      std::function<void(const HttpRequest&, const uint8_t*, size_t, size_t, size_t)>;
+
+  /**
+   * @brief Registers a callback for requests to paths matching the pattern.
+   *
+   * Patterns may contain captures of whole segments (e.g. "/sensor/{id}"), whose values are
+   * provided by the request. All patterns are matched by a single PathRouter in one pass over the
+   * path (see there for the precedence of literal segments).
+   *
+   * @note Routes have to be registered before the server receives requests.
+   *
+   * @param pattern Pattern of the paths.
+   * @param methods Methods to be handled (e.g. HTTP_GET | HTTP_POST).
+   * @param cb Callback to be executed.
+   * @param bodyCb Callback receiving the body - nullptr to ignore it (form parameters are still
+   * parsed).
+   * @return true if the route was registered, false if the pattern is malformed.
+   */
+  bool SetRoute(const std::string& pattern, const WebRequestMethodComposite methods,
+                OnRoutedRequest cb, OnBodyChunk bodyCb = nullptr);
+
+  /**
+   * @brief Registers a callback for GET requests to paths matching the pattern, whose responses
+   * are cached until the version changes.
+   *
+   * The callback is only executed if there is no response for the path rendered from the current
+   * version. Responses carry an ETag (and "Cache-Control: no-cache"), so clients polling with
+   * If-None-Match are answered with 304 and no body while the version is unchanged. Only the
+   * status 200, the content type and non-streamed bodies are cached; other responses are passed on
+   * as they are. The least recently used responses are evicted to stay within the cache size.
+   *
+   * @param pattern Pattern of the paths (see SetRoute()), the query string does not change the
+   * cached response.
+   * @param cb Callback rendering the response.
+   * @param version Version of the data rendered, to be incremented by the application whenever it
+   * changes - has to outlive the server.
+   * @return true if the route was registered, false if the pattern is malformed.
+   */
+  bool SetCachedRoute(const std::string& pattern, OnRoutedRequest cb,
+                      const std::atomic<uint32_t>& version);
+
+  /**
+   * @brief Provides the counters of the response cache.
+   *
+   * @return Current statistics.
+   */
+  ResponseCache::Statistics GetCacheStatistics() const { return mCache.GetStatistics(); }
+
+  /**
+   * @brief Pushes the events published on the hub to clients subscribing via GET to the path.
+   *
+   * Each client is served a Server-Sent Events stream (text/event-stream, e.g. via EventSource in
+   * a browser), fed from its queue in the hub whenever the connection can take more data. Clients
+   * are unsubscribed on disconnect, answered with 503 if the hub has no free slot and disconnected
+   * if dropped by the hub for not keeping up.
+   *
+   * @param path Path on the parent URL used to identify the request.
+   * @param hub Hub publishing the events, has to outlive the server.
+   */
+  void SetEventRoute(const std::string& path, EventHub& hub);
+
+  /**
+   * @brief Serves the files of a directory for GET requests to paths below the prefix.
+   *
+   * Files are streamed in pieces, pre-compressed variants ("<file>.gz") are preferred for clients
+   * accepting gzip and single byte ranges are supported (see StaticFileHandler). Paths ending with
+   * '/' are mapped to "index.html".
+   *
+   * @param prefix Path prefix of the requests (e.g. "/" or "/logs").
+   * @param fs Filesystem the files are read from (e.g. via SdCard::GetFilesystemHandle()), has to
+   * outlive the server.
+   * @param root Directory the prefix is mapped to (e.g. "/www").
+   * @param cacheControl Value of the Cache-Control header field - the default lets clients keep
+   * the files, but revalidate them (answered with 304 via the ETag) before each use.
+   */
+  void SetStaticRoute(const std::string& prefix, fs::FS& fs, const std::string& root,
+                      const std::string& cacheControl = "no-cache");
+
+  /**
+   * @brief Records the requests to callbacks and routes in the metrics, optionally serving them.
+   *
+   * Per path of a callback (or pattern of a route), the requests, their status classes, the bytes
+   * received and sent as well as the time taken by the callback and until the connection was
+   * closed (i.e. including the transmission) are recorded. The metrics are served in the
+   * Prometheus text format, rendered piece by piece while being transmitted.
+   *
+   * @param metrics Metrics to record in, has to outlive the server.
+   * @param path Path on the parent URL to serve the metrics on - empty to not serve them.
+   */
+  void EnableMetrics(HttpMetrics& metrics, const std::string& path = "/metrics");
 
  private:
-  AsyncWebServer mServer;
+  /** Callbacks of a route for a set of methods. */
+  struct RouteCallbacks
+  {
+    std::string pattern;                //!< Pattern of the route.
+    WebRequestMethodComposite methods;  //!< Methods handled.
+    OnRoutedRequest request;            //!< Executed on the request.
+    OnBodyChunk body;                   //!< Executed on pieces of the body (optional).
+  };
+
+  /** Handler dispatching requests to the routes (owned by the server). */
+  class RouteHandler;
+
+  AsyncWebServer mServer;                            //!< Server receiving the requests.
+  PathRouter mRouter;                                //!< Patterns of the routes.
+  std::vector<std::vector<RouteCallbacks>> mRoutes;  //!< Callbacks per route.
+  bool mRouting;                                     //!< Indicates an installed route handler.
+  ResponseCache mCache;                              //!< Responses of cached routes.
+  HttpMetrics* mMetrics;                             //!< Metrics recorded in (optional).
+
+  /** Looks up the callbacks for the request - nullptr if no route matches. */
+  const RouteCallbacks* FindRoute(AsyncWebServerRequest* request, RouteMatch& match) const;
+
+  /** Fills the response via the callback and sends it, recording the metrics of the endpoint. */
+  void Respond(AsyncWebServerRequest* request, const std::string_view endpoint,
+               const OnRequest& cb) const;
+
+  /** Answers the request from the cache, rendering the response via the callback if required. */
+  void ServeCached(const HttpRequest& request, HttpResponse& response, const OnRoutedRequest& cb,
+                   const uint32_t version);
 };
 
 }  // namespace Esp32Modules::Connectivity::Http
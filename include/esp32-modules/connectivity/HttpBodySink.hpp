@@ -0,0 +1,74 @@
+/**
+ * @file HttpBodySink.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Passes a streamed HTTP body on to a chunk sink.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPBODYSINK_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPBODYSINK_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Receives chunks of a response body (with the number of bytes).
+ *
+ * Function signature explanation:
+ *   Parameters: Chunk of the body, size of the chunk.
+ *   Return value: true to continue, false to abort the transfer.
+ */
+using ChunkSink = std::function<bool(const uint8_t*, size_t)>;
+
+/**
+ * @brief Passes the chunks of a body on to a sink as they are received, without buffering them.
+ *
+ * Platform-independent part of streaming a response body: the client writes whatever it read
+ * from the connection, so the memory used does not depend on the size of the body.
+ */
+class BodySink
+{
+ public:
+  /**
+   * @brief Sets up the forwarding to the sink.
+   *
+   * @param sink Sink receiving the chunks - nullptr to drain the body (e.g. to keep the
+   * connection).
+   */
+  explicit BodySink(const ChunkSink& sink) : mSink{sink}, mWritten{0} {}
+  ~BodySink() = default;
+
+  /**
+   * @brief Passes a chunk on to the sink.
+   *
+   * @param data Chunk of the body.
+   * @param length Size of the chunk.
+   * @return Number of bytes taken, 0 if the sink aborted the transfer.
+   */
+  size_t Write(const uint8_t* data, const size_t length);
+
+  /** @brief Number of bytes passed on to the sink (or drained). */
+  size_t GetWritten() const { return mWritten; }
+
+  /**
+   * @brief Creates a sink appending the chunks to the string.
+   *
+   * @param result String to append to, has to outlive the sink.
+   */
+  static ChunkSink AppendTo(std::string& result);
+
+ private:
+  const ChunkSink& mSink;  //!< Sink receiving the chunks.
+  size_t mWritten;         //!< Bytes passed on so far.
+};
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPBODYSINK_HPP_
@@ -0,0 +1,93 @@
+/**
+ * @file HttpBodySource.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Produces the body of a (streamed) HTTP response piece by piece.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPBODYSOURCE_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPBODYSOURCE_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Produces the next piece of a streamed body (in the context of the server).
+ *
+ * Function signature explanation:
+ *   Parameters: Buffer to write the piece to, capacity of the buffer.
+ *   Return value: Number of bytes written - 0 to end the body, BodySource::TRY_AGAIN to be
+ *   executed again later (when the server polls the connection) if no data is available yet.
+ */
+using ChunkSource = std::function<size_t(uint8_t*, size_t)>;
+
+/**
+ * @brief Fills the transmit buffers of the server with a body, either from a string or from a
+ * chunk source.
+ *
+ * Platform-independent part of sending a response: the server asks for the next piece whenever
+ * there is room in its TCP buffers. The source is never asked for more than the announced length,
+ * and once it ended the body it is not executed again.
+ */
+class BodySource
+{
+ public:
+  /** @brief Length of a streamed body not known in advance. */
+  static constexpr size_t UNKNOWN_LENGTH{static_cast<size_t>(-1)};
+
+  /** @brief Returned by a chunk source if the next piece is not available yet. */
+  static constexpr size_t TRY_AGAIN{0xFFFFFFFF};
+
+  /**
+   * @brief Sets up the body to be produced by the source.
+   *
+   * @param source Source producing the body.
+   * @param length Length of the body - UNKNOWN_LENGTH if produced until the source returns 0.
+   * @param sentBytes Counter to add the bytes produced to (optional).
+   */
+  BodySource(ChunkSource source, const size_t length,
+             std::atomic<uint32_t>* sentBytes = nullptr);
+
+  /**
+   * @brief Sets up the body to be sent straight from the string (without copying it first).
+   *
+   * @param body Body of the response.
+   * @param sentBytes Counter to add the bytes produced to (optional).
+   */
+  explicit BodySource(std::shared_ptr<const std::string> body,
+                      std::atomic<uint32_t>* sentBytes = nullptr);
+  ~BodySource() = default;
+
+  /**
+   * @brief Produces the next piece of the body.
+   *
+   * @param buffer Buffer to write the piece to.
+   * @param capacity Capacity of the buffer.
+   * @return Number of bytes written - 0 if the body is complete, TRY_AGAIN if the source has no
+   * data available yet.
+   */
+  size_t Fill(uint8_t* buffer, const size_t capacity);
+
+  /** @brief Number of bytes produced so far. */
+  size_t GetProduced() const { return mProduced; }
+
+ private:
+  ChunkSource mSource;                       //!< Source of a streamed body.
+  std::shared_ptr<const std::string> mBody;  //!< Body (unless streamed).
+  size_t mLength;                            //!< Length of the body (once known).
+  size_t mProduced;                          //!< Bytes produced so far.
+  std::atomic<uint32_t>* mSentBytes;         //!< Counter of the bytes produced (optional).
+};
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPBODYSOURCE_HPP_
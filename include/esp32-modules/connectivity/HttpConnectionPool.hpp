@@ -0,0 +1,192 @@
+/**
+ * @file HttpConnectionPool.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a pool of persistent (keep-alive) HTTP connections.
+ * @version 0.1
+ * @date 2021-10-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPCONNECTIONPOOL_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPCONNECTIONPOOL_HPP_
+
+// Standard header
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Project header
+#include <esp32-modules/core/time/Clock.hpp>
+
+// Maximum number of connections kept by a pool (each one takes a socket and, for HTTPS, a TLS
+// session of roughly 40 KB while connected).
+#ifndef ESP32MODULES_HTTP_MAX_CONNECTIONS
+#define ESP32MODULES_HTTP_MAX_CONNECTIONS 2
+#endif
+
+// Milliseconds an unused connection is kept open.
+#ifndef ESP32MODULES_HTTP_IDLE_TIMEOUT
+#define ESP32MODULES_HTTP_IDLE_TIMEOUT 30000
+#endif
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Scheme, host and port of a URL, identifying the connections of a pool.
+ */
+struct HttpOrigin
+{
+  bool secure{false};  //!< Indicates HTTPS.
+  std::string host;    //!< Host name or address.
+  uint16_t port{0};    //!< Port (defaults to the one of the scheme).
+};
+
+/**
+ * @brief Extracts the origin from the URL.
+ *
+ * @param url URL to be queried.
+ * @param origin Origin of the URL.
+ * @return true if it is an HTTP(S) URL with a host (and a valid port), false otherwise.
+ */
+bool ParseOrigin(const std::string_view url, HttpOrigin& origin);
+
+/**
+ * @brief Connection to a server carrying the requests of a pool (e.g. a WiFiClient with an
+ * HTTPClient on top).
+ *
+ * Destroying the transport closes the connection.
+ */
+class HttpTransport
+{
+ public:
+  virtual ~HttpTransport() = default;
+
+  /**
+   * @brief Opens the connection to the origin the transport was created for.
+   *
+   * @return true if connected, false otherwise.
+   */
+  virtual bool Connect() = 0;
+
+  /**
+   * @brief Prepares a request to the URL on the connection.
+   *
+   * @param url URL to be queried (of the origin the transport was created for).
+   * @return true if the request can be sent, false otherwise.
+   */
+  virtual bool Begin(const std::string& url) = 0;
+
+  /**
+   * @brief Ends the request, keeping the connection open if the server allows it.
+   */
+  virtual void End() = 0;
+
+  /** @brief Indicates whether the connection is still open (e.g. not closed by the server). */
+  virtual bool Connected() = 0;
+};
+
+/**
+ * @brief Keeps connections to recently queried servers open to reuse them for further requests.
+ *
+ * Connections are identified by the scheme, host and port of the requested URL. Reusing one saves
+ * the TCP (and TLS) handshake, if the server keeps the connection alive. Connections unused for
+ * longer than the idle timeout are closed, and if all connections are taken by other servers, the
+ * least recently used one is closed.
+ *
+ * The connections themselves are provided by a factory of transports, so the bookkeeping is
+ * independent of the platform and can also be used (and tested) on the host.
+ *
+ * @note Not thread-safe.
+ */
+class HttpConnectionPool
+{
+ public:
+  /** Counters of the pool. */
+  struct Statistics
+  {
+    uint32_t requests;  //!< Number of requests started.
+    uint32_t reused;    //!< Number of requests sent via an already open connection.
+    uint32_t closed;    //!< Number of connections closed for being idle or to make room.
+  };
+
+  /**
+   * @brief Creates the (not yet connected) transport to an origin.
+   *
+   * Function signature explanation:
+   *   Parameters: Origin to connect to.
+   *   Return value: Transport - nullptr if the origin is not supported (e.g. HTTPS is refused).
+   */
+  using TransportFactory = std::function<std::unique_ptr<HttpTransport>(const HttpOrigin&)>;
+
+  /**
+   * @brief Sets up the (empty) pool.
+   *
+   * @param factory Factory of the transports.
+   * @param idleTimeout Milliseconds an unused connection is kept open.
+   * @param clock Clock to determine idle connections with - nullptr for the system clock.
+   */
+  explicit HttpConnectionPool(TransportFactory factory,
+                              const uint32_t idleTimeout = ESP32MODULES_HTTP_IDLE_TIMEOUT,
+                              Core::Time::Clock* clock = nullptr);
+
+  /**
+   * @brief Closes all connections.
+   */
+  ~HttpConnectionPool();
+
+  HttpConnectionPool(const HttpConnectionPool&) = delete;
+  HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+  /**
+   * @brief Prepares a request to the URL on a pooled connection (connecting if necessary).
+   *
+   * @param url URL to be queried.
+   * @return Transport to send the request with, to be released afterwards - nullptr if the URL is
+   * not supported, connecting failed or all connections are in use.
+   */
+  HttpTransport* Acquire(const std::string& url);
+
+  /**
+   * @brief Ends the request, keeping the connection open if the server allows it.
+   *
+   * @param transport Transport obtained from Acquire().
+   */
+  void Release(HttpTransport& transport);
+
+  /**
+   * @brief Closes all connections unused for longer than the idle timeout.
+   */
+  void CloseIdle();
+
+  /** @brief Number of open connections. */
+  size_t GetConnectionCount() const;
+
+  /** @brief Provides the counters of the pool. */
+  Statistics GetStatistics() const { return mStatistics; }
+
+ private:
+  /** Pooled connection to a server. */
+  struct Connection
+  {
+    HttpOrigin origin;                         //!< Origin connected to (empty host if unused).
+    bool inUse{false};                         //!< Indicates a request in progress.
+    uint32_t lastUse{0};                       //!< Time the last request ended.
+    std::unique_ptr<HttpTransport> transport;  //!< Transport of the connection.
+  };
+
+  const TransportFactory mFactory;                             //!< Creates the transports.
+  const uint32_t mIdleTimeout;                                 //!< Time idle connections are kept.
+  Core::Time::Clock& mClock;                                   //!< Clock to determine idle times.
+  Connection mConnections[ESP32MODULES_HTTP_MAX_CONNECTIONS];  //!< Pooled connections.
+  Statistics mStatistics;                                      //!< Counters of the pool.
+
+  /** Closes the connection and makes it available for any server. */
+  static void Close(Connection& connection);
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPCONNECTIONPOOL_HPP_
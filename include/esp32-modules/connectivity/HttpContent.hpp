@@ -0,0 +1,54 @@
+/**
+ * @file HttpContent.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides helpers describing the content of HTTP responses (types and byte ranges).
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPCONTENT_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPCONTENT_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/** Outcome of interpreting a Range header field. */
+enum class ByteRange : uint8_t
+{
+  FULL,          //!< The whole content is to be sent (no or unsupported range).
+  PARTIAL,       //!< A part of the content is to be sent.
+  UNSATISFIABLE  //!< The range lies outside of the content.
+};
+
+/**
+ * @brief Interprets the value of a Range header field (a single range in bytes).
+ *
+ * Multiple ranges and malformed values are ignored (i.e. the whole content is sent), as allowed
+ * by RFC 7233.
+ *
+ * @param header Value of the Range header field (e.g. "bytes=100-", "bytes=-500").
+ * @param size Size of the content.
+ * @param first First byte of the range (inclusive).
+ * @param last Last byte of the range (inclusive).
+ * @return Outcome (first and last are only set for PARTIAL).
+ */
+ByteRange ParseByteRange(const std::string_view header, const size_t size, size_t& first,
+                         size_t& last);
+
+/**
+ * @brief Determines the MIME type of a file from its extension.
+ *
+ * @param path Path of the file.
+ * @return MIME type (application/octet-stream for unknown extensions).
+ */
+const char* GetContentType(const std::string_view path);
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPCONTENT_HPP_
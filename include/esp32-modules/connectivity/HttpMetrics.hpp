@@ -0,0 +1,184 @@
+/**
+ * @file HttpMetrics.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides counters and latency histograms of HTTP requests.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPMETRICS_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPMETRICS_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Maximum number of endpoints (routes of the server and hosts queried by the client) tracked.
+#ifndef ESP32MODULES_HTTP_MAX_METRICS
+#define ESP32MODULES_HTTP_MAX_METRICS 16
+#endif
+
+// Maximum length of the label of an endpoint (longer ones are truncated).
+#ifndef ESP32MODULES_HTTP_METRICS_LABEL_LENGTH
+#define ESP32MODULES_HTTP_METRICS_LABEL_LENGTH 32
+#endif
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Histogram of durations with fixed buckets from 1 ms to 5 s (and beyond).
+ *
+ * Recording is lock-free (relaxed atomic increments), so it can be done from any task.
+ */
+class LatencyHistogram
+{
+ public:
+  /** @brief Number of buckets with an upper bound (followed by one for all longer durations). */
+  static constexpr size_t BOUND_COUNT{12};
+
+  /** @brief Upper bounds of the buckets in microseconds. */
+  static constexpr uint32_t BOUNDS[BOUND_COUNT]{1000,   2500,   5000,    10000,   25000,   50000,
+                                                100000, 250000, 500000, 1000000, 2500000, 5000000};
+
+  LatencyHistogram() : mBuckets{}, mCount{0}, mSum{0} {}
+  ~LatencyHistogram() = default;
+
+  /**
+   * @brief Adds a duration to the histogram.
+   *
+   * @param duration Duration in microseconds.
+   */
+  void Record(const uint32_t duration);
+
+  /** @brief Number of durations recorded in the bucket (not cumulative, the last one unbounded). */
+  uint32_t GetBucket(const size_t index) const
+  {
+    return mBuckets[index].load(std::memory_order_relaxed);
+  }
+
+  /** @brief Number of durations recorded. */
+  uint32_t GetCount() const { return mCount.load(std::memory_order_relaxed); }
+
+  /** @brief Sum of the durations recorded in microseconds (wrapping like a reset counter). */
+  uint32_t GetSum() const { return mSum.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint32_t> mBuckets[BOUND_COUNT + 1];  //!< Durations recorded per bucket.
+  std::atomic<uint32_t> mCount;                     //!< Durations recorded.
+  std::atomic<uint32_t> mSum;                       //!< Sum of the durations in microseconds.
+};
+
+/**
+ * @brief Counters of a single endpoint (a route of the server or a host queried by the client).
+ *
+ * All counters are lock-free atomics, so they can be updated from any task.
+ */
+struct EndpointMetrics
+{
+  /** Side of the connection the endpoint is tracked on. */
+  enum class Side : uint8_t
+  {
+    SERVER,  //!< Requests received by the server (phases: handler, total).
+    CLIENT   //!< Requests sent by the client (phases: dns, connect, request, transfer).
+  };
+
+  /** @brief Number of status classes (errors on client side, 1xx, 2xx, 3xx, 4xx and 5xx). */
+  static constexpr size_t STATUS_CLASS_COUNT{6};
+
+  /** @brief Number of phases of a request received by the server. */
+  static constexpr size_t SERVER_PHASE_COUNT{2};
+
+  /** @brief Number of phases of a request sent by the client. */
+  static constexpr size_t CLIENT_PHASE_COUNT{4};
+
+  /** @brief Number of histograms of an endpoint (the phases of either side). */
+  static constexpr size_t PHASE_COUNT{CLIENT_PHASE_COUNT};
+
+  /** @brief Phases of a request received by the server (indices of the histograms). */
+  static constexpr size_t HANDLER{0};  //!< Executing the callback of the route.
+  static constexpr size_t TOTAL{1};    //!< From the callback until the connection is closed.
+
+  /**
+   * @brief Phases of a request sent by the client (indices of the histograms).
+   *
+   * DNS and CONNECT are only recorded for requests opening a new connection, so their counts tell
+   * how often a pooled connection could not be reused.
+   */
+  static constexpr size_t DNS{0};       //!< Resolving the host.
+  static constexpr size_t CONNECT{1};   //!< Opening the connection (including the TLS handshake).
+  static constexpr size_t REQUEST{2};   //!< Sending the request, awaiting the status.
+  static constexpr size_t TRANSFER{3};  //!< Receiving the body.
+
+  Side side;                                                //!< Side the endpoint is tracked on.
+  char label[ESP32MODULES_HTTP_METRICS_LABEL_LENGTH];       //!< Route or host (null-terminated).
+  std::atomic<uint32_t> requests;                           //!< Requests handled.
+  std::atomic<uint32_t> statusClasses[STATUS_CLASS_COUNT];  //!< Responses per status class.
+  std::atomic<uint32_t> bytesReceived;                      //!< Bytes of bodies received.
+  std::atomic<uint32_t> bytesSent;                          //!< Bytes of bodies sent.
+  LatencyHistogram phases[PHASE_COUNT];                     //!< Durations per phase.
+
+  /**
+   * @brief Counts a request and its outcome.
+   *
+   * @param status HTTP status code (below 100 for errors on client side).
+   */
+  void RecordStatus(const int status);
+};
+
+/**
+ * @brief Fixed table of endpoint metrics, rendered in the Prometheus text format.
+ *
+ * Endpoints are added on their first use and never removed. Looking them up does not take a lock
+ * (only adding one does), so the metrics can be recorded from any task.
+ *
+ * Independent of the platform, so it can also be used (and tested) on the host.
+ */
+class HttpMetrics
+{
+ public:
+  using Side = EndpointMetrics::Side;
+
+  HttpMetrics() : mMutex{}, mEndpoints{}, mCount{0} {}
+  ~HttpMetrics() = default;
+
+  HttpMetrics(const HttpMetrics&) = delete;
+  HttpMetrics& operator=(const HttpMetrics&) = delete;
+
+  /**
+   * @brief Looks up the metrics of an endpoint, adding it if not tracked yet.
+   *
+   * @param side Side the endpoint is tracked on.
+   * @param label Route (e.g. "/sensor/{id}") or host of the endpoint.
+   * @return Metrics of the endpoint - nullptr if the table is full.
+   */
+  EndpointMetrics* Get(const Side side, const std::string_view label);
+
+  /**
+   * @brief Renders the next piece of the metrics in the Prometheus text format (version 0.0.4).
+   *
+   * Rendering piece by piece keeps the memory used independent of the number of endpoints.
+   *
+   * @param cursor Position of the rendering, to be 0 for the first piece (advanced by the call).
+   * @param out String to append the piece to.
+   * @return true if a piece was appended, false if all metrics were rendered.
+   */
+  bool Render(size_t& cursor, std::string& out) const;
+
+  /** @brief Number of endpoints tracked. */
+  size_t Size() const { return mCount.load(std::memory_order_acquire); }
+
+ private:
+  std::mutex mMutex;                                          //!< Serializes adding endpoints.
+  EndpointMetrics mEndpoints[ESP32MODULES_HTTP_MAX_METRICS];  //!< Tracked endpoints.
+  std::atomic<size_t> mCount;                                 //!< Number of tracked endpoints.
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPMETRICS_HPP_
@@ -0,0 +1,88 @@
+/**
+ * @file HttpRequest.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a read-only view of a request received by the HTTP server.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPREQUEST_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPREQUEST_HPP_
+
+// Standard header
+#include <cstddef>
+#include <string_view>
+
+// Third-party header
+#include <ESPAsyncWebServer.h>
+
+// Project header
+#include <esp32-modules/connectivity/PathRouter.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Gives handlers access to the path captures, parameters and headers of a request.
+ *
+ * All values are views into the request (no copies), valid while the handler is executed.
+ */
+class HttpRequest
+{
+ public:
+  /**
+   * @brief Sets up the view.
+   *
+   * @param request Request received by the server.
+   * @param match Route matched by the path of the request.
+   */
+  HttpRequest(AsyncWebServerRequest& request, const RouteMatch& match)
+      : mRequest{request}, mMatch{match}
+  {
+  }
+  ~HttpRequest() = default;
+
+  /** @brief Method of the request (e.g. HTTP_GET). */
+  WebRequestMethodComposite GetMethod() const { return mRequest.method(); }
+
+  /** @brief Path of the request (without the query string). */
+  std::string_view GetPath() const;
+
+  /**
+   * @brief Looks up the value of a path capture.
+   *
+   * @param name Name of the capture (e.g. "id" for "/sensor/{id}").
+   * @return Value of the capture - empty if the route has none with the name.
+   */
+  std::string_view GetCapture(const std::string_view name) const { return mMatch.GetCapture(name); }
+
+  /**
+   * @brief Looks up a parameter of the query string or (with precedence) of a form body.
+   *
+   * @param name Name of the parameter.
+   * @param value Value of the parameter.
+   * @return true if the parameter was found, false otherwise.
+   */
+  bool GetParameter(const char* name, std::string_view& value) const;
+
+  /**
+   * @brief Looks up a header field.
+   *
+   * @param name Name of the header field (case insensitive).
+   * @param value Value of the header field.
+   * @return true if the header field was found, false otherwise.
+   */
+  bool GetHeader(const char* name, std::string_view& value) const;
+
+  /** @brief Length of the body announced by the client. */
+  size_t GetContentLength() const { return mRequest.contentLength(); }
+
+ private:
+  AsyncWebServerRequest& mRequest;  //!< Request received by the server.
+  const RouteMatch& mMatch;         //!< Route matched by the path.
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPREQUEST_HPP_
@@ -0,0 +1,128 @@
+/**
+ * @file HttpResponse.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a writer for (streamed) responses of the HTTP server.
+ * @version 0.1
+ * @date 2021-10-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_HTTPRESPONSE_HPP_
+#define ESP32MODULES__CONNECTIVITY_HTTPRESPONSE_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Platform header
+#include <FS.h>
+
+// Third-party header
+#include <ESPAsyncWebServer.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpBodySource.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/** @brief Header fields (name, value) of a request or response. */
+using HttpHeaders = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Describes the response to an HTTP request: status, content type, headers and body.
+ *
+ * The body is either a (small) string or produced piece by piece by a chunk source while it is
+ * transmitted, so the memory used for large bodies (e.g. logs on an SD card) does not depend on
+ * their size. Bodies of unknown length are sent with chunked transfer encoding.
+ */
+class HttpResponse
+{
+ public:
+  /** @brief Length of a streamed body not known in advance. */
+  static constexpr size_t UNKNOWN_LENGTH{BodySource::UNKNOWN_LENGTH};
+
+  /** @brief Returned by a chunk source if the next piece is not available yet. */
+  static constexpr size_t TRY_AGAIN{BodySource::TRY_AGAIN};
+
+  /** @brief Produces the next piece of a streamed body (see Http::ChunkSource). */
+  using ChunkSource = Http::ChunkSource;
+
+  /**
+   * @brief Sets up an empty response (200, text/plain).
+   */
+  HttpResponse();
+  ~HttpResponse() = default;
+
+  /**
+   * @brief Sets the status code of the response.
+   *
+   * @param status HTTP status code.
+   */
+  void SetStatus(const int status);
+
+  /**
+   * @brief Sets the content type of the body.
+   *
+   * @param contentType MIME type of the body (e.g. "application/json").
+   */
+  void SetContentType(const std::string& contentType);
+
+  /**
+   * @brief Adds a header field to the response.
+   *
+   * @param name Name of the header field.
+   * @param value Value of the header field.
+   */
+  void AddHeader(const std::string& name, const std::string& value);
+
+  /**
+   * @brief Sets the body to the given string (taking it over without copying).
+   *
+   * @param body Body of the response.
+   */
+  void Send(std::string body);
+
+  /**
+   * @brief Streams the body from the chunk source while it is transmitted.
+   *
+   * @param source Source producing the body, executed until it returns 0 (or the given length was
+   * produced).
+   * @param length Length of the body (sent as Content-Length) - UNKNOWN_LENGTH for chunked
+   * transfer encoding. The source has to produce exactly this number of bytes.
+   */
+  void Stream(ChunkSource source, const size_t length = UNKNOWN_LENGTH);
+
+  /**
+   * @brief Streams the body from the (opened) file while it is transmitted.
+   *
+   * @param file File to be sent from its current position, closed once the body was sent.
+   */
+  void Stream(File file);
+
+ private:
+  friend class HttpServer;
+  friend class StaticFileHandler;
+
+  int mStatus;                               //!< Status code.
+  std::string mContentType;                  //!< MIME type of the body.
+  HttpHeaders mHeaders;                      //!< Additional header fields.
+  std::shared_ptr<const std::string> mBody;  //!< Body (unless streamed), shared with caches.
+  ChunkSource mSource;                       //!< Source of a streamed body.
+  size_t mLength;                            //!< Length of a streamed body.
+
+  /**
+   * Sends the response to the request (moves the body into the transmission), adding the bytes of
+   * the body to @p sentBytes (if given) as they are transmitted.
+   */
+  void SendTo(AsyncWebServerRequest* request, std::atomic<uint32_t>* sentBytes = nullptr);
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_HTTPRESPONSE_HPP_
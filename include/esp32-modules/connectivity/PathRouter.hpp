@@ -0,0 +1,125 @@
+/**
+ * @file PathRouter.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a router matching request paths against patterns with captures.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_PATHROUTER_HPP_
+#define ESP32MODULES__CONNECTIVITY_PATHROUTER_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Maximum number of captures within a single path pattern.
+#ifndef ESP32MODULES_HTTP_MAX_CAPTURES
+#define ESP32MODULES_HTTP_MAX_CAPTURES 4
+#endif
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Route a path matched with the values of its captures (views into the path).
+ */
+struct RouteMatch
+{
+  size_t route;                                                    //!< Identifier of the route.
+  size_t captureCount;                                             //!< Number of captures.
+  std::string_view captureNames[ESP32MODULES_HTTP_MAX_CAPTURES];   //!< Names of the captures.
+  std::string_view captureValues[ESP32MODULES_HTTP_MAX_CAPTURES];  //!< Values of the captures.
+
+  /**
+   * @brief Looks up the value of a capture.
+   *
+   * @param name Name of the capture (e.g. "id" for "/sensor/{id}").
+   * @return Value of the capture - empty if there is none with the name.
+   */
+  std::string_view GetCapture(const std::string_view name) const;
+};
+
+/**
+ * @brief Matches paths against a table of patterns like "/sensor/{id}/value".
+ *
+ * Patterns consist of segments separated by '/', each one either literal or a capture ("{name}")
+ * matching any single segment. They are compiled into a tree of segments when added, so matching a
+ * path walks it once: each segment is hashed and looked up in a sorted array of edges, without any
+ * allocations. Literal segments take precedence over captures at the same position without
+ * backtracking: with the patterns "/a/b/c" and "/a/{x}/d", the path "/a/b/d" does not match.
+ * Empty segments and a query string are ignored.
+ *
+ * Independent of the platform, so it can also be used (and tested) on the host.
+ *
+ * @note Not thread-safe, routes have to be added before matching concurrently.
+ */
+class PathRouter
+{
+ public:
+  /** @brief Identifier indicating an invalid route. */
+  static constexpr size_t NO_ROUTE{static_cast<size_t>(-1)};
+
+  PathRouter();
+  ~PathRouter() = default;
+
+  /**
+   * @brief Adds the pattern to the table.
+   *
+   * @param pattern Pattern of the route (e.g. "/sensor/{id}").
+   * @return Identifier of the route (consecutive, starting at 0, the same one if the pattern was
+   * already added) - NO_ROUTE if the pattern is malformed or has too many captures.
+   */
+  size_t Add(const std::string_view pattern);
+
+  /**
+   * @brief Matches the path against the table.
+   *
+   * @param path Path of a request.
+   * @param match Matched route and its captures (referring to the path).
+   * @return true if a route matched, false otherwise.
+   */
+  bool Match(const std::string_view path, RouteMatch& match) const;
+
+  /** @brief Number of routes. */
+  size_t Size() const { return mRoutes.size(); }
+
+ private:
+  /** Index indicating a missing node or route. */
+  static constexpr uint32_t NONE{0xFFFFFFFFu};
+
+  /** Node of the tree, representing the pattern up to a segment. */
+  struct Node
+  {
+    uint32_t captureChild;  //!< Node following a capture - NONE if there is none.
+    uint32_t route;         //!< Route ending at this node - NONE if there is none.
+  };
+
+  /** Literal segment leading from one node to another. */
+  struct Edge
+  {
+    uint32_t parent;      //!< Node the segment follows.
+    uint32_t hash;        //!< Hash of the segment.
+    uint32_t child;       //!< Node reached via the segment.
+    std::string segment;  //!< Literal segment.
+  };
+
+  /** Names of the captures of a route. */
+  using CaptureNames = std::vector<std::string>;
+
+  std::vector<Node> mNodes;           //!< Nodes of the tree (the root first).
+  std::vector<Edge> mEdges;           //!< Literal edges sorted by parent and hash.
+  std::vector<CaptureNames> mRoutes;  //!< Capture names of the routes.
+
+  /** Looks up the literal edge following the node - nullptr if there is none. */
+  const Edge* FindEdge(const uint32_t parent, const std::string_view segment,
+                       const uint32_t hash) const;
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_PATHROUTER_HPP_
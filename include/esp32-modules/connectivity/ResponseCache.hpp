@@ -0,0 +1,137 @@
+/**
+ * @file ResponseCache.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a cache of rendered HTTP responses validated by ETags.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_RESPONSECACHE_HPP_
+#define ESP32MODULES__CONNECTIVITY_RESPONSECACHE_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Maximum number of bytes taken by the entries of a response cache (bodies, keys and ETags).
+#ifndef ESP32MODULES_HTTP_CACHE_SIZE
+#define ESP32MODULES_HTTP_CACHE_SIZE 16384
+#endif
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Keeps rendered response bodies until the application bumps their version.
+ *
+ * Each entry is identified by a key (e.g. the request path) and stores the body together with the
+ * version of the data it was rendered from and an ETag derived from its contents. As long as the
+ * version does not change, the body can be served again (or a client be told that its copy is
+ * still valid) without rendering it. If storing a body would exceed the memory budget, the least
+ * recently used entries are evicted.
+ *
+ * Independent of the platform, so it can also be used (and tested) on the host.
+ *
+ * @note Not thread-safe, to be used from the context of the server only.
+ */
+class ResponseCache
+{
+ public:
+  /** Cached response. */
+  struct Entry
+  {
+    std::string key;                          //!< Identifies the response.
+    uint32_t version;                         //!< Version of the data rendered.
+    std::string etag;                         //!< ETag of the body (quoted).
+    std::string contentType;                  //!< MIME type of the body.
+    std::shared_ptr<const std::string> body;  //!< Rendered body (shared with transmissions).
+    uint32_t lastUse;                         //!< Tick of the last lookup.
+  };
+
+  /** Counters of the cache. */
+  struct Statistics
+  {
+    uint32_t hits;       //!< Number of lookups served from the cache.
+    uint32_t misses;     //!< Number of lookups requiring a body to be rendered.
+    uint32_t evictions;  //!< Number of entries evicted to stay within the budget.
+  };
+
+  /**
+   * @brief Sets up the (empty) cache.
+   *
+   * @param budget Maximum number of bytes taken by the entries.
+   */
+  explicit ResponseCache(const size_t budget = ESP32MODULES_HTTP_CACHE_SIZE);
+  ~ResponseCache() = default;
+
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+
+  /**
+   * @brief Looks up the response rendered for the current version.
+   *
+   * @param key Identifies the response.
+   * @param version Current version of the data.
+   * @return Cached response (valid until the next call of Store()) - nullptr if there is none or
+   * it is outdated.
+   */
+  const Entry* Find(const std::string_view key, const uint32_t version);
+
+  /**
+   * @brief Stores a rendered response (replacing an outdated one).
+   *
+   * @param key Identifies the response.
+   * @param version Version of the data rendered.
+   * @param contentType MIME type of the body.
+   * @param body Rendered body.
+   * @return Cached response (valid until the next call of Store()) - nullptr if it exceeds the
+   * budget on its own.
+   */
+  const Entry* Store(const std::string_view key, const uint32_t version,
+                     const std::string& contentType, std::shared_ptr<const std::string> body);
+
+  /**
+   * @brief Derives the (strong) ETag of a body from its contents.
+   *
+   * @param body Body of a response.
+   * @return Quoted ETag.
+   */
+  static std::string MakeETag(const std::string_view body);
+
+  /**
+   * @brief Checks whether an If-None-Match header lists the ETag (i.e. the client's copy is valid).
+   *
+   * The entity tags of the list are compared with the weak comparison (ignoring "W/"), as required
+   * for If-None-Match; "*" matches any ETag.
+   *
+   * @param ifNoneMatch Value of the If-None-Match header.
+   * @param etag Quoted ETag of the current response.
+   * @return true if the ETag is listed, false otherwise.
+   */
+  static bool MatchesETag(const std::string_view ifNoneMatch, const std::string_view etag);
+
+  /** @brief Number of bytes taken by the entries. */
+  size_t GetSize() const { return mSize; }
+
+  /** @brief Provides the counters of the cache. */
+  Statistics GetStatistics() const { return mStatistics; }
+
+ private:
+  const size_t mBudget;         //!< Maximum number of bytes taken by the entries.
+  std::vector<Entry> mEntries;  //!< Cached responses.
+  size_t mSize;                 //!< Number of bytes taken by the entries.
+  uint32_t mTick;               //!< Counter ordering the lookups.
+  Statistics mStatistics;       //!< Counters of the cache.
+
+  /** Removes the entry at the index. */
+  void Remove(const size_t index);
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_RESPONSECACHE_HPP_
@@ -0,0 +1,245 @@
+/**
+ * @file SendQueue.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a send queue coalescing messages into MTU-sized chunks with flow control.
+ * @version 0.1
+ * @date 2021-09-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_SENDQUEUE_HPP_
+#define ESP32MODULES__CONNECTIVITY_SENDQUEUE_HPP_
+
+// Standard header
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+// Project header
+#include <esp32-modules/core/containers/FrameRing.hpp>
+
+namespace Esp32Modules::Connectivity
+{
+/**
+ * @brief Queues outgoing messages and sends them as chunks of at most the transport's MTU.
+ *
+ * Small messages are coalesced into a single chunk as long as they fit, messages exceeding a chunk
+ * are split across several chunks. A message fitting a chunk on its own is never split, so peers
+ * receiving self-delimiting messages (e.g. newline terminated or binary frames) mostly get whole
+ * messages per chunk.
+ *
+ * Flow control is based on credits: each chunk handed to the transport takes one credit and each
+ * completed transmission (see OnSent()) returns it. Without credits or if the transport rejects a
+ * chunk (e.g. congested), sending pauses until the next call of Flush().
+ *
+ * Messages are queued in a lock-free FrameRing: one producer enqueues while one consumer flushes.
+ *
+ * @tparam Capacity Size of the queue in bytes (power of two, including two bytes per message).
+ * @tparam MaxChunk Largest chunk handed to the transport.
+ * @tparam MaxMessage Largest message that can be enqueued.
+ */
+template <size_t Capacity, size_t MaxChunk, size_t MaxMessage = MaxChunk>
+class SendQueue
+{
+  static_assert(MaxMessage <= Core::Containers::FrameRing<Capacity>::MAX_FRAME_SIZE,
+                "Messages must fit into the queue.");
+
+ public:
+  /** Transport sending a chunk - returns false if the chunk could not be sent (retried later). */
+  using Transport = std::function<bool(const uint8_t* chunk, size_t length)>;
+
+  /**
+   * @brief Counters of the queue.
+   */
+  struct Statistics
+  {
+    uint32_t messages;  //!< Number of messages enqueued.
+    uint32_t rejected;  //!< Number of messages rejected (too large or queue full).
+    uint32_t chunks;    //!< Number of chunks sent.
+    uint32_t bytes;     //!< Number of message bytes sent.
+    uint32_t stalls;    //!< Number of flushes paused by missing credits or a busy transport.
+  };
+
+  /**
+   * @brief Creates a queue sending via the given transport.
+   *
+   * @param transport Transport sending the chunks.
+   * @param maxInFlight Maximum number of chunks sent but not yet completed.
+   */
+  SendQueue(Transport transport, const uint8_t maxInFlight)
+      : mTransport{std::move(transport)},
+        mMaxInFlight{maxInFlight},
+        mCredits{maxInFlight},
+        mChunkSize{MaxChunk},
+        mMessages{},
+        mMessage{},
+        mMessageLength{0},
+        mMessageOffset{0},
+        mChunk{},
+        mChunkLength{0},
+        mStatistics{},
+        mRejected{0}
+  {
+  }
+  ~SendQueue() = default;
+
+  SendQueue(const SendQueue&) = delete;
+  SendQueue& operator=(const SendQueue&) = delete;
+
+  /**
+   * @brief Appends a message (producer only).
+   *
+   * @param data Content of the message.
+   * @param length Size of the message.
+   * @return true if the message was queued, false if it is too large or the queue is full.
+   */
+  bool Enqueue(const uint8_t* data, const size_t length)
+  {
+    if (length == 0 or length > MaxMessage or not mMessages.Push(data, length))
+    {
+      mRejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Sends as many chunks as the credits allow (consumer only).
+   *
+   * @return Number of chunks sent.
+   */
+  size_t Flush()
+  {
+    size_t sent{0};
+    while (true)
+    {
+      if (mChunkLength == 0 and not FillChunk())
+      {
+        return sent;  // Nothing left to send.
+      }
+      if (mCredits.load(std::memory_order_acquire) == 0)
+      {
+        ++mStatistics.stalls;
+        return sent;
+      }
+      mCredits.fetch_sub(1, std::memory_order_acq_rel);
+      if (not mTransport(mChunk, mChunkLength))
+      {
+        OnSent();  // Nothing in flight, keep the chunk for the next flush.
+        ++mStatistics.stalls;
+        return sent;
+      }
+      ++mStatistics.chunks;
+      mStatistics.bytes += mChunkLength;
+      mChunkLength = 0;
+      ++sent;
+    }
+  }
+
+  /**
+   * @brief Signals the completion of a chunk handed to the transport (any context).
+   */
+  void OnSent()
+  {
+    uint8_t credits = mCredits.load(std::memory_order_relaxed);
+    while (credits < mMaxInFlight and
+           not mCredits.compare_exchange_weak(credits, credits + 1, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /**
+   * @brief Forgets all chunks in flight and the rest of a partially sent message (e.g. after the
+   * peer disconnected). Queued messages are kept.
+   *
+   * @note Consumer only.
+   */
+  void Reset()
+  {
+    mCredits.store(mMaxInFlight, std::memory_order_release);
+    mChunkLength = 0;
+    mMessageOffset = mMessageLength;
+  }
+
+  /**
+   * @brief Sets the size of the chunks (e.g. the negotiated MTU minus protocol overhead).
+   *
+   * @note Consumer only, affects chunks not yet filled.
+   *
+   * @param size Size of the chunks (limited to MaxChunk).
+   */
+  void SetChunkSize(const size_t size) { mChunkSize = std::clamp<size_t>(size, 1, MaxChunk); }
+
+  /** @brief Current size of the chunks. */
+  size_t GetChunkSize() const { return mChunkSize; }
+
+  /** @brief Indicates whether nothing is left to be sent (consumer only). */
+  bool Empty() const
+  {
+    return mChunkLength == 0 and mMessageOffset == mMessageLength and mMessages.Empty();
+  }
+
+  /**
+   * @brief Provides the counters of the queue.
+   *
+   * @note Consumer only (apart from the rejected messages).
+   */
+  Statistics GetStatistics() const
+  {
+    auto statistics = mStatistics;
+    statistics.messages = mMessages.GetStatistics().pushed;
+    statistics.rejected = mRejected.load(std::memory_order_relaxed);
+    return statistics;
+  }
+
+ private:
+  Transport mTransport;                             //!< Transport sending the chunks.
+  const uint8_t mMaxInFlight;                       //!< Maximum number of chunks in flight.
+  std::atomic<uint8_t> mCredits;                    //!< Chunks that may be sent right now.
+  size_t mChunkSize;                                //!< Current size of the chunks.
+  Core::Containers::FrameRing<Capacity> mMessages;  //!< Messages not yet taken into chunks.
+  uint8_t mMessage[MaxMessage];                     //!< Message being split into chunks.
+  size_t mMessageLength;                            //!< Size of the current message.
+  size_t mMessageOffset;                            //!< Bytes of the current message sent.
+  uint8_t mChunk[MaxChunk];                         //!< Chunk to be sent next.
+  size_t mChunkLength;                              //!< Size of the chunk to be sent next.
+  Statistics mStatistics;                           //!< Counters (of the consumer).
+  std::atomic<uint32_t> mRejected;                  //!< Number of rejected messages.
+
+  /** Coalesces the queued messages into the next chunk, returns false if there is none. */
+  bool FillChunk()
+  {
+    while (mChunkLength < mChunkSize)
+    {
+      if (mMessageOffset == mMessageLength)
+      {
+        if (not mMessages.Pop(mMessage, sizeof(mMessage), mMessageLength))
+        {
+          mMessageLength = 0;
+          mMessageOffset = 0;
+          break;
+        }
+        mMessageOffset = 0;
+      }
+      const size_t remaining = mMessageLength - mMessageOffset;
+      const size_t space = mChunkSize - mChunkLength;
+      if (mChunkLength > 0 and remaining > space and remaining <= mChunkSize)
+      {
+        break;  // Fits into the next chunk as a whole, do not split it.
+      }
+      const size_t taken = std::min(remaining, space);
+      std::memcpy(&mChunk[mChunkLength], &mMessage[mMessageOffset], taken);
+      mChunkLength += taken;
+      mMessageOffset += taken;
+    }
+    return mChunkLength > 0;
+  }
+};
+}  // namespace Esp32Modules::Connectivity
+
+#endif  // ESP32MODULES__CONNECTIVITY_SENDQUEUE_HPP_
@@ -0,0 +1,64 @@
+/**
+ * @file StaticFileHandler.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a handler serving static files of a filesystem via the HTTP server.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_STATICFILEHANDLER_HPP_
+#define ESP32MODULES__CONNECTIVITY_STATICFILEHANDLER_HPP_
+
+// Standard header
+#include <string>
+
+// Platform header
+#include <FS.h>
+
+// Third-party header
+#include <ESPAsyncWebServer.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpContent.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+/**
+ * @brief Serves the files of a directory for GET requests to paths below a prefix.
+ *
+ * Files are streamed in pieces of the size the connection can take, so they never have to fit
+ * into the memory. If the client accepts gzip and a pre-compressed variant ("<file>.gz") exists,
+ * it is sent instead (with Content-Encoding: gzip). Single byte ranges are supported to resume
+ * downloads. Responses carry Cache-Control and an ETag derived from the size and the modification
+ * time of the file, so revalidations are answered with 304.
+ */
+class StaticFileHandler : public AsyncWebHandler
+{
+ public:
+  /**
+   * @brief Sets up the handler.
+   *
+   * @param prefix Path prefix of the requests (e.g. "/static").
+   * @param fs Filesystem the files are read from (e.g. via SdCard::GetFilesystemHandle()).
+   * @param root Directory the prefix is mapped to (e.g. "/www").
+   * @param cacheControl Value of the Cache-Control header field - empty for none.
+   */
+  StaticFileHandler(const std::string& prefix, fs::FS& fs, const std::string& root,
+                    const std::string& cacheControl);
+  ~StaticFileHandler() = default;
+
+  bool canHandle(AsyncWebServerRequest* request) override;
+  void handleRequest(AsyncWebServerRequest* request) override;
+
+ private:
+  const std::string mPrefix;        //!< Path prefix of the requests.
+  fs::FS& mFS;                      //!< Filesystem the files are read from.
+  const std::string mRoot;          //!< Directory the prefix is mapped to.
+  const std::string mCacheControl;  //!< Value of the Cache-Control header field.
+};
+
+}  // namespace Esp32Modules::Connectivity::Http
+
+#endif  // ESP32MODULES__CONNECTIVITY_STATICFILEHANDLER_HPP_
@@ -0,0 +1,76 @@
+/**
+ * @file Uart.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides classes to receive commands via a serial interface.
+ * @version 0.1
+ * @date 2021-09-25
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CONNECTIVITY_UART_HPP_
+#define ESP32MODULES__CONNECTIVITY_UART_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+
+// Platform header
+#include <Arduino.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandRouter.hpp>
+
+// Maximum length of a received command line in bytes (without the line ending).
+#ifndef ESP32MODULES_UART_MAX_LINE_LENGTH
+#define ESP32MODULES_UART_MAX_LINE_LENGTH 128
+#endif
+
+namespace Esp32Modules::Connectivity::Uart
+{
+/**
+ * @brief Reads "token parameters" commands line by line from a stream (e.g. Serial) and
+ * dispatches them via a router.
+ *
+ * Lines are terminated by '\n' (a preceding '\r' is ignored) and collected in a fixed buffer
+ * without heap allocations. Lines exceeding the buffer are discarded as a whole.
+ */
+class UartCommandReceiver
+{
+ public:
+  /** Counters of the receiver. */
+  struct Statistics
+  {
+    uint32_t lines;      //!< Number of complete lines dispatched.
+    uint32_t discarded;  //!< Number of lines discarded for being too long.
+  };
+
+  /**
+   * @brief Sets up the receiver.
+   *
+   * @param stream Stream to read the commands from (already initialized, e.g. by Serial.begin()).
+   * @param router Router dispatching the commands, has to outlive the receiver.
+   */
+  UartCommandReceiver(Stream& stream, CommandRouter& router);
+  ~UartCommandReceiver() = default;
+
+  /**
+   * @brief Reads all bytes available (without blocking) and dispatches the completed lines.
+   */
+  void ProcessPendingCommands();
+
+  /** @brief Provides the counters of the receiver. */
+  Statistics GetStatistics() const { return mStatistics; }
+
+ private:
+  Stream& mStream;                                //!< Stream providing the commands.
+  CommandRouter& mRouter;                         //!< Router dispatching the commands.
+  char mLine[ESP32MODULES_UART_MAX_LINE_LENGTH];  //!< Line received so far.
+  size_t mLength;                                 //!< Length of the line received so far.
+  bool mOverflow;                                 //!< Indicates a line to be discarded.
+  Statistics mStatistics;                         //!< Counters of the receiver.
+};
+
+}  // namespace Esp32Modules::Connectivity::Uart
+
+#endif  // ESP32MODULES__CONNECTIVITY_UART_HPP_
@@ -0,0 +1,278 @@
+/**
+ * @file FrameRing.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a bounded, lock-free single-producer/single-consumer ring of byte frames.
+ * @version 0.1
+ * @date 2021-08-28
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_CONTAINERS_FRAMERING_HPP_
+#define ESP32MODULES__CORE_CONTAINERS_FRAMERING_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Esp32Modules::Core::Containers
+{
+/**
+ * @brief Behavior of a FrameRing if a new frame does not fit anymore.
+ */
+enum class OverflowPolicy : uint8_t
+{
+  DROP_NEWEST,  //!< Discard the new frame, keep the ones already queued (counted as dropped).
+  DROP_OLDEST,  //!< Discard the oldest frames until the new frame fits (counted as dropped).
+  REJECT        //!< Refuse the new frame, left to the producer (counted as rejected, not dropped).
+};
+
+/**
+ * @brief Bounded ring buffer storing length-prefixed byte frames (no heap allocations).
+ *
+ * Each frame is stored as a 16 bit length followed by its payload, wrapping around the end of the
+ * buffer if necessary. One producer thread (e.g. the BLE stack) pushes while one consumer thread
+ * (e.g. the cooperative loop) pops - both without locking.
+ *
+ * To drop the oldest frames, the producer advances the read index with a compare-and-swap. A
+ * consumer copying a frame dropped meanwhile notices the moved index and discards the copy, which
+ * is why the payload bytes are accessed atomically (plain loads and stores on the ESP32).
+ *
+ * @tparam Capacity Size of the buffer in bytes (power of two, including the length prefixes).
+ */
+template <size_t Capacity>
+class FrameRing
+{
+  static_assert(Capacity >= 4 and (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two.");
+
+ public:
+  /** Size of the length prefix of each frame. */
+  static constexpr size_t HEADER_SIZE{2};
+  /** Largest frame that can be stored. */
+  static constexpr size_t MAX_FRAME_SIZE{(Capacity - HEADER_SIZE) < 0xFFFF ? Capacity - HEADER_SIZE
+                                                                           : 0xFFFF};
+
+  /**
+   * @brief Counters of the ring.
+   */
+  struct Statistics
+  {
+    uint32_t pushed;    //!< Number of frames stored.
+    uint32_t popped;    //!< Number of frames taken by the consumer.
+    uint32_t dropped;   //!< Number of frames discarded (overflow or too large).
+    uint32_t rejected;  //!< Number of frames refused with OverflowPolicy::REJECT.
+    uint32_t peak;      //!< Maximum number of bytes in use (including the length prefixes).
+  };
+
+  explicit FrameRing(const OverflowPolicy policy = OverflowPolicy::DROP_NEWEST)
+      : mPolicy{policy},
+        mHead{0},
+        mTail{0},
+        mBuffer{},
+        mPushed{0},
+        mPopped{0},
+        mDropped{0},
+        mRejected{0},
+        mPeak{0}
+  {
+  }
+  ~FrameRing() = default;
+
+  FrameRing(const FrameRing&) = delete;
+  FrameRing& operator=(const FrameRing&) = delete;
+
+  /**
+   * @brief Appends a frame (producer only).
+   *
+   * @param data Payload of the frame.
+   * @param length Size of the payload.
+   * @return true if the frame was stored, false if it was dropped or rejected (too large, or no
+   * space left with OverflowPolicy::DROP_NEWEST or OverflowPolicy::REJECT).
+   */
+  bool Push(const uint8_t* data, const size_t length) { return Push(nullptr, 0, data, length); }
+
+  /**
+   * @brief Appends a frame consisting of a prefix followed by the actual data (producer only).
+   *
+   * Saves copying both parts into a temporary buffer (e.g. to prepend a timestamp).
+   *
+   * @param prefix First part of the payload.
+   * @param prefixLength Size of the first part.
+   * @param data Second part of the payload.
+   * @param length Size of the second part.
+   * @return true if the frame was stored, false if it was dropped or rejected (see above).
+   */
+  bool Push(const uint8_t* prefix, const size_t prefixLength, const uint8_t* data,
+            const size_t length)
+  {
+    return Push(mPolicy, prefix, prefixLength, data, length);
+  }
+
+  /**
+   * @brief Appends a frame, dropping the oldest frames if necessary (producer only).
+   *
+   * Ignores the overflow policy, for frames that must not be lost (e.g. markers separating the
+   * frames of different sources).
+   *
+   * @param prefix First part of the payload.
+   * @param prefixLength Size of the first part.
+   * @param data Second part of the payload.
+   * @param length Size of the second part.
+   * @return true if the frame was stored, false if it is too large.
+   */
+  bool PushDroppingOldest(const uint8_t* prefix, const size_t prefixLength, const uint8_t* data,
+                          const size_t length)
+  {
+    return Push(OverflowPolicy::DROP_OLDEST, prefix, prefixLength, data, length);
+  }
+
+  /**
+   * @brief Takes the oldest frame (consumer only).
+   *
+   * Frames larger than the given buffer are discarded.
+   *
+   * @param buffer Buffer the payload is copied to.
+   * @param size Size of the buffer.
+   * @param length Size of the payload copied.
+   * @return true if a frame was taken, false if the ring is empty.
+   */
+  bool Pop(uint8_t* buffer, const size_t size, size_t& length)
+  {
+    uint32_t tail = mTail.load(std::memory_order_acquire);
+    while (tail != mHead.load(std::memory_order_acquire))
+    {
+      const uint32_t frameLength = ReadLength(tail);
+      const bool fits = (frameLength <= size);
+      if (fits)
+      {
+        for (uint32_t i = 0; i < frameLength; ++i)
+        {
+          buffer[i] = Read(tail + HEADER_SIZE + i);
+        }
+      }
+      // Fails if the producer dropped the frame while it was copied, retry with the next one.
+      if (mTail.compare_exchange_strong(tail, tail + HEADER_SIZE + frameLength,
+                                        std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        if (fits)
+        {
+          mPopped.fetch_add(1, std::memory_order_relaxed);
+          length = frameLength;
+          return true;
+        }
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        tail += HEADER_SIZE + frameLength;
+      }
+    }
+    return false;
+  }
+
+  /** @brief Indicates whether no frame is queued (snapshot, may be outdated immediately). */
+  bool Empty() const
+  {
+    return mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_acquire);
+  }
+
+  /** @brief Number of bytes in use including the length prefixes (snapshot). */
+  size_t SizeApprox() const
+  {
+    return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+  }
+
+  /** @brief Provides the counters of the ring. */
+  Statistics GetStatistics() const
+  {
+    return {mPushed.load(std::memory_order_relaxed), mPopped.load(std::memory_order_relaxed),
+            mDropped.load(std::memory_order_relaxed), mRejected.load(std::memory_order_relaxed),
+            mPeak.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  static constexpr uint32_t MASK{Capacity - 1};
+
+  const OverflowPolicy mPolicy;            //!< Behavior if a frame does not fit.
+  std::atomic<uint32_t> mHead;             //!< Write index (only advanced by the producer).
+  std::atomic<uint32_t> mTail;             //!< Read index (advanced by the consumer or dropping).
+  std::atomic<uint8_t> mBuffer[Capacity];  //!< Frames including their length prefixes.
+  std::atomic<uint32_t> mPushed;           //!< Number of frames stored.
+  std::atomic<uint32_t> mPopped;           //!< Number of frames taken.
+  std::atomic<uint32_t> mDropped;          //!< Number of frames discarded.
+  std::atomic<uint32_t> mRejected;         //!< Number of frames refused.
+  std::atomic<uint32_t> mPeak;             //!< Maximum number of bytes in use (producer only).
+
+  uint8_t Read(const uint32_t index) const
+  {
+    return mBuffer[index & MASK].load(std::memory_order_relaxed);
+  }
+
+  void Write(const uint32_t index, const uint8_t value)
+  {
+    mBuffer[index & MASK].store(value, std::memory_order_relaxed);
+  }
+
+  uint32_t ReadLength(const uint32_t index) const
+  {
+    return static_cast<uint32_t>(Read(index)) | (static_cast<uint32_t>(Read(index + 1)) << 8);
+  }
+
+  /** Appends a frame, handling an overflow according to the given policy. */
+  bool Push(const OverflowPolicy policy, const uint8_t* prefix, const size_t prefixLength,
+            const uint8_t* data, const size_t length)
+  {
+    const size_t frameLength = prefixLength + length;
+    if (frameLength > MAX_FRAME_SIZE)
+    {
+      (policy == OverflowPolicy::REJECT ? mRejected : mDropped)
+          .fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    const uint32_t head = mHead.load(std::memory_order_relaxed);
+    const uint32_t required = HEADER_SIZE + frameLength;
+    uint32_t tail = mTail.load(std::memory_order_acquire);
+    while (Capacity - (head - tail) < required)
+    {
+      if (policy == OverflowPolicy::DROP_NEWEST)
+      {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      if (policy == OverflowPolicy::REJECT)
+      {
+        mRejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      // Drop the oldest frame, unless the consumer took it in the meantime.
+      const uint32_t next = tail + HEADER_SIZE + ReadLength(tail);
+      if (mTail.compare_exchange_weak(tail, next, std::memory_order_acq_rel,
+                                      std::memory_order_acquire))
+      {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        tail = next;
+      }
+    }
+    Write(head, static_cast<uint8_t>(frameLength & 0xFF));
+    Write(head + 1, static_cast<uint8_t>(frameLength >> 8));
+    for (size_t i = 0; i < prefixLength; ++i)
+    {
+      Write(head + HEADER_SIZE + i, prefix[i]);
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+      Write(head + HEADER_SIZE + prefixLength + i, data[i]);
+    }
+    mHead.store(head + required, std::memory_order_release);
+    mPushed.fetch_add(1, std::memory_order_relaxed);
+    // Based on a possibly outdated read index, so the peak may be overestimated slightly.
+    const uint32_t usage = head + required - tail;
+    if (usage > mPeak.load(std::memory_order_relaxed))
+    {
+      mPeak.store(usage, std::memory_order_relaxed);
+    }
+    return true;
+  }
+};
+}  // namespace Esp32Modules::Core::Containers
+
+#endif  // ESP32MODULES__CORE_CONTAINERS_FRAMERING_HPP_
@@ -0,0 +1,30 @@
+/**
+ * @file LightSleep.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides functions to leverage the ESP's light sleep functionality.
+ * @version 0.1
+ * @date 2021-07-24
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_LOWPOWER_LIGHTSLEEP_HPP_
+#define ESP32MODULES__CORE_LOWPOWER_LIGHTSLEEP_HPP_
+
+// Standard header
+#include <chrono>
+
+namespace Esp32Modules::Core::LowPower
+{
+
+/**
+ * @brief Enters light sleep and awakes after the specified amount of milliseconds.
+ *
+ * In contrast to deep sleep, the application continues right where it entered the light sleep.
+ *
+ * @param duration Milliseconds after which the light sleep mode shall be left again.
+ */
+void LightSleepFor(const std::chrono::milliseconds duration);
+}  // namespace Esp32Modules::Core::LowPower
+
+#endif  // ESP32MODULES__CORE_LOWPOWER_LIGHTSLEEP_HPP_
@@ -12,22 +12,74 @@
 #define ESP32MODULES__CORE_COOPERATIVESCHEDULER_HPP_
 
 // Standard header
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <map>
 #include <memory>
 
+// Per-task execution statistics (run counts, execution times, start latencies, timeout overruns).
+// Compiled out by default, to enable them compile the project with
+// #define ESP32MODULES_SCHEDULER_PROFILING
+
+// The TaskScheduler is only needed by the default engine (see ESP32MODULES_SCHEDULER_TIMING_WHEEL
+// below). Without it, the scheduler builds on the host as well (e.g. together with a
+// Time::SimulatedClock for deterministic off-target runs).
+#ifndef ESP32MODULES_SCHEDULER_TIMING_WHEEL
 // Preprocessor configuration for the TaskScheduler
-// Enable 1 ms powerdowns between tasks if no callback methods were invoked during the pass
+// Enable 1 ms powerdowns between tasks if no callback methods were invoked during the pass (only
+// used as long as no IdlePolicy is set on the CooperativeScheduler)
 #define _TASK_SLEEP_ON_IDLE_RUN
 #define _TASK_TIMEOUT
 #define _TASK_WDT_IDS
-// Use std::function for task callbacks (instead of function pointers)
+// Use std::function for task callbacks (instead of function pointers). Callbacks of the
+// CooperativeScheduler are stored as TaskFunction and only forwarded by small std::function
+// wrappers which fit into their small buffer (i.e. do not allocate).
 #define _TASK_STD_FUNCTION
 // Do not use microsecond precision. If needed, compile the project with
 // #define _TASK_MICRO_RES
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+#define _TASK_TIMECRITICAL  // Provides the start delay of TaskScheduler tasks.
+#endif
 
 // Third-party header
 #include <TaskSchedulerDeclarations.h>  // Forward declarations, includes std::function
+#else
+// Same time helpers and iteration counts as provided by the TaskScheduler.
+#ifndef TASK_MILLISECOND
+#define TASK_MILLISECOND 1UL
+#define TASK_SECOND 1000UL
+#define TASK_MINUTE 60000UL
+#define TASK_HOUR 3600000UL
+#define TASK_IMMEDIATE 0
+#define TASK_FOREVER (-1)
+#define TASK_ONCE 1
+#endif
+#endif
+
+// Project header
+#include <esp32-modules/core/scheduling/InplaceFunction.hpp>
+#include <esp32-modules/core/scheduling/TaskPool.hpp>
+#include <esp32-modules/core/scheduling/TaskProfile.hpp>
+#include <esp32-modules/core/scheduling/TimingWheel.hpp>
+#include <esp32-modules/core/time/Clock.hpp>
+
+// Scheduler engine configuration
+// By default, tasks are executed by the TaskScheduler which walks through all tasks on each pass.
+// To use the native timing wheel engine instead (O(1) adding, aborting and dispatching of tasks
+// and constant time for passes without due tasks), compile the project with
+// #define ESP32MODULES_SCHEDULER_TIMING_WHEEL
+
+// Maximum number of tasks alive at the same time (excluding the main task). Task resources are
+// taken from a fixed pool of this size, so adjust it to the needs of the project if necessary.
+#ifndef ESP32MODULES_SCHEDULER_MAX_TASKS
+#define ESP32MODULES_SCHEDULER_MAX_TASKS 64
+#endif
+
+// Size of the inline storage (in bytes) for the captures of task callbacks. Larger captures are
+// rejected at compile time.
+#ifndef ESP32MODULES_SCHEDULER_CALLBACK_SIZE
+#define ESP32MODULES_SCHEDULER_CALLBACK_SIZE (4 * sizeof(void*))
+#endif
 
 namespace Esp32Modules::Core::Scheduling
 {
@@ -41,18 +93,51 @@ namespace Esp32Modules::Core::Scheduling
  *   TASK_HOUR
  */
 using TaskDuration = uint32_t;
-using TaskId = uint16_t;  //!< Id of a task used for removing running tasks.
+using TaskId = uint32_t;  //!< Id of a task used for removing running tasks.
 
 constexpr TaskId INVALID_TASKID{0};  //!< Indicates a task is not valid.
+constexpr uint16_t MAX_TASKS{ESP32MODULES_SCHEDULER_MAX_TASKS};  //!< Capacity of the task pool.
+
+/**
+ * @brief Callback executed by a task.
+ *
+ * Move-only and stored in place, i.e. creating tasks does not allocate memory. Captures must fit
+ * into ESP32MODULES_SCHEDULER_CALLBACK_SIZE bytes.
+ */
+using TaskFunction = InplaceFunction<void(), ESP32MODULES_SCHEDULER_CALLBACK_SIZE>;
+constexpr TaskDuration NO_TASK_PENDING{UINT32_MAX};  //!< Indicates that no task is scheduled.
 constexpr TaskDuration DEFAULT_TIMEOUT{
     100 * TASK_MILLISECOND};  //!< Default timeout of tasks (used to prevent longrunning tasks.)
+constexpr uint32_t NO_PASS_BUDGET{0};  //!< Disables the time budget of scheduler passes.
+
+/**
+ * @brief Priority classes of tasks.
+ *
+ * Tasks due in the same pass are executed class by class (CRITICAL first). Within a class, the
+ * task with the earliest due time is executed first (only guaranteed by the timing wheel engine).
+ */
+enum class TaskPriority : uint8_t
+{
+  CRITICAL,   //!< Latency-critical work (e.g. radio servicing), never deferred by the pass budget.
+  NORMAL,     //!< Default class, also used by the main task.
+  BACKGROUND  //!< Bulk work (e.g. SD card writes) executed after everything else.
+};
+
+class IdlePolicy;
+class TaskEvent;
 
 /**
- * @brief Provides a std::function based scheduler including resource management.
+ * @brief Provides a callback based scheduler including resource management.
  *
- * The cooperative scheduler uses the TaskScheduler for task execution and manages task lifetime
- * (persistence, aborting, garbage collection). It is meant to be run as the single active "thread"
- * of the application, i.e. tasks run by the scheduler are never executed in parallel.
+ * The cooperative scheduler uses the TaskScheduler (or the native timing wheel engine, see
+ * ESP32MODULES_SCHEDULER_TIMING_WHEEL) for task execution and manages task lifetime (persistence,
+ * aborting, recycling). It is meant to be run as the single active "thread" of the application,
+ * i.e. tasks run by the scheduler are never executed in parallel.
+ *
+ * Tasks (including their callbacks) are kept in a fixed pool of MAX_TASKS slots without any heap
+ * allocations. The slot of a task
+ * is recycled as soon as the task finished or was aborted. Task ids carry the generation of their
+ * slot, so ids of finished tasks never refer to a newer task reusing the slot.
  *
  * As at least one task shall be executed (scheduling makes no sense otherwise), a main task must be
  * defined during construction already. The main task or any other tasks are free to add new tasks
@@ -61,18 +146,24 @@ constexpr TaskDuration DEFAULT_TIMEOUT{
  * Examples for a main task are implementations checking external interfaces or certain conditions
  * for aborting the overall execution.
  *
+ * Tasks due in the same pass are executed in order of their TaskPriority, so e.g. radio servicing
+ * runs before bulk SD card writes. With a pass budget (see SetPassBudget), non-critical tasks
+ * yield to the next pass once the budget of the current pass is used up.
+ *
  */
 class CooperativeScheduler
 {
  public:
   /**
-   * @brief Initializes the scheduler and starts both the main task and the automatic garbage
-   * collection.
+   * @brief Initializes the scheduler and starts the main task.
    *
    * @param mainTask Main application task to be executed.
    * @param mainInterval Interval in with the main task shall be executed.
+   * @param clock Source of the time (and means to sleep) - if not provided, the system clock is
+   * used. Note that the TaskScheduler engine always uses the system time for task execution.
    */
-  CooperativeScheduler(const TaskCallback& mainTask, const TaskDuration mainInterval);
+  CooperativeScheduler(TaskFunction mainTask, const TaskDuration mainInterval,
+                       Time::Clock* clock = nullptr);
   /**
    * @brief Properly cleans up everything before shutting down.
    */
@@ -81,27 +172,34 @@ class CooperativeScheduler
   /**
    * @brief Adds a one shot task to be executed after the given delay.
    *
-   * The resources of the task will automatically be freed by the garbage collection after it
-   * finished.
+   * The resources of the task will automatically be freed after it finished.
    *
    * @param delay Time after which the task shall be executed.
    * @param task Callback to be executed.
-   * @param timeout Timeout after which task execution shall be aborted.
-   * @return TaskId Id of the created task - INVALID_TASKID if the task could not be created.
+   * @param timeout Timeout after which task execution shall be aborted (only used for profiling as
+   * running callbacks cannot be interrupted).
+   * @param priority Priority class of the task.
+   * @return TaskId Id of the created task - INVALID_TASKID if the task could not be created (e.g.
+   * if the task pool is exhausted or the callback is empty).
    */
-  TaskId AddOneShotTask(const TaskDuration delay, const TaskCallback& task,
-                        const TaskDuration timeout = DEFAULT_TIMEOUT);
+  TaskId AddOneShotTask(const TaskDuration delay, TaskFunction task,
+                        const TaskDuration timeout = DEFAULT_TIMEOUT,
+                        const TaskPriority priority = TaskPriority::NORMAL);
 
   /**
    * @brief Adds a cyclic task reoccurring in the given interval.
    *
    * @param interval Time between each execution of the task.
    * @param task Callback to be executed.
-   * @param timeout Timeout after which task execution shall be aborted.
-   * @return TaskId Id of the created task - INVALID_TASKID if the task could not be created.
+   * @param timeout Timeout after which task execution shall be aborted (only used for profiling as
+   * running callbacks cannot be interrupted).
+   * @param priority Priority class of the task.
+   * @return TaskId Id of the created task - INVALID_TASKID if the task could not be created (e.g.
+   * if the task pool is exhausted or the callback is empty).
    */
-  TaskId AddCyclicTask(const TaskDuration interval, const TaskCallback& task,
-                       const TaskDuration timeout = DEFAULT_TIMEOUT);
+  TaskId AddCyclicTask(const TaskDuration interval, TaskFunction task,
+                       const TaskDuration timeout = DEFAULT_TIMEOUT,
+                       const TaskPriority priority = TaskPriority::NORMAL);
 
   /**
    * @brief Result of a single scheduler execution cycle.
@@ -116,14 +214,47 @@ class CooperativeScheduler
   /**
    * @brief Runs the scheduler for one execution cycle.
    *
+   * If no task was executed and an idle policy is set, the policy is invoked afterwards.
+   *
    * @return ExecutionResult Result of the execution cycle.
    */
   ExecutionResult ExecuteNext();
 
+  /**
+   * @brief Provides the time until the next task is due.
+   *
+   * @return Time until the next execution of any task - 0 if a task is already due (or a TaskEvent
+   * was signaled), NO_TASK_PENDING if no task is scheduled at all.
+   */
+  TaskDuration TimeUntilNextTask() const;
+
+  /**
+   * @brief Sets the strategy for idle passes (e.g. a TicklessIdlePolicy).
+   *
+   * Replaces the 1 ms powerdowns of the TaskScheduler engine.
+   *
+   * @param policy Policy to be invoked after idle passes - nullptr to reset to the default.
+   */
+  void SetIdlePolicy(IdlePolicy* policy);
+
+  /**
+   * @brief Limits the time spent per pass on tasks which are not CRITICAL.
+   *
+   * Once the budget is used up, due NORMAL and BACKGROUND tasks are deferred to the next pass
+   * (keeping their order), so the loop gets back to latency-critical work quickly. A task already
+   * started is never interrupted, and CRITICAL tasks always run. Deferring a cyclic task does not
+   * shift its cadence: the following iterations stay due at their original times, and an iteration
+   * due while the previous one is still deferred is skipped.
+   *
+   * @param budget Budget per pass in microseconds - NO_PASS_BUDGET to execute all due tasks.
+   */
+  void SetPassBudget(const uint32_t budget);
+
   /**
    * @brief Abort the given task.
    *
-   * The resources of the task will automatically be freed by the garbage collection.
+   * The resources of the task will be freed immediately (or after the current pass if aborted from
+   * within a task).
    *
    * @param id Identifies the task to be aborted.
    * @return true if the task was found and aborted, false otherwise.
@@ -131,11 +262,10 @@ class CooperativeScheduler
   bool AbortTask(const TaskId id);
 
   /**
-   * @brief Aborts all currently active tasks (including the main task and garbage collection)
+   * @brief Aborts all currently active tasks (including the main task)
    *
-   * @note While this also aborts the main task and garbage collection, they will never be removed
-   * from the scheduler during its lifetime so that they can be restarted by running RestartMainTask
-   * or RestartAllTasks.
+   * @note While this aborts all tasks, they will not be removed from the scheduler so that they can
+   * be restarted by running RestartMainTask or RestartAllTasks.
    */
   void AbortAllTasks();
 
@@ -147,19 +277,64 @@ class CooperativeScheduler
   /**
    * @brief Restarts the tasks that were running before AbortAllTasks was called.
    *
-   * @note Only meant to be called after AbortAllTasks. Otherwise, funny behavior might follow e.g.
-   * if single tasks have been aborted but not yet collected by garbage collection.
+   * @note Only meant to be called after AbortAllTasks.
    *
    */
   void RestartAllTasks();
 
+  /**
+   * @brief Usage statistics of the task pool.
+   */
+  struct PoolStatistics
+  {
+    uint16_t capacity;       //!< Maximum number of tasks alive at the same time.
+    uint16_t used;           //!< Number of tasks currently alive.
+    uint16_t highWaterMark;  //!< Maximum number of tasks that were alive at the same time.
+    uint16_t bytesPerTask;   //!< Memory reserved per task (including its callback storage).
+  };
+
+  /**
+   * @brief Provides the usage statistics of the task pool (e.g. to size MAX_TASKS).
+   *
+   * @return Current statistics.
+   */
+  PoolStatistics GetPoolStatistics() const;
+
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  /**
+   * @brief Execution statistics of a task at the time of the snapshot.
+   */
+  struct TaskProfileSnapshot
+  {
+    TaskId id;            //!< Id of the task (INVALID_TASKID for the main task).
+    TaskProfile profile;  //!< Statistics of the task.
+  };
+
+  /**
+   * @brief Copies the execution statistics of the main task and all alive tasks.
+   *
+   * @param snapshots Buffer to copy the statistics to (main task first).
+   * @param maxSnapshots Size of the buffer (MAX_TASKS + 1 to capture all tasks).
+   * @return Number of snapshots written to the buffer.
+   */
+  uint16_t GetTaskProfiles(TaskProfileSnapshot* snapshots, const uint16_t maxSnapshots) const;
+
+  /**
+   * @brief Resets the execution statistics of all tasks (e.g. after a warm-up phase).
+   */
+  void ResetTaskProfiles();
+#endif
+
  private:
-  std::unique_ptr<Scheduler> mScheduler;           //!< Actual scheduler
-  std::map<TaskId, std::unique_ptr<Task>> mTasks;  //!< Persistence for active tasks.
-  std::vector<TaskId> mDisabledTasks;  //!< List of diabled tasks queued for garbage collection.
+  Time::Clock& mClock;      //!< Source of the time.
+  IdlePolicy* mIdlePolicy;  //!< Strategy for idle passes (nullptr for the default behavior).
+  uint32_t mPassBudget;     //!< Microseconds per pass for non-critical tasks.
+  uint32_t mPassStart;      //!< Start of the current pass in microseconds.
+
+  static constexpr uint8_t NUM_PRIORITIES{3};  //!< Number of TaskPriority classes.
 
-  Task mMainTask;               //!< Main application task.
-  Task mGarbageCollectionTask;  //!< Garbage collection.
+  std::atomic<TaskEvent*> mSignaledEvents;  //!< Lock-free stack of signaled events.
+  TaskEvent* mReadyEvents;                  //!< Signaled events in order (only used by the loop).
 
   /**
    * @brief Types of tasks currently supported.
@@ -170,27 +345,209 @@ class CooperativeScheduler
     CYCLIC = TASK_FOREVER  //!< Continuously running task.
   };
 
+#ifdef ESP32MODULES_SCHEDULER_TIMING_WHEEL
+  /**
+   * @brief Task as managed by the timing wheel engine.
+   */
+  struct TaskEntry : public TimingWheel::Timer
+  {
+    TaskEntry(const TaskId taskId, const TaskType taskType, const TaskPriority taskPriority,
+              const TaskDuration taskInterval, TaskFunction cb)
+        : id{taskId},
+          type{taskType},
+          priority{taskPriority},
+          interval{taskInterval},
+          callback{std::move(cb)}
+    {
+    }
+
+    TaskId id;                      //!< Id of the task (INVALID_TASKID for the main task).
+    TaskType type;                  //!< One shot or cyclic.
+    TaskPriority priority;          //!< Priority class of the task.
+    TaskDuration interval;          //!< Delay or interval of the task.
+    TaskFunction callback;          //!< Actual callback to be executed.
+    TaskEntry* nextReady{nullptr};  //!< Next task of the ready list.
+    bool enabled{true};             //!< Cleared by AbortAllTasks, set by the restart functions.
+    bool aborted{false};            //!< Set if the task was aborted while due or being executed.
+    bool ready{false};              //!< Indicates whether the task is due (in a ready list).
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    TaskProfile profile;  //!< Execution statistics.
+#endif
+  };
+
+  TimingWheel mWheel;                     //!< Orders the tasks by their next execution.
+  TaskPool<TaskEntry, MAX_TASKS> mTasks;  //!< Persistence for tasks.
+  TaskEntry mMainTask;                    //!< Main application task.
+  TaskEntry* mCurrentTask;                //!< Task currently being executed (nullptr if none).
+  TaskEntry* mReadyHead[NUM_PRIORITIES];  //!< Due tasks per priority (earliest due time first).
+  TaskEntry* mReadyTail[NUM_PRIORITIES];  //!< Last due task per priority.
+#else
+  /**
+   * @brief Task as managed by the TaskScheduler engine.
+   */
+  struct TaskEntry
+  {
+    TaskEntry(const TaskPriority taskPriority, TaskFunction cb)
+        : task{}, id{INVALID_TASKID}, priority{taskPriority}, callback{std::move(cb)}
+    {
+    }
+
+    Task task;              //!< Task known to the TaskScheduler.
+    TaskId id;              //!< Id of the task within the pool.
+    TaskPriority priority;  //!< Priority class (selects the scheduler of the task).
+    TaskFunction callback;  //!< Actual callback to be executed (invoked by the task).
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    TaskProfile profile;  //!< Execution statistics.
+#endif
+  };
+
+  //! Actual schedulers (one per priority class, executed in order of priority on each pass)
+  std::array<std::unique_ptr<Scheduler>, NUM_PRIORITIES> mSchedulers;
+  TaskPool<TaskEntry, MAX_TASKS> mTasks;  //!< Persistence for active tasks.
+  TaskFunction mMainCallback;             //!< Callback of the main application task.
+  Task mMainTask;                         //!< Main application task.
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  TaskProfile mMainProfile;  //!< Execution statistics of the main task.
+#endif
+
+  bool mIsExecuting;         //!< Indicates whether the scheduler is in the middle of a pass.
+  bool mIsAbortingAllTasks;  //!< Indicates whether AbortAllTasks is disabling the tasks.
+  std::array<TaskId, MAX_TASKS> mFinishedTasks;  //!< Tasks finished during the current pass.
+  uint16_t mNumFinishedTasks;                    //!< Number of valid entries in mFinishedTasks.
+
+  /**
+   * @brief Cyclic task whose execution was deferred by the pass budget.
+   */
+  struct DeferredTask
+  {
+    TaskId id;              //!< Id of the task (INVALID_TASKID for the main task).
+    TaskPriority priority;  //!< Priority class of the task.
+    uint32_t deferredAt;    //!< Time of the deferral in milliseconds.
+  };
+
+  //! Deferred cyclic tasks in order of their deferral (each task at most once)
+  std::array<DeferredTask, MAX_TASKS + 1> mDeferredTasks;
+  uint16_t mNumDeferredTasks;  //!< Number of valid entries in mDeferredTasks.
+#endif
+
   /**
    * @brief Adds any of the supported tasks to the scheduler queue.
    *
    * @param type Type of task to be added.
    * @param timespan Time after which the one and only or the next execution shall happen.
    * @param timeout Timeout after which task execution shall be aborted.
+   * @param priority Priority class of the task.
    * @param task Actual callback to be executed.
    * @return TaskId Id of the created task - INVALID_TASKID if the task could not be created.
    */
   TaskId AddTask(const TaskType type, const TaskDuration timespan, const TaskDuration timeout,
-                 const TaskCallback& task);
+                 const TaskPriority priority, TaskFunction task);
+
+  /**
+   * @brief Checks whether a task of the given class may still be started within this pass.
+   *
+   * @param priority Priority class of the task.
+   * @return true if the task may be executed, false if it shall be deferred to the next pass.
+   */
+  bool IsWithinPassBudget(const TaskPriority priority) const;
+
+  /**
+   * @brief Adds the event to the ready queue (lock-free, called by TaskEvent::Signal).
+   *
+   * @param event Signaled event.
+   */
+  void EnqueueEvent(TaskEvent& event);
+
+  /**
+   * @brief Removes a signaled event from the ready queue (called when destroying the event).
+   *
+   * @param event Event to be removed.
+   */
+  void WithdrawEvent(TaskEvent& event);
+
+  /** @brief Appends the events signaled since the last call to the ready events (in order). */
+  void CollectSignaledEvents();
+
+  /**
+   * @brief Executes the tasks of all events signaled before the current pass.
+   *
+   * @return Number of executed tasks.
+   */
+  uint16_t DispatchEvents();
+
+  /** @brief Indicates whether any event is waiting for the execution of its task. */
+  bool HasPendingEvents() const;
+
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  /**
+   * @brief Executes the callback of a task and records its statistics.
+   *
+   * @param callback Callback to be executed.
+   * @param profile Statistics of the task.
+   * @param startLatency Milliseconds the execution started after it was due.
+   */
+  void RunProfiled(TaskFunction& callback, TaskProfile& profile, const uint32_t startLatency);
+#endif
 
+#ifdef ESP32MODULES_SCHEDULER_TIMING_WHEEL
   /**
-   * @brief Marks the task as disabled so that garbage collection can pick it up.
+   * @brief Adds an expired task to the ready list of its priority class (ordered by due time).
+   *
+   * @param entry Expired task.
+   */
+  void MakeReady(TaskEntry& entry);
+
+  /**
+   * @brief Executes the task and reschedules or frees it afterwards.
+   *
+   * @param entry Expired task to be executed.
    */
-  void MarkTaskAsDisabled();
+  void Dispatch(TaskEntry& entry);
 
   /**
-   * @brief Removes any tasks marked as disabled (except the main task and the garbage collection).
+   * @brief Frees the resources of the given (unscheduled) task.
+   *
+   * @param entry Task to be freed.
    */
-  void RemoveDisabledTasks();
+  void Release(TaskEntry& entry);
+#else
+  /**
+   * @brief Defers the task to the next pass if the pass budget is used up.
+   *
+   * One shot tasks are retried by the TaskScheduler. The callbacks of cyclic tasks are run by
+   * RunDeferredTasks() instead, so the TaskScheduler keeps the phase of their next iterations.
+   *
+   * @param task Task currently invoked by the TaskScheduler.
+   * @param id Id of the task (INVALID_TASKID for the main task).
+   * @param priority Priority class of the task.
+   * @return true if the task was deferred (i.e. its callback must not run), false otherwise.
+   */
+  bool DeferIfOverBudget(Task& task, const TaskId id, const TaskPriority priority);
+
+  /**
+   * @brief Executes the deferred cyclic tasks of the given class as far as the budget allows.
+   *
+   * @param priority Priority class of the tasks.
+   * @return Number of executed tasks.
+   */
+  uint16_t RunDeferredTasks(const TaskPriority priority);
+
+  /**
+   * @brief Recycles the task as soon as possible (i.e. immediately or after the current pass).
+   *
+   * @param id Id of the finished or aborted task.
+   */
+  void MarkTaskAsFinished(const TaskId id);
+
+  /**
+   * @brief Removes the task from the scheduler and releases its slot.
+   *
+   * @param id Id of the task to be released.
+   */
+  void Release(const TaskId id);
+#endif
+
+  friend class TaskEvent;
 };
 }  // namespace Esp32Modules::Core::Scheduling
 
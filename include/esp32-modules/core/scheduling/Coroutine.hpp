@@ -0,0 +1,256 @@
+/**
+ * @file Coroutine.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides coroutine tasks driven by the CooperativeScheduler.
+ * @version 0.1
+ * @date 2021-08-14
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_COROUTINE_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_COROUTINE_HPP_
+
+// Coroutines require C++20 (e.g. -std=gnu++2a -fcoroutines with GCC 10). With older toolchains,
+// this header provides nothing and the callback API of the CooperativeScheduler remains the only
+// way of defining tasks.
+#if defined(__cpp_impl_coroutine) and __has_include(<coroutine>)
+#define ESP32MODULES_SCHEDULER_COROUTINES
+#endif
+
+#ifdef ESP32MODULES_SCHEDULER_COROUTINES
+
+// Standard header
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+// Project header
+#include <esp32-modules/core/scheduling/CooperativeScheduler.hpp>
+
+// Maximum number of coroutines alive at the same time.
+#ifndef ESP32MODULES_COROUTINE_MAX_FRAMES
+#define ESP32MODULES_COROUTINE_MAX_FRAMES 8
+#endif
+
+// Size of each coroutine frame in bytes (locals kept across suspension points, parameters and
+// bookkeeping of the compiler). Coroutines with larger frames fail to start.
+#ifndef ESP32MODULES_COROUTINE_FRAME_SIZE
+#define ESP32MODULES_COROUTINE_FRAME_SIZE 256
+#endif
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Fixed pool the frames of all coroutines are taken from (no heap allocations).
+ *
+ * @note Not thread-safe, coroutines must only be created within the cooperative loop.
+ */
+class CoroutineFramePool
+{
+ public:
+  /**
+   * @brief Usage statistics of the frame pool.
+   */
+  struct Statistics
+  {
+    uint16_t capacity;       //!< Maximum number of frames alive at the same time.
+    uint16_t used;           //!< Number of frames currently alive.
+    uint16_t highWaterMark;  //!< Maximum number of frames that were alive at the same time.
+    uint32_t failures;       //!< Number of coroutines that could not be created.
+  };
+
+  /**
+   * @brief Takes a frame from the pool.
+   *
+   * @param size Size of the frame requested by the compiler.
+   * @return Frame - nullptr if the pool is exhausted or the frame is too large.
+   */
+  static void* Allocate(const size_t size) noexcept;
+
+  /**
+   * @brief Returns a frame to the pool.
+   *
+   * @param frame Frame taken from the pool.
+   */
+  static void Deallocate(void* frame) noexcept;
+
+  /**
+   * @brief Provides the usage statistics (e.g. to size ESP32MODULES_COROUTINE_MAX_FRAMES).
+   *
+   * @return Current statistics.
+   */
+  static Statistics GetStatistics() noexcept;
+};
+
+/**
+ * @brief Coroutine run by the CooperativeScheduler.
+ *
+ * Multi-step sequences can be written as a single function suspending itself instead of chaining
+ * one shot tasks, e.g.
+ *
+ *   CoTask SendRadioMessage()
+ *   {
+ *     radio.On();
+ *     co_await Delay(200 * TASK_MILLISECOND);
+ *     radio.Send(message);
+ *     co_await ackReceived;  // CoEvent set by the receiver
+ *     radio.Off();
+ *   }
+ *
+ *   Spawn(scheduler, SendRadioMessage());
+ *
+ * The coroutine runs until its first suspension point on the next pass after spawning. Each
+ * resumption is a one shot task of the scheduler, so coroutines interleave with all other tasks.
+ * The frame is returned to the CoroutineFramePool once the coroutine finished.
+ *
+ * @note Coroutines must run to completion. Frames of coroutines waiting while their scheduler is
+ * destroyed (or their resumption is aborted) are not returned to the pool.
+ */
+class CoTask
+{
+ public:
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /** @brief Promise as required by the compiler. */
+  struct promise_type
+  {
+    CooperativeScheduler* scheduler{nullptr};     //!< Scheduler resuming the coroutine.
+    TaskPriority priority{TaskPriority::NORMAL};  //!< Priority of the resumptions.
+
+    CoTask get_return_object() noexcept { return CoTask{Handle::from_promise(*this)}; }
+    static CoTask get_return_object_on_allocation_failure() noexcept { return CoTask{}; }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept;
+
+    static void* operator new(const size_t size) noexcept
+    {
+      return CoroutineFramePool::Allocate(size);
+    }
+    static void operator delete(void* frame) noexcept { CoroutineFramePool::Deallocate(frame); }
+  };
+
+  /** @brief Creates an invalid coroutine. */
+  CoTask() noexcept : mHandle{} {}
+  CoTask(CoTask&& other) noexcept : mHandle{other.mHandle} { other.mHandle = {}; }
+  CoTask& operator=(CoTask&& other) noexcept;
+  CoTask(const CoTask&) = delete;
+  CoTask& operator=(const CoTask&) = delete;
+
+  /** @brief Destroys the coroutine if it was never spawned. */
+  ~CoTask();
+
+  /** @brief Indicates whether the coroutine was created (i.e. its frame could be allocated). */
+  explicit operator bool() const noexcept { return static_cast<bool>(mHandle); }
+
+ private:
+  explicit CoTask(Handle handle) noexcept : mHandle{handle} {}
+
+  Handle mHandle;  //!< Frame of the coroutine (owned until spawned).
+
+  friend bool Spawn(CooperativeScheduler& scheduler, CoTask task, const TaskPriority priority);
+};
+
+/**
+ * @brief Hands the coroutine over to the scheduler, which starts it on the next pass.
+ *
+ * @param scheduler Scheduler resuming the coroutine.
+ * @param task Coroutine to be run.
+ * @param priority Priority class of all resumptions of the coroutine.
+ * @return true if the coroutine was started, false if it is invalid or could not be scheduled
+ * (the coroutine is destroyed then).
+ */
+bool Spawn(CooperativeScheduler& scheduler, CoTask task,
+           const TaskPriority priority = TaskPriority::NORMAL);
+
+/**
+ * @brief Awaitable resuming the coroutine after a delay.
+ *
+ * co_await yields true if the coroutine waited as requested, false if the resumption could not
+ * be scheduled (e.g. the task pool is exhausted) and the coroutine continued right away.
+ */
+class DelayAwaiter
+{
+ public:
+  explicit DelayAwaiter(const TaskDuration delay) noexcept : mDelay{delay}, mScheduled{false} {}
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(CoTask::Handle handle) noexcept;
+  bool await_resume() const noexcept { return mScheduled; }
+
+ private:
+  TaskDuration mDelay;  //!< Time to wait.
+  bool mScheduled;      //!< Indicates whether the resumption was scheduled.
+};
+
+/**
+ * @brief Suspends the coroutine for the given time.
+ *
+ * @param delay Time to wait.
+ * @return Awaitable.
+ */
+inline DelayAwaiter Delay(const TaskDuration delay) noexcept { return DelayAwaiter{delay}; }
+
+/**
+ * @brief Suspends the coroutine until the next pass of the scheduler.
+ *
+ * @return Awaitable.
+ */
+inline DelayAwaiter NextTick() noexcept { return DelayAwaiter{0}; }
+
+/**
+ * @brief Event coroutines can wait for.
+ *
+ * Once set, all waiting coroutines are resumed (on the next pass) and further co_awaits do not
+ * suspend until the event is reset.
+ *
+ * @note Must only be used within the cooperative loop (e.g. not from interrupts).
+ */
+class CoEvent
+{
+ public:
+  CoEvent() noexcept : mIsSet{false}, mWaiters{nullptr} {}
+  CoEvent(const CoEvent&) = delete;
+  CoEvent& operator=(const CoEvent&) = delete;
+
+  /** @brief Sets the event and resumes all waiting coroutines. */
+  void Set() noexcept;
+
+  /** @brief Resets the event, so that following co_awaits suspend again. */
+  void Reset() noexcept { mIsSet = false; }
+
+  /** @brief Indicates whether the event is set. */
+  bool IsSet() const noexcept { return mIsSet; }
+
+  /** @brief Awaitable returned by co_await on the event. */
+  class Awaiter
+  {
+   public:
+    explicit Awaiter(CoEvent& event) noexcept : mEvent{event}, mHandle{}, mNext{nullptr} {}
+
+    bool await_ready() const noexcept { return mEvent.mIsSet; }
+    void await_suspend(CoTask::Handle handle) noexcept;
+    void await_resume() const noexcept {}
+
+   private:
+    CoEvent& mEvent;         //!< Event waited for.
+    CoTask::Handle mHandle;  //!< Waiting coroutine.
+    Awaiter* mNext;          //!< Next waiter of the event.
+
+    friend class CoEvent;
+  };
+
+  Awaiter operator co_await() noexcept { return Awaiter{*this}; }
+
+ private:
+  bool mIsSet;        //!< Indicates whether the event is set.
+  Awaiter* mWaiters;  //!< Waiting coroutines (most recent first, the awaiters live in the frames).
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES_SCHEDULER_COROUTINES
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_COROUTINE_HPP_
@@ -0,0 +1,69 @@
+/**
+ * @file IdlePolicy.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides strategies for what the CooperativeScheduler does between due tasks.
+ * @version 0.1
+ * @date 2021-07-24
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_IDLEPOLICY_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_IDLEPOLICY_HPP_
+
+// Project header
+#include <esp32-modules/core/scheduling/CooperativeScheduler.hpp>
+#include <esp32-modules/core/time/Clock.hpp>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Strategy invoked by the CooperativeScheduler after a pass without any due tasks.
+ */
+class IdlePolicy
+{
+ public:
+  virtual ~IdlePolicy() = default;
+
+  /**
+   * @brief Called after an idle pass of the scheduler.
+   *
+   * @param timeUntilNextTask Time until the next task is due (NO_TASK_PENDING if there is none).
+   */
+  virtual void OnIdle(const TaskDuration timeUntilNextTask) = 0;
+};
+
+/**
+ * @brief Sleeps exactly until the next task is due instead of waking up periodically.
+ *
+ * Gaps up to the deep sleep threshold are spent in light sleep, so the application continues as if
+ * it was busy waiting. Longer gaps are spent in deep sleep which essentially reboots the device
+ * once the next task is due (use this for battery nodes only doing periodic work).
+ */
+class TicklessIdlePolicy : public IdlePolicy
+{
+ public:
+  /** Threshold disabling the fallback to deep sleep. */
+  static constexpr TaskDuration NEVER_DEEP_SLEEP{NO_TASK_PENDING};
+
+  /**
+   * @brief Sets up the policy.
+   *
+   * @param clock Clock used for sleeping.
+   * @param deepSleepThreshold Gaps of at least this duration are spent in deep sleep.
+   * @param minSleep Gaps shorter than this are not worth to sleep (busy loop instead).
+   */
+  TicklessIdlePolicy(Time::Clock& clock, const TaskDuration deepSleepThreshold = NEVER_DEEP_SLEEP,
+                     const TaskDuration minSleep = 1 * TASK_MILLISECOND);
+  ~TicklessIdlePolicy() = default;
+
+  void OnIdle(const TaskDuration timeUntilNextTask) override;
+
+ private:
+  Time::Clock& mClock;
+  const TaskDuration mDeepSleepThreshold;
+  const TaskDuration mMinSleep;
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_IDLEPOLICY_HPP_
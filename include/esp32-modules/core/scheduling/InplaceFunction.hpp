@@ -0,0 +1,142 @@
+/**
+ * @file InplaceFunction.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a move-only callable wrapper storing its target without heap allocations.
+ * @version 0.1
+ * @date 2021-07-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_INPLACEFUNCTION_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_INPLACEFUNCTION_HPP_
+
+// Standard header
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Esp32Modules::Core::Scheduling
+{
+template <typename Signature, size_t Capacity>
+class InplaceFunction;
+
+/**
+ * @brief Move-only replacement for std::function with a fixed-size inline storage.
+ *
+ * The callable (e.g. a lambda including its captures) is always stored within the object itself,
+ * so creating, moving and destroying an InplaceFunction never allocates memory. Callables larger
+ * than @p Capacity are rejected at compile time.
+ *
+ * @tparam R Return type of the callable.
+ * @tparam Args Argument types of the callable.
+ * @tparam Capacity Size of the inline storage in bytes.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+ public:
+  /** @brief Creates an empty function. */
+  InplaceFunction() noexcept : mStorage{}, mOps{nullptr} {}
+
+  /** @brief Creates an empty function. */
+  InplaceFunction(std::nullptr_t) noexcept : InplaceFunction{} {}
+
+  /**
+   * @brief Stores the given callable in place.
+   *
+   * @param callable Callable (e.g. lambda, functor or function pointer) to be stored.
+   */
+  template <typename F, typename Fn = std::decay_t<F>,
+            typename = std::enable_if_t<not std::is_same<Fn, InplaceFunction>::value>>
+  InplaceFunction(F&& callable) : mStorage{}, mOps{&OPERATIONS<Fn>}
+  {
+    static_assert(sizeof(Fn) <= Capacity,
+                  "Callable does not fit into the inline storage (reduce the captures or increase "
+                  "the capacity).");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over-aligned.");
+    static_assert(std::is_nothrow_move_constructible<Fn>::value,
+                  "Callable must be nothrow move constructible.");
+    new (mStorage) Fn(std::forward<F>(callable));
+  }
+
+  InplaceFunction(InplaceFunction&& other) noexcept : mStorage{}, mOps{other.mOps}
+  {
+    if (mOps)
+    {
+      mOps->move(mStorage, other.mStorage);
+      other.Reset();
+    }
+  }
+
+  InplaceFunction& operator=(InplaceFunction&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Reset();
+      if (other.mOps)
+      {
+        mOps = other.mOps;
+        mOps->move(mStorage, other.mStorage);
+        other.Reset();
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(std::nullptr_t) noexcept
+  {
+    Reset();
+    return *this;
+  }
+
+  InplaceFunction(const InplaceFunction&) = delete;
+  InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+  ~InplaceFunction() { Reset(); }
+
+  /**
+   * @brief Invokes the stored callable.
+   *
+   * @note Must not be called on an empty function.
+   */
+  R operator()(Args... args) { return mOps->invoke(mStorage, std::forward<Args>(args)...); }
+
+  /** @brief Indicates whether a callable is stored. */
+  explicit operator bool() const noexcept { return (mOps != nullptr); }
+
+ private:
+  /** Type-erased operations on the stored callable. */
+  struct Operations
+  {
+    R (*invoke)(void* storage, Args&&... args);
+    void (*move)(void* destination, void* source);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Fn>
+  static constexpr Operations OPERATIONS{
+      [](void* storage, Args&&... args) -> R {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+      },
+      [](void* destination, void* source) {
+        new (destination) Fn(std::move(*static_cast<Fn*>(source)));
+      },
+      [](void* storage) { static_cast<Fn*>(storage)->~Fn(); }};
+
+  alignas(std::max_align_t) unsigned char mStorage[Capacity];  //!< Inline storage of the callable.
+  const Operations* mOps;  //!< Operations of the stored callable (nullptr if empty).
+
+  void Reset() noexcept
+  {
+    if (mOps)
+    {
+      mOps->destroy(mStorage);
+      mOps = nullptr;
+    }
+  }
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_INPLACEFUNCTION_HPP_
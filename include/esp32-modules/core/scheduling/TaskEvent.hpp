@@ -0,0 +1,106 @@
+/**
+ * @file TaskEvent.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides events waking up tasks of the cooperative scheduler as soon as they are signaled.
+ * @version 0.1
+ * @date 2021-08-21
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_TASKEVENT_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_TASKEVENT_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstdint>
+
+// Project header
+#include <esp32-modules/core/scheduling/CooperativeScheduler.hpp>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Task executed by the CooperativeScheduler whenever the event was signaled.
+ *
+ * Replaces cyclic tasks which only poll a flag: interrupts or other threads (e.g. the BLE stack)
+ * signal the event, which puts it into a lock-free ready queue of the scheduler. The task is
+ * executed at the beginning of the next pass, before any timed tasks. Signals arriving before the
+ * task was executed are coalesced into a single execution.
+ *
+ * @note An idle policy sleeping until the next timed task (e.g. TicklessIdlePolicy) delays the
+ * execution until the wake-up, unless the signaling source is configured as a wake-up source.
+ */
+class TaskEvent
+{
+ public:
+  /**
+   * @brief Creates the event.
+   *
+   * @param scheduler Scheduler executing the task.
+   * @param task Callback to be executed after the event was signaled.
+   */
+  TaskEvent(CooperativeScheduler& scheduler, TaskFunction task);
+
+  /**
+   * @brief Withdraws a pending signal.
+   *
+   * @note Must be called from within the cooperative loop, and the event must not be signaled
+   * concurrently anymore.
+   */
+  ~TaskEvent();
+
+  TaskEvent(const TaskEvent&) = delete;
+  TaskEvent& operator=(const TaskEvent&) = delete;
+
+  /**
+   * @brief Signals the event, i.e. requests the execution of the task.
+   *
+   * @note Lock-free, may be called from interrupts and any thread. Placed in IRAM, so it may also
+   * be called while the flash cache is disabled (i.e. from interrupts registered with
+   * ESP_INTR_FLAG_IRAM). With ESP32MODULES_SCHEDULER_PROFILING, signal times are taken from the
+   * high resolution timer instead of the clock of the scheduler.
+   */
+  void Signal();
+
+  /** @brief Indicates whether the event was signaled but the task not yet executed. */
+  bool IsPending() const { return mPending.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Statistics of the event.
+   */
+  struct Statistics
+  {
+    uint32_t signals;     //!< Number of signals (including coalesced ones).
+    uint32_t executions;  //!< Number of executions of the task.
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    uint32_t maxLatency;    //!< Longest time from signal to execution in microseconds.
+    uint64_t totalLatency;  //!< Sum of all times from signal to execution in microseconds.
+#endif
+  };
+
+  /**
+   * @brief Provides the statistics of the event.
+   *
+   * @return Current statistics.
+   */
+  Statistics GetStatistics() const;
+
+ private:
+  CooperativeScheduler& mScheduler;  //!< Scheduler executing the task.
+  TaskFunction mTask;                //!< Callback to be executed.
+  std::atomic<bool> mPending;        //!< Set while the event is in the ready queue.
+  std::atomic<uint32_t> mSignals;    //!< Number of signals.
+  uint32_t mExecutions;              //!< Number of executions.
+  TaskEvent* mNext;                  //!< Next event of the ready queue.
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  std::atomic<uint32_t> mSignalTime;  //!< Microseconds of the first signal since the execution.
+  uint32_t mMaxLatency;               //!< Longest time from signal to execution.
+  uint64_t mTotalLatency;             //!< Sum of all times from signal to execution.
+#endif
+
+  friend class CooperativeScheduler;
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_TASKEVENT_HPP_
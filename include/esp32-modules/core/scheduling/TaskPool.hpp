@@ -0,0 +1,211 @@
+/**
+ * @file TaskPool.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a fixed-capacity object pool addressed by generation-tagged ids.
+ * @version 0.1
+ * @date 2021-07-10
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_TASKPOOL_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_TASKPOOL_HPP_
+
+// Standard header
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Fixed-capacity pool constructing its objects in place (no heap allocations).
+ *
+ * Objects are addressed by ids combining the index of their slot (lower 16 bits) with a generation
+ * counter of the slot (upper 16 bits). The generation is bumped whenever a slot is released, so
+ * stale ids of already released objects never address a newer object in the same slot. Released
+ * slots are immediately available again.
+ *
+ * @note Not thread-safe.
+ *
+ * @tparam T Type of the pooled objects.
+ * @tparam Capacity Maximum number of objects alive at the same time.
+ */
+template <typename T, uint16_t Capacity>
+class TaskPool
+{
+  static_assert(Capacity > 0 and Capacity < 0xFFFF, "Capacity must fit the 16 bit slot index.");
+
+ public:
+  /** Type of the generation-tagged ids. */
+  using Id = uint32_t;
+  /** Id never handed out by the pool. */
+  static constexpr Id INVALID_ID{0};
+
+  TaskPool() : mSlots{}, mFreeHead{0}, mSize{0}, mHighWaterMark{0}
+  {
+    for (uint16_t i = 0; i < Capacity; ++i)
+    {
+      mSlots[i].generation = 1;
+      mSlots[i].nextFree = i + 1;
+    }
+  }
+
+  /**
+   * @brief Destroys all objects still alive.
+   */
+  ~TaskPool()
+  {
+    ForEach([this](const Id id, T&) { Release(id); });
+  }
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  /**
+   * @brief Constructs a new object in a free slot.
+   *
+   * @param args Arguments forwarded to the constructor of the object.
+   * @return Id of the created object - INVALID_ID if the pool is exhausted.
+   */
+  template <typename... Args>
+  Id Emplace(Args&&... args)
+  {
+    if (mFreeHead == Capacity)
+    {
+      return INVALID_ID;
+    }
+    const uint16_t index = mFreeHead;
+    auto& slot = mSlots[index];
+    new (slot.storage) T(std::forward<Args>(args)...);
+    mFreeHead = slot.nextFree;
+    slot.used = true;
+    ++mSize;
+    if (mSize > mHighWaterMark)
+    {
+      mHighWaterMark = mSize;
+    }
+    return ToId(slot.generation, index);
+  }
+
+  /**
+   * @brief Looks up the object with the given id.
+   *
+   * @param id Id of the object.
+   * @return Pointer to the object - nullptr if the id is invalid or the object was released.
+   */
+  T* Get(const Id id)
+  {
+    const uint16_t index = static_cast<uint16_t>(id & 0xFFFF);
+    if (index >= Capacity)
+    {
+      return nullptr;
+    }
+    auto& slot = mSlots[index];
+    if (not slot.used or slot.generation != static_cast<uint16_t>(id >> 16))
+    {
+      return nullptr;
+    }
+    return Object(slot);
+  }
+
+  /**
+   * @brief Destroys the object with the given id and makes its slot available again.
+   *
+   * @param id Id of the object.
+   * @return true if the object was found and released, false otherwise.
+   */
+  bool Release(const Id id)
+  {
+    T* object = Get(id);
+    if (not object)
+    {
+      return false;
+    }
+    const uint16_t index = static_cast<uint16_t>(id & 0xFFFF);
+    auto& slot = mSlots[index];
+    object->~T();
+    slot.used = false;
+    // Skip generation 0 so that ids are never INVALID_ID.
+    slot.generation = (slot.generation == 0xFFFF) ? 1 : slot.generation + 1;
+    slot.nextFree = mFreeHead;
+    mFreeHead = index;
+    --mSize;
+    return true;
+  }
+
+  /**
+   * @brief Calls @p fn(id, object) for each object alive (the object may be released in there).
+   */
+  template <typename Function>
+  void ForEach(Function fn)
+  {
+    for (uint16_t i = 0; i < Capacity; ++i)
+    {
+      auto& slot = mSlots[i];
+      if (slot.used)
+      {
+        fn(ToId(slot.generation, i), *Object(slot));
+      }
+    }
+  }
+
+  /**
+   * @brief Calls @p fn(id, object) for each object alive (read-only).
+   */
+  template <typename Function>
+  void ForEach(Function fn) const
+  {
+    for (uint16_t i = 0; i < Capacity; ++i)
+    {
+      const auto& slot = mSlots[i];
+      if (slot.used)
+      {
+        fn(ToId(slot.generation, i), *Object(slot));
+      }
+    }
+  }
+
+  /** @brief Number of objects currently alive. */
+  uint16_t Size() const { return mSize; }
+
+  /** @brief Maximum number of objects that have been alive at the same time. */
+  uint16_t HighWaterMark() const { return mHighWaterMark; }
+
+  /** @brief Maximum number of objects that can be alive at the same time. */
+  static constexpr uint16_t GetCapacity() { return Capacity; }
+
+  /** @brief Memory reserved per object (including the bookkeeping of the pool). */
+  static constexpr size_t GetSlotSize() { return sizeof(Slot); }
+
+ private:
+  /** Storage and bookkeeping of a single object. */
+  struct Slot
+  {
+    alignas(T) unsigned char storage[sizeof(T)];  //!< Raw storage for the object.
+    uint16_t generation;                          //!< Bumped on each release.
+    uint16_t nextFree;                            //!< Next free slot (if this one is free).
+    bool used;                                    //!< Indicates whether an object is alive.
+  };
+
+  Slot mSlots[Capacity];    //!< Storage of all objects.
+  uint16_t mFreeHead;       //!< First free slot (Capacity if there is none).
+  uint16_t mSize;           //!< Number of objects alive.
+  uint16_t mHighWaterMark;  //!< Maximum number of objects alive at the same time.
+
+  static Id ToId(const uint16_t generation, const uint16_t index)
+  {
+    return (static_cast<Id>(generation) << 16) | index;
+  }
+
+  static T* Object(Slot& slot) { return std::launder(reinterpret_cast<T*>(slot.storage)); }
+
+  static const T* Object(const Slot& slot)
+  {
+    return std::launder(reinterpret_cast<const T*>(slot.storage));
+  }
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_TASKPOOL_HPP_
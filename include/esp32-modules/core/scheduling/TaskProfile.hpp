@@ -0,0 +1,54 @@
+/**
+ * @file TaskProfile.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides execution statistics of scheduler tasks.
+ * @version 0.1
+ * @date 2021-07-31
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_TASKPROFILE_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_TASKPROFILE_HPP_
+
+// Standard header
+#include <cstdint>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Execution statistics of a single task.
+ *
+ * The start latency (time between the due time and the actual start of an execution) is recorded
+ * in a histogram with power of two buckets: 0 ms, 1 ms, 2-3 ms, 4-7 ms, ..., >= 64 ms.
+ */
+struct TaskProfile
+{
+  static constexpr uint8_t LATENCY_BUCKETS{8};  //!< Number of buckets of the latency histogram.
+
+  uint32_t timeout{0};                           //!< Timeout of the task in milliseconds.
+  uint32_t runs{0};                              //!< Number of executions.
+  uint32_t overruns{0};                          //!< Executions taking longer than the timeout.
+  uint32_t minExecutionTime{0};                  //!< Shortest execution in microseconds.
+  uint32_t maxExecutionTime{0};                  //!< Longest execution in microseconds.
+  uint64_t totalExecutionTime{0};                //!< Sum of all executions in microseconds.
+  uint16_t latencyHistogram[LATENCY_BUCKETS]{};  //!< Start latencies (saturating counters).
+
+  /**
+   * @brief Adds a single execution to the statistics.
+   *
+   * @param startLatency Milliseconds the execution started after it was due.
+   * @param executionTime Microseconds the execution took.
+   */
+  void Record(const uint32_t startLatency, const uint32_t executionTime);
+
+  /**
+   * @brief Provides the average execution time.
+   *
+   * @return Average execution time in microseconds (0 if the task never ran).
+   */
+  uint32_t AverageExecutionTime() const;
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_TASKPROFILE_HPP_
@@ -0,0 +1,166 @@
+/**
+ * @file TimingWheel.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a hierarchical timing wheel for keeping track of timers by their expiry.
+ * @version 0.1
+ * @date 2021-07-03
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_TIMINGWHEEL_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_TIMINGWHEEL_HPP_
+
+// Standard header
+#include <cstdint>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Hierarchical timing wheel sorting intrusive timers by their (millisecond) expiry.
+ *
+ * The wheel consists of several levels of 64 slots each. A timer is placed on the level of the
+ * highest 6 bit group in which its expiry differs from the current time of the wheel. Whenever the
+ * wheel advances into a slot of a higher level, the timers in there are redistributed to the lower
+ * levels (cascading). Per level, a bitmap keeps track of the occupied slots so that the next slot
+ * of interest can be found without walking through empty slots.
+ *
+ * This makes scheduling and cancelling a timer O(1). Advancing the wheel costs O(1) per expired
+ * timer and is constant if nothing expired at all.
+ *
+ * Expired timers are collected in FIFO order and have to be fetched by calling PopExpired().
+ * Timers with the same expiry expire in the order they were scheduled in.
+ *
+ * @note Expiries have to be less than 2^31 ticks in the future (wrap-arounds are handled).
+ * @note Not thread-safe.
+ */
+class TimingWheel
+{
+ public:
+  /** Type of time values (e.g. milliseconds since boot). */
+  using Tick = uint32_t;
+
+  /**
+   * @brief Intrusive node to be embedded in the objects tracked by the wheel.
+   *
+   * The owner is responsible to keep the timer alive as long as it is scheduled.
+   */
+  class Timer
+  {
+   public:
+    Timer() = default;
+    ~Timer() = default;
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    /** @brief Indicates whether the timer is currently scheduled or expired (but not popped). */
+    bool IsScheduled() const { return (mLevel != UNSCHEDULED); }
+
+    /** @brief Time at which the timer expires (or expired). */
+    Tick Expiry() const { return mExpiry; }
+
+   private:
+    friend class TimingWheel;
+    static constexpr uint8_t UNSCHEDULED{0xFF};
+
+    Timer* mNext{nullptr};
+    Timer* mPrev{nullptr};
+    Tick mExpiry{0};
+    uint8_t mLevel{UNSCHEDULED};
+    uint8_t mSlot{0};
+  };
+
+  /**
+   * @brief Sets up an empty wheel.
+   *
+   * @param now Current time.
+   */
+  explicit TimingWheel(const Tick now);
+  ~TimingWheel() = default;
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /**
+   * @brief Schedules the timer (or reschedules it if already scheduled).
+   *
+   * Timers with an expiry not after the current time of the wheel expire immediately.
+   *
+   * @param timer Timer to be scheduled.
+   * @param expiry Time at which the timer shall expire.
+   */
+  void Schedule(Timer& timer, const Tick expiry);
+
+  /**
+   * @brief Removes the timer from the wheel (no-op if the timer is not scheduled).
+   *
+   * @param timer Timer to be removed.
+   */
+  void Cancel(Timer& timer);
+
+  /**
+   * @brief Advances the wheel to the given time and collects all timers expired until then.
+   *
+   * @param now Current time (must not be before the last time the wheel was advanced to).
+   */
+  void Advance(const Tick now);
+
+  /**
+   * @brief Fetches the next expired timer.
+   *
+   * @return Expired timer (unscheduled from now on) or nullptr if there is none.
+   */
+  Timer* PopExpired();
+
+  /**
+   * @brief Provides the number of expired timers not yet fetched by PopExpired().
+   *
+   * @return Number of expired timers.
+   */
+  uint32_t ExpiredCount() const { return mExpiredCount; }
+
+  /**
+   * @brief Determines the earliest expiry of all scheduled (or expired but not popped) timers.
+   *
+   * Costs O(1) per level plus walking the timers of at most one slot per level.
+   *
+   * @param expiry Earliest expiry (only valid if true is returned).
+   * @return true if any timer is scheduled, false otherwise.
+   */
+  bool NextExpiry(Tick& expiry) const;
+
+  /**
+   * @brief Provides the time the wheel was last advanced to.
+   *
+   * @return Current time of the wheel.
+   */
+  Tick Now() const { return mNow; }
+
+ private:
+  static constexpr uint8_t LEVEL_BITS{6};
+  static constexpr uint8_t SLOTS{1 << LEVEL_BITS};
+  static constexpr uint8_t LEVELS{6};              //!< 6 levels of 6 bits cover 32 bit ticks.
+  static constexpr uint8_t EXPIRED_LEVEL{LEVELS};  //!< Pseudo-level of the expired list.
+
+  Tick mNow;                     //!< Time the wheel was last advanced to.
+  Timer* mSlots[LEVELS][SLOTS];  //!< Heads of the doubly linked timer lists per slot.
+  uint64_t mOccupied[LEVELS];    //!< Bitmap of non-empty slots per level.
+  Timer* mExpiredHead;           //!< Oldest expired timer.
+  Timer* mExpiredTail;           //!< Most recently expired timer.
+  uint32_t mExpiredCount;        //!< Number of timers in the expired list.
+
+  /** @brief Puts the (unlinked) timer on the level/slot matching its expiry. */
+  void Insert(Timer& timer);
+
+  /** @brief Appends the (unlinked) timer to the list of expired timers. */
+  void AppendExpired(Timer& timer);
+
+  /** @brief Redistributes (or expires) all timers of the given slot. */
+  void Cascade(const uint8_t level, const uint8_t slot);
+
+  /** @brief Determines the next occupied slot of the (non-empty) level after the current time. */
+  uint8_t ClosestSlot(const uint8_t level) const;
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_TIMINGWHEEL_HPP_
@@ -0,0 +1,139 @@
+/**
+ * @file WorkStealingDeque.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a bounded, lock-free work-stealing deque (Chase-Lev).
+ * @version 0.1
+ * @date 2021-08-07
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGDEQUE_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGDEQUE_HPP_
+
+// Standard header
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Esp32Modules::Core::Scheduling
+{
+/**
+ * @brief Bounded Chase-Lev deque of pointers.
+ *
+ * A single owner thread pushes (and optionally pops) items at the bottom while any number of thief
+ * threads steal items from the top. None of the operations lock or allocate.
+ *
+ * Indices are 32 bit (the ESP32 has no lock-free 64 bit atomics) and compared with wrap-around
+ * arithmetic, so the deque keeps working after 2^32 pushes.
+ *
+ * @tparam T Pointee type of the stored items.
+ * @tparam Capacity Maximum number of items (power of two).
+ */
+template <typename T, size_t Capacity>
+class WorkStealingDeque
+{
+  static_assert(Capacity > 0 and (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two.");
+
+ public:
+  WorkStealingDeque() : mTop{0}, mBottom{0}, mItems{} {}
+  ~WorkStealingDeque() = default;
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * @brief Adds an item at the bottom (owner only).
+   *
+   * @param item Item to be added.
+   * @return true if the item was added, false if the deque is full.
+   */
+  bool Push(T* item)
+  {
+    const uint32_t bottom = mBottom.load(std::memory_order_relaxed);
+    const uint32_t top = mTop.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(bottom - top) >= static_cast<int32_t>(Capacity))
+    {
+      return false;
+    }
+    mItems[bottom & MASK].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Takes the most recently pushed item from the bottom (owner only).
+   *
+   * @return Item taken - nullptr if the deque is empty (or a thief took the last item).
+   */
+  T* Pop()
+  {
+    const uint32_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+    mBottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t top = mTop.load(std::memory_order_relaxed);
+    const int32_t size = static_cast<int32_t>(bottom - top);
+    if (size < 0)
+    {
+      mBottom.store(bottom + 1, std::memory_order_relaxed);  // Was empty.
+      return nullptr;
+    }
+    T* item = mItems[bottom & MASK].load(std::memory_order_relaxed);
+    if (size > 0)
+    {
+      return item;  // No race with thieves possible.
+    }
+    // Last item, compete with the thieves for it.
+    const bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return (won ? item : nullptr);
+  }
+
+  /**
+   * @brief Takes the oldest item from the top (any thread).
+   *
+   * @return Item taken - nullptr if the deque is empty or another thread won the race for it.
+   */
+  T* Steal()
+  {
+    uint32_t top = mTop.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint32_t bottom = mBottom.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(bottom - top) <= 0)
+    {
+      return nullptr;
+    }
+    T* item = mItems[top & MASK].load(std::memory_order_relaxed);
+    if (not mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+    {
+      return nullptr;
+    }
+    return item;
+  }
+
+  /**
+   * @brief Provides a snapshot of the number of items (may be outdated immediately).
+   *
+   * @return Approximate number of items.
+   */
+  size_t SizeApprox() const
+  {
+    const int32_t size = static_cast<int32_t>(mBottom.load(std::memory_order_relaxed) -
+                                              mTop.load(std::memory_order_relaxed));
+    return (size > 0 ? static_cast<size_t>(size) : 0);
+  }
+
+ private:
+  static constexpr uint32_t MASK{Capacity - 1};
+
+  std::atomic<uint32_t> mTop;        //!< Index of the oldest item (advanced by steals).
+  std::atomic<uint32_t> mBottom;     //!< Index after the newest item (owned by the owner).
+  std::atomic<T*> mItems[Capacity];  //!< Ring buffer of the items.
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGDEQUE_HPP_
@@ -0,0 +1,194 @@
+/**
+ * @file WorkStealingExecutor.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides an executor running jobs on all cores in parallel to the cooperative scheduler.
+ * @version 0.1
+ * @date 2021-08-07
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGEXECUTOR_HPP_
+#define ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGEXECUTOR_HPP_
+
+// Standard header
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef ESP_PLATFORM
+// Platform header
+#include <sdkconfig.h>
+#endif
+
+// Project header
+#include <esp32-modules/core/scheduling/CooperativeScheduler.hpp>
+#include <esp32-modules/core/scheduling/WorkStealingDeque.hpp>
+
+// Number of worker threads (one per core of the ESP32 by default).
+#ifndef ESP32MODULES_EXECUTOR_WORKERS
+#define ESP32MODULES_EXECUTOR_WORKERS 2
+#endif
+
+// Maximum number of jobs posted but not yet completed (power of two).
+#ifndef ESP32MODULES_EXECUTOR_MAX_JOBS
+#define ESP32MODULES_EXECUTOR_MAX_JOBS 32
+#endif
+
+// Stack size of each worker thread in bytes.
+#ifndef ESP32MODULES_EXECUTOR_STACK_SIZE
+#define ESP32MODULES_EXECUTOR_STACK_SIZE 4096
+#endif
+
+// Core running the cooperative loop (the core of the Arduino loop task by default).
+#ifndef ESP32MODULES_EXECUTOR_LOOP_CORE
+#if defined(CONFIG_FREERTOS_UNICORE) && CONFIG_FREERTOS_UNICORE
+#define ESP32MODULES_EXECUTOR_LOOP_CORE 0
+#elif defined(CONFIG_ARDUINO_RUNNING_CORE)
+#define ESP32MODULES_EXECUTOR_LOOP_CORE CONFIG_ARDUINO_RUNNING_CORE
+#else
+#define ESP32MODULES_EXECUTOR_LOOP_CORE 1
+#endif
+#endif
+
+// FreeRTOS priority of workers pinned to the loop core. Has to be below the priority of the loop
+// task (1 for the Arduino loop task), otherwise busy workers starve the loop.
+#ifndef ESP32MODULES_EXECUTOR_LOOP_CORE_PRIORITY
+#define ESP32MODULES_EXECUTOR_LOOP_CORE_PRIORITY 0
+#endif
+
+namespace Esp32Modules::Core::Scheduling
+{
+using JobId = uint32_t;  //!< Id of a job posted to the executor.
+
+constexpr JobId INVALID_JOBID{0};  //!< Indicates a job is not valid.
+constexpr int8_t ANY_WORKER{-1};   //!< Affinity hint for jobs that may run on any worker.
+
+/**
+ * @brief Runs computationally heavy jobs on worker threads (one per core) besides the cooperative
+ * loop and hands their completions back to it.
+ *
+ * Each worker has a lock-free deque the cooperative loop posts jobs to, preferably to the worker
+ * given by the affinity hint. Idle workers first serve their own deque and then steal jobs from the
+ * other deques, so no core idles while there is work left. Once a job is done, its completion
+ * callback is queued (lock-free) and executed within the cooperative loop, so completions may
+ * safely interact with everything else run by the CooperativeScheduler.
+ *
+ * On the ESP32, workers are pinned to the cores in turn. A worker sharing the core with the
+ * cooperative loop (see ESP32MODULES_EXECUTOR_LOOP_CORE) runs below the priority of the loop, so it
+ * only uses the time the loop sleeps or waits and never delays due tasks. Its jobs are stolen by
+ * the workers on the other core in the meantime. Workers on the other core keep the default
+ * pthread priority.
+ *
+ * @note Post() and ProcessCompletions() must only be called from the cooperative loop (the thread
+ * running the CooperativeScheduler). Jobs themselves run in parallel and must synchronize any data
+ * they share with the rest of the application.
+ */
+class WorkStealingExecutor
+{
+ public:
+  /**
+   * @brief Starts the workers and a cyclic task processing the completions.
+   *
+   * @param scheduler Scheduler of the cooperative loop executing the completions.
+   * @param completionInterval Interval in which completions are processed.
+   */
+  WorkStealingExecutor(CooperativeScheduler& scheduler,
+                       const TaskDuration completionInterval = 10 * TASK_MILLISECOND);
+
+  /**
+   * @brief Stops the workers after they finished their current job.
+   *
+   * @note Jobs not yet started are discarded without running their completions.
+   */
+  ~WorkStealingExecutor();
+
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  /**
+   * @brief Posts a job to be executed by the workers.
+   *
+   * @param work Job to be executed on a worker thread.
+   * @param completion Callback executed within the cooperative loop after the job finished
+   * (optional).
+   * @param affinity Index of the preferred worker (ANY_WORKER for no preference). Other workers may
+   * still steal the job if the preferred one is busy.
+   * @return JobId Id of the job - INVALID_JOBID if too many jobs are pending or the job is empty.
+   */
+  JobId Post(TaskFunction work, TaskFunction completion = nullptr,
+             const int8_t affinity = ANY_WORKER);
+
+  /**
+   * @brief Executes the completion callbacks of all finished jobs.
+   *
+   * @return Number of completions processed.
+   */
+  uint16_t ProcessCompletions();
+
+  /**
+   * @brief Statistics of a single worker.
+   */
+  struct WorkerStatistics
+  {
+    uint32_t executed;  //!< Number of jobs executed by the worker.
+    uint32_t stolen;    //!< Number of those jobs taken from the deque of another worker.
+  };
+
+  /**
+   * @brief Provides the statistics of the given worker.
+   *
+   * @param worker Index of the worker.
+   * @return Statistics of the worker (all zero for unknown workers).
+   */
+  WorkerStatistics GetWorkerStatistics(const uint8_t worker) const;
+
+  /** @brief Number of worker threads. */
+  static constexpr uint8_t WORKERS{ESP32MODULES_EXECUTOR_WORKERS};
+  /** @brief Maximum number of jobs posted but not yet completed. */
+  static constexpr uint16_t MAX_JOBS{ESP32MODULES_EXECUTOR_MAX_JOBS};
+
+ private:
+  /** A job and its completion. */
+  struct Job
+  {
+    Job(TaskFunction w, TaskFunction c) : work{std::move(w)}, completion{std::move(c)} {}
+
+    TaskFunction work;        //!< Executed by a worker.
+    TaskFunction completion;  //!< Executed by the cooperative loop.
+    JobId id{INVALID_JOBID};  //!< Id of the job within the pool.
+    Job* next{nullptr};       //!< Link within the completion queue.
+  };
+
+  /** State of a single worker. */
+  struct Worker
+  {
+    WorkStealingDeque<Job, MAX_JOBS> deque;  //!< Jobs posted to this worker.
+    std::thread thread;                      //!< Thread executing the jobs.
+    std::atomic<uint32_t> executed{0};       //!< Number of jobs executed.
+    std::atomic<uint32_t> stolen{0};         //!< Number of jobs stolen from other workers.
+  };
+
+  CooperativeScheduler& mScheduler;  //!< Scheduler executing the completions.
+  TaskId mCompletionTask;            //!< Cyclic task processing the completions.
+  TaskPool<Job, MAX_JOBS> mJobs;     //!< Storage of pending jobs (only used by the loop).
+  Worker mWorkers[WORKERS];          //!< Worker threads including their deques.
+  uint8_t mNextWorker;               //!< Round robin counter for jobs without affinity.
+  std::atomic<Job*> mCompleted;      //!< Lock-free stack of completed jobs.
+  std::atomic<uint16_t> mPending;    //!< Number of jobs in the deques.
+  std::atomic<bool> mRunning;        //!< Cleared to stop the workers.
+  std::mutex mWakeMutex;             //!< Only used to put idle workers to sleep.
+  std::condition_variable mWakeUp;   //!< Signaled whenever jobs are posted.
+
+  /** @brief Main loop of the worker with the given index. */
+  void RunWorker(const uint8_t index);
+
+  /** @brief Takes a job from the own deque or steals one from the others. */
+  Job* TakeJob(const uint8_t index);
+};
+}  // namespace Esp32Modules::Core::Scheduling
+
+#endif  // ESP32MODULES__CORE_SCHEDULING_WORKSTEALINGEXECUTOR_HPP_
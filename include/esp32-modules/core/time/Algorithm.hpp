@@ -12,6 +12,7 @@
 #define ESP32MODULES__CORE_TIME_ALGORITHM_HPP_
 
 // Standard header
+#include <cstdint>
 #include <ctime>
 
 namespace Esp32Modules::Core::Time::Algorithm
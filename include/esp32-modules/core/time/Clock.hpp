@@ -0,0 +1,81 @@
+/**
+ * @file Clock.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides an abstraction of the system time and the sleep modes for time-driven modules.
+ * @version 0.1
+ * @date 2021-07-24
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_TIME_CLOCK_HPP_
+#define ESP32MODULES__CORE_TIME_CLOCK_HPP_
+
+// Standard header
+#include <cstdint>
+
+namespace Esp32Modules::Core::Time
+{
+/**
+ * @brief Source of the monotonic millisecond time including the means to sleep until a later time.
+ *
+ * Allows to replace the hardware time (e.g. by a SimulatedClock) for modules relying on it.
+ */
+class Clock
+{
+ public:
+  virtual ~Clock() = default;
+
+  /**
+   * @brief Provides the milliseconds passed since an arbitrary starting point (e.g. boot).
+   *
+   * @return Current time in milliseconds (wraps around after ~49 days).
+   */
+  virtual uint32_t Millis() const = 0;
+
+  /**
+   * @brief Provides the microseconds passed since the same starting point as Millis().
+   *
+   * @return Current time in microseconds (wraps around after ~71 minutes).
+   */
+  virtual uint32_t Micros() const = 0;
+
+  /**
+   * @brief Suspends execution for the given time, keeping the state of the application.
+   *
+   * @param duration Milliseconds to sleep.
+   */
+  virtual void LightSleep(const uint32_t duration) = 0;
+
+  /**
+   * @brief Powers down for the given time (waking up is like a reboot on real hardware).
+   *
+   * @param duration Milliseconds to sleep (the system clock rounds up to full seconds).
+   */
+  virtual void DeepSleep(const uint32_t duration) = 0;
+};
+
+/**
+ * @brief Clock based on the system time and the sleep modes of the ESP32.
+ */
+class SystemClock : public Clock
+{
+ public:
+  SystemClock() = default;
+  ~SystemClock() = default;
+
+  uint32_t Millis() const override;
+  uint32_t Micros() const override;
+  void LightSleep(const uint32_t duration) override;
+  void DeepSleep(const uint32_t duration) override;
+};
+
+/**
+ * @brief Provides the clock representing the system time.
+ *
+ * @return Clock& Shared system clock instance.
+ */
+Clock& GetSystemClock();
+}  // namespace Esp32Modules::Core::Time
+
+#endif  // ESP32MODULES__CORE_TIME_CLOCK_HPP_
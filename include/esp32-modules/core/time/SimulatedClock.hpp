@@ -0,0 +1,81 @@
+/**
+ * @file SimulatedClock.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a virtual clock to run time-driven modules off-target (e.g. in host tests).
+ * @version 0.1
+ * @date 2021-07-24
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__CORE_TIME_SIMULATEDCLOCK_HPP_
+#define ESP32MODULES__CORE_TIME_SIMULATEDCLOCK_HPP_
+
+// Standard header
+#include <cstdint>
+
+// Project header
+#include <esp32-modules/core/time/Clock.hpp>
+
+namespace Esp32Modules::Core::Time
+{
+/**
+ * @brief Clock whose time only moves when advanced explicitly or when sleeping.
+ *
+ * Sleeping returns immediately after advancing the time. The clock keeps track of the number of
+ * sleeps (i.e. wake-ups) and of the time slept, so power saving strategies can be evaluated.
+ */
+class SimulatedClock : public Clock
+{
+ public:
+  /**
+   * @brief Sets up the clock.
+   *
+   * @param start Initial time in milliseconds.
+   */
+  explicit SimulatedClock(const uint32_t start = 0);
+  ~SimulatedClock() = default;
+
+  uint32_t Millis() const override;
+  uint32_t Micros() const override;
+  void LightSleep(const uint32_t duration) override;
+  void DeepSleep(const uint32_t duration) override;
+
+  /**
+   * @brief Moves the time forward (like busy code would do).
+   *
+   * @param duration Milliseconds to advance.
+   */
+  void Advance(const uint32_t duration);
+
+  /**
+   * @brief Moves the time forward with microsecond resolution.
+   *
+   * @param duration Microseconds to advance.
+   */
+  void AdvanceMicros(const uint32_t duration);
+
+  /**
+   * @brief Sleep statistics collected since construction.
+   */
+  struct Statistics
+  {
+    uint32_t lightSleeps;    //!< Number of light sleeps (i.e. wake-ups from light sleep).
+    uint32_t deepSleeps;     //!< Number of deep sleeps.
+    uint64_t sleptDuration;  //!< Total milliseconds spent sleeping.
+  };
+
+  /**
+   * @brief Provides the sleep statistics.
+   *
+   * @return Statistics collected so far.
+   */
+  const Statistics& GetStatistics() const;
+
+ private:
+  uint64_t mNow;           //!< Current time in microseconds.
+  Statistics mStatistics;  //!< Sleep statistics.
+};
+}  // namespace Esp32Modules::Core::Time
+
+#endif  // ESP32MODULES__CORE_TIME_SIMULATEDCLOCK_HPP_
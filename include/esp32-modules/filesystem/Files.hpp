@@ -84,6 +84,24 @@ class RegularFile
    */
   bool Write(const std::string& content, const bool append = true);
 
+  /**
+   * @brief Opens the file for writing piece by piece (e.g. to stream data of unknown size).
+   *
+   * @note If the file does not exist, a new file will be created.
+   *
+   * @param append Flag indicating whether the data shall be appended to the file - if set to false,
+   * the existing data will be discarded.
+   * @return Opened file (evaluates to false if it could not be opened), closed when destroyed.
+   */
+  File OpenForWriting(const bool append = false);
+
+  /**
+   * @brief Opens the file for reading piece by piece (e.g. to stream it without loading it).
+   *
+   * @return Opened file (evaluates to false if it could not be opened), closed when destroyed.
+   */
+  File OpenForReading();
+
   /**
    * @brief Moves a file to another location (i.e. renames it).
    *
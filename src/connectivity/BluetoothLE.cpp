@@ -1,23 +1,33 @@
 #include "esp32-modules/connectivity/BluetoothLE.hpp"
 
 // Standard includes
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 // Platform includes
 #include <Arduino.h>
+#include <BLE2902.h>
 #include <BLEDevice.h>
 #include <BLEUtils.h>
+#include <esp_gatts_api.h>
 
 namespace Esp32Modules::Connectivity::BluetoothLE
 {
 namespace
 {
-/** */
-struct BleCommand
+/** Size of the receive timestamp preceding each queued payload. */
+constexpr size_t TIMESTAMP_SIZE{sizeof(uint32_t)};
+
+/** Signals the receive event (if any), the argument is a std::atomic<TaskEvent*>. */
+void SignalReceiveEvent(void* receiveEvent)
 {
-  std::string token;       //!<
-  std::string parameters;  //!<
-};
+  auto* event = static_cast<std::atomic<Core::Scheduling::TaskEvent*>*>(receiveEvent)->load();
+  if (event)
+  {
+    event->Signal();
+  }
+}
 
 /**
  * @brief Implements the callbacks for the BLE server itself.
@@ -26,21 +36,42 @@ struct BleCommand
 class ServerFunctor : public BLEServerCallbacks
 {
  public:
-  ServerFunctor() = default;
+  /**
+   * @brief Construct a new Server Functor object
+   *
+   * @param connection State machine to signal connects and disconnects to.
+   * @param rxQueue Receiving queue to mark disconnects in.
+   * @param receiveEvent Event to be signaled on disconnects.
+   */
+  ServerFunctor(ConnectionManager& connection, BleCommandReceiver::BleReceivingQueue& rxQueue,
+                std::atomic<Core::Scheduling::TaskEvent*>& receiveEvent)
+      : mConnection{connection}, mRxQueue{rxQueue}, mReceiveEvent{receiveEvent}
+  {
+  }
   ~ServerFunctor() = default;
 
  private:
+  ConnectionManager& mConnection;
+  BleCommandReceiver::BleReceivingQueue& mRxQueue;
+  std::atomic<Core::Scheduling::TaskEvent*>& mReceiveEvent;
+
   void onConnect(BLEServer*) override
   {
-    // Do something on connect
+    mConnection.OnConnect();
+    SignalReceiveEvent(&mReceiveEvent);  // Lets the application process the state change.
   }
 
-  void onDisconnect(BLEServer* server) override
+  // Advertising is restarted by the state machine - never block the BLE task in here.
+  void onDisconnect(BLEServer*) override
   {
-    // Give the bluetooth stack the chance to get things ready
-    delay(500);
-    // Restart advertising
-    server->startAdvertising();
+    mConnection.OnDisconnect();
+    // An entry without payload marks the disconnect right behind the writes of this peer, so its
+    // partial frame is dropped before the writes of the next peer are decoded. The marker must not
+    // be lost, so it takes the place of the oldest writes if the queue is full.
+    const uint32_t timestamp = micros();
+    mRxQueue.PushDroppingOldest(reinterpret_cast<const uint8_t*>(&timestamp), TIMESTAMP_SIZE,
+                                nullptr, 0);
+    SignalReceiveEvent(&mReceiveEvent);
   }
 };
 
@@ -54,87 +85,383 @@ class ReceivingFunctor : public BLECharacteristicCallbacks
   /**
    * @brief Construct a new Receiving Functor object
    *
-   * @param mutex
    * @param rxQueue
+   * @param receiveEvent
    */
-  ReceivingFunctor(std::mutex& mutex, BleCommandReceiver::BleReceivingQueue& rxQueue)
-      : mInterfaceMutex{mutex}, mRxQueue{rxQueue}
+  ReceivingFunctor(BleCommandReceiver::BleReceivingQueue& rxQueue,
+                   std::atomic<Core::Scheduling::TaskEvent*>& receiveEvent)
+      : mRxQueue{rxQueue}, mReceiveEvent{receiveEvent}
   {
   }
   ~ReceivingFunctor() = default;
 
  private:
-  std::mutex& mInterfaceMutex;
   BleCommandReceiver::BleReceivingQueue& mRxQueue;
+  std::atomic<Core::Scheduling::TaskEvent*>& mReceiveEvent;
 
   void onWrite(BLECharacteristic* charac) override
   {
-    std::string rxValue{charac->getValue()};
-    if (rxValue.length() > 0)
+    // Copy straight from the characteristic, getValue() would allocate a temporary string.
+    const size_t length = charac->getLength();
+    const uint32_t timestamp = micros();
+    if (length > 0 and mRxQueue.Push(reinterpret_cast<const uint8_t*>(&timestamp),
+                                     TIMESTAMP_SIZE, charac->getData(), length))
+    {
+      auto* event = mReceiveEvent.load();
+      if (event)
+      {
+        event->Signal();
+      }
+    }
+  }
+};
+
+/**
+ * @brief Sends chunks with the notifying BLE characteristic and tracks their completion.
+ *
+ */
+class TransmittingFunctor
+{
+ public:
+  /**
+   * @brief Construct a new Transmitting Functor object
+   *
+   * @param server Server the peer is connected to.
+   * @param characteristic Notifying characteristic.
+   * @param subscription Descriptor the peer subscribes to notifications with.
+   * @param txQueue Queue to signal completed notifications to (set up afterwards).
+   */
+  TransmittingFunctor(BLEServer& server, BLECharacteristic& characteristic,
+                      BLE2902& subscription,
+                      std::unique_ptr<BleCommandReceiver::BleSendingQueue>& txQueue)
+      : mServer{server},
+        mCharacteristic{characteristic},
+        mSubscription{subscription},
+        mTxQueue{txQueue},
+        mCongested{false}
+  {
+  }
+  ~TransmittingFunctor() = default;
+
+  /** Notifies the chunk, returns false if the BLE stack did not take it (e.g. congested). */
+  bool Notify(const uint8_t* chunk, const size_t length)
+  {
+    if (mCongested.load() or not mSubscription.getNotifications())
+    {
+      return false;
+    }
+    // Hand the chunk to the stack directly, which copies it. BLECharacteristic::setValue() would
+    // copy it into a heap-allocated string first, and notify() reports success synchronously.
+    return (esp_ble_gatts_send_indicate(mServer.getGattsIf(), mServer.getConnId(),
+                                        mCharacteristic.getHandle(), length,
+                                        const_cast<uint8_t*>(chunk), false) == ESP_OK);
+  }
+
+  /** Returns a credit per notification sent by the stack and pauses while it is congested. */
+  void OnGattsEvent(const esp_gatts_cb_event_t event, const esp_gatt_if_t gattsIf,
+                    const esp_ble_gatts_cb_param_t& param)
+  {
+    if (gattsIf != mServer.getGattsIf())
+    {
+      return;  // Event of another receiver.
+    }
+    if (event == ESP_GATTS_CONF_EVT and param.conf.conn_id == mServer.getConnId() and
+        param.conf.handle == mCharacteristic.getHandle())
+    {
+      mTxQueue->OnSent();  // Also on errors, the chunk is not in flight anymore.
+    }
+    else if (event == ESP_GATTS_CONGEST_EVT and param.congest.conn_id == mServer.getConnId())
     {
-      std::lock_guard<std::mutex>{mInterfaceMutex};
-      mRxQueue.emplace(std::move(rxValue));
+      mCongested.store(param.congest.congested);
     }
   }
+
+  /** Indicates whether the transmitter returns the credits of the queue. */
+  bool Serves(const std::unique_ptr<BleCommandReceiver::BleSendingQueue>& txQueue) const
+  {
+    return &mTxQueue == &txQueue;
+  }
+
+ private:
+  BLEServer& mServer;
+  BLECharacteristic& mCharacteristic;
+  BLE2902& mSubscription;
+  std::unique_ptr<BleCommandReceiver::BleSendingQueue>& mTxQueue;
+  std::atomic<bool> mCongested;
 };
+
+/**
+ * Transmitters receiving the GATT server events. There is a single handler for the whole BLE
+ * device, which passes each event on to the transmitter of its GATT interface.
+ */
+std::atomic<TransmittingFunctor*> gTransmitters[ESP32MODULES_BLE_MAX_TRANSMITTERS]{};
+
+void HandleGattsEvent(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf,
+                      esp_ble_gatts_cb_param_t* param)
+{
+  if (not param)
+  {
+    return;
+  }
+  for (auto& slot : gTransmitters)
+  {
+    if (auto* transmitter = slot.load())
+    {
+      transmitter->OnGattsEvent(event, gattsIf, *param);
+    }
+  }
+}
+
+/** Adds the transmitter to the registry, returns false if all slots are taken. */
+bool RegisterTransmitter(TransmittingFunctor* transmitter)
+{
+  for (auto& slot : gTransmitters)
+  {
+    TransmittingFunctor* free{nullptr};
+    if (slot.compare_exchange_strong(free, transmitter))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Removes the transmitter of the queue from the registry (if any). */
+void UnregisterTransmitter(const std::unique_ptr<BleCommandReceiver::BleSendingQueue>& txQueue)
+{
+  for (auto& slot : gTransmitters)
+  {
+    auto* transmitter = slot.load();
+    if (transmitter and transmitter->Serves(txQueue))
+    {
+      slot.store(nullptr);
+    }
+  }
+}
 }  // namespace
 
 BleCommandReceiver::BleCommandReceiver(const std::string& deviceName,
-                                       const std::string& serviceUuid, const std::string& rxUuid)
-    : mBLEServer{}, mCallbacks{}, mRxQueue{}
+                                       const std::string& serviceUuid, const std::string& rxUuid,
+                                       const Core::Containers::OverflowPolicy rxOverflowPolicy,
+                                       const CommandProtocol protocol,
+                                       const std::string& txUuid,
+                                       const AdvertisingConfig& advertising)
+    : mBLEServer{},
+      mOwnRouter{},
+      mRouter{&mOwnRouter},
+      mFrameCallbacks{},
+      mProtocol{protocol},
+      mFrameDecoder{},
+      mRxQueue{rxOverflowPolicy},
+      mMaxRxLatency{0},
+      mTotalRxLatency{0},
+      mReceiveEvent{nullptr},
+      mTxQueue{},
+      mConnection{[this](const uint16_t interval) { Advertise(interval); }, advertising},
+      mUpdateTimer{nullptr}
 {
+  esp_timer_create_args_t updateTimer{};
+  updateTimer.callback = &SignalReceiveEvent;
+  updateTimer.arg = &mReceiveEvent;
+  updateTimer.name = "ble-connection";
+  esp_timer_create(&updateTimer, &mUpdateTimer);
+
   BLEDevice::init(deviceName);
   mBLEServer.reset(BLEDevice::createServer());
-  mBLEServer->setCallbacks(new ServerFunctor());
+  mBLEServer->setCallbacks(new ServerFunctor(mConnection, mRxQueue, mReceiveEvent));
   auto bleService = mBLEServer->createService(serviceUuid);
   auto rxCharacteristic =
       bleService->createCharacteristic(rxUuid, BLECharacteristic::PROPERTY_WRITE);
-  rxCharacteristic->setCallbacks(new ReceivingFunctor(mMutex, mRxQueue));
+  rxCharacteristic->setCallbacks(new ReceivingFunctor(mRxQueue, mReceiveEvent));
+  if (not txUuid.empty())
+  {
+    auto txCharacteristic =
+        bleService->createCharacteristic(txUuid, BLECharacteristic::PROPERTY_NOTIFY);
+    auto subscription = new BLE2902();  // Lets peers subscribe to notifications.
+    txCharacteristic->addDescriptor(subscription);
+    auto transmitter =
+        new TransmittingFunctor(*mBLEServer, *txCharacteristic, *subscription, mTxQueue);
+    // Without the completion events, the queue would never get its credits back.
+    if (RegisterTransmitter(transmitter))
+    {
+      mTxQueue.reset(new BleSendingQueue(
+          [transmitter](const uint8_t* chunk, const size_t length) {
+            return transmitter->Notify(chunk, length);
+          },
+          ESP32MODULES_BLE_TX_MAX_IN_FLIGHT));
+      BLEDevice::setCustomGattsHandler(HandleGattsEvent);
+    }
+    else
+    {
+      delete transmitter;
+    }
+  }
   bleService->start();
   mBLEServer->getAdvertising()->addServiceUUID(bleService->getUUID());
-  mBLEServer->getAdvertising()->start();
+  mConnection.Start();
 }
 
-bool BleCommandReceiver::RegisterCallback(const std::string& token, const BleCommandCallback& cb)
+BleCommandReceiver::~BleCommandReceiver()
 {
-  std::lock_guard<std::mutex>{mMutex};
-  const auto res = mCallbacks.emplace(token, cb);
-  return res.second;
+  UnregisterTransmitter(mTxQueue);
+  if (mUpdateTimer)
+  {
+    esp_timer_stop(mUpdateTimer);
+    esp_timer_delete(mUpdateTimer);
+  }
 }
 
-namespace
+bool BleCommandReceiver::RegisterCallback(const std::string_view token, BleCommandCallback cb)
 {
-/** Maps the @p cmd to the BleCommand structure. */
-BleCommand GetBleCommand(const std::string& cmd)
+  return mRouter.load()->Register(token, std::move(cb));
+}
+
+void BleCommandReceiver::SetRouter(CommandRouter& router)
 {
-  const auto splitPos = cmd.find(' ');
-  return {cmd.substr(0, splitPos), cmd.substr(splitPos + 1, cmd.size())};
+  mRouter.store(&router);
+}
+
+bool BleCommandReceiver::RegisterFrameCallback(const uint8_t id, BleFrameCallback cb)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return mFrameCallbacks.emplace(id, std::move(cb)).second;
+}
+
+void BleCommandReceiver::SetReceiveEvent(Core::Scheduling::TaskEvent* event)
+{
+  mReceiveEvent.store(event);
+}
+
+BleCommandReceiver::ReceiveStatistics BleCommandReceiver::GetReceiveStatistics() const
+{
+  const auto queue = mRxQueue.GetStatistics();
+  return {queue.pushed, queue.popped,  queue.dropped,  queue.rejected,
+          queue.peak,   mMaxRxLatency, mTotalRxLatency};
+}
+
+FrameDecoder::Statistics BleCommandReceiver::GetFrameStatistics() const
+{
+  return mFrameDecoder.GetStatistics();
 }
-}  // namespace
 
 void BleCommandReceiver::ProcessPendingCommands()
 {
-  std::queue<std::string> receivedCommands;
+  uint8_t buffer[TIMESTAMP_SIZE + MAX_VALUE_SIZE];
+  size_t frameLength{0};
+  while (mRxQueue.Pop(buffer, sizeof(buffer), frameLength))
   {
-    std::lock_guard<std::mutex>{mMutex};
-    if (mRxQueue.empty())
+    if (frameLength == TIMESTAMP_SIZE)
+    {
+      mFrameDecoder.Reset();  // All writes of the disconnected peer are decoded, drop its rest.
+      continue;
+    }
+    uint32_t timestamp{0};
+    std::memcpy(&timestamp, buffer, TIMESTAMP_SIZE);
+    const uint32_t latency = micros() - timestamp;
+    mMaxRxLatency = std::max(mMaxRxLatency, latency);
+    mTotalRxLatency += latency;
+    const uint8_t* payload = &buffer[TIMESTAMP_SIZE];
+    const size_t length = frameLength - TIMESTAMP_SIZE;
+    if (mProtocol == CommandProtocol::BINARY)
     {
-      return;
+      mFrameDecoder.Feed(payload, length, [this](const CommandFrame& frame) {
+        BleFrameCallback* callback{nullptr};
+        {
+          std::lock_guard<std::mutex> lock{mMutex};
+          const auto match = mFrameCallbacks.find(frame.id);
+          if (match != mFrameCallbacks.end())
+          {
+            callback = &match->second;
+          }
+        }
+        if (callback)
+        {
+          (*callback)(frame.payload, frame.length);  // Stays valid, callbacks are never removed.
+        }
+      });
+      continue;
     }
-    receivedCommands.swap(mRxQueue);
+    mRouter.load()->Dispatch(std::string_view{reinterpret_cast<const char*>(payload), length});
+  }
+  ProcessConnectionEvents();  // Readvertising must not depend on another task of the application.
+}
+
+bool BleCommandReceiver::Send(const uint8_t* data, const size_t length)
+{
+  return (mTxQueue and mTxQueue->Enqueue(data, length));
+}
+
+bool BleCommandReceiver::Send(const std::string_view message)
+{
+  return Send(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+}
+
+void BleCommandReceiver::ProcessPendingTransmissions()
+{
+  if (not mTxQueue)
+  {
+    return;
+  }
+  if (mBLEServer->getConnectedCount() == 0)
+  {
+    mTxQueue->Reset();  // Notifications in flight are lost, start over with the next peer.
+    return;
   }
-  while (not receivedCommands.empty())
+  // Three bytes of each ATT packet are taken by the opcode and the handle.
+  const uint16_t mtu = mBLEServer->getPeerMTU(mBLEServer->getConnId());
+  if (mtu > 3)
   {
-    const auto cmd = receivedCommands.front();
-    receivedCommands.pop();
-    const auto bleCmd = GetBleCommand(cmd);
-    const auto match = mCallbacks.find(bleCmd.token);
-    if (match == mCallbacks.end())
+    mTxQueue->SetChunkSize(mtu - 3);
+  }
+  mTxQueue->Flush();
+}
+
+BleCommandReceiver::BleSendingQueue::Statistics BleCommandReceiver::GetSendStatistics() const
+{
+  return (mTxQueue ? mTxQueue->GetStatistics() : BleSendingQueue::Statistics{});
+}
+
+void BleCommandReceiver::ProcessConnectionEvents()
+{
+  mConnection.Update();
+  // Applications only processing commands on the receive event are woken up once the state
+  // machine is due again (e.g. to readvertise after the restart delay).
+  const uint32_t delay = mConnection.TimeUntilUpdate();
+  if (mUpdateTimer and mReceiveEvent.load())
+  {
+    esp_timer_stop(mUpdateTimer);  // Fails harmlessly if the timer is not running.
+    if (delay != NO_UPDATE_DUE)
     {
-      continue;
+      const uint64_t timeout = static_cast<uint64_t>(std::max<uint32_t>(delay, 1)) * 1000;
+      esp_timer_start_once(mUpdateTimer, timeout);
     }
-    match->second(bleCmd.parameters);
   }
 }
 
-}  // namespace Esp32Modules::Connectivity::BluetoothLE
\ No newline at end of file
+void BleCommandReceiver::SetConnectionCallback(ConnectionManager::StateCallback callback)
+{
+  mConnection.SetStateCallback(std::move(callback));
+}
+
+ConnectionState BleCommandReceiver::GetConnectionState() const
+{
+  return mConnection.GetState();
+}
+
+ConnectionManager::Statistics BleCommandReceiver::GetConnectionStatistics() const
+{
+  return mConnection.GetStatistics();
+}
+
+void BleCommandReceiver::Advertise(const uint16_t interval)
+{
+  // Intervals are given in units of 0.625 ms, allow the stack some slack for the maximum.
+  const uint32_t units = static_cast<uint32_t>(interval) * 8 / 5;
+  auto* advertising = mBLEServer->getAdvertising();
+  advertising->stop();
+  advertising->setMinInterval(static_cast<uint16_t>(std::min<uint32_t>(units, 0x4000)));
+  advertising->setMaxInterval(static_cast<uint16_t>(std::min<uint32_t>(units * 3 / 2, 0x4000)));
+  advertising->start();
+}
+
+}  // namespace Esp32Modules::Connectivity::BluetoothLE
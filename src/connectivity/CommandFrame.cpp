@@ -0,0 +1,120 @@
+#include "esp32-modules/connectivity/CommandFrame.hpp"
+
+// Standard header
+#include <algorithm>
+#include <cstring>
+
+namespace Esp32Modules::Connectivity
+{
+uint16_t Crc16(const uint8_t* data, const size_t length, uint16_t crc)
+{
+  // Bitwise instead of table-driven to save flash, frames are short anyway.
+  for (size_t i = 0; i < length; ++i)
+  {
+    crc ^= static_cast<uint16_t>(data[i]) << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t EncodeFrame(const uint8_t id, const uint8_t* payload, const size_t length, uint8_t* buffer,
+                   const size_t size)
+{
+  const size_t frameSize = FRAME_HEADER_SIZE + length + FRAME_TRAILER_SIZE;
+  if (length > FRAME_MAX_PAYLOAD or size < frameSize)
+  {
+    return 0;
+  }
+  buffer[0] = FRAME_SYNC;
+  buffer[1] = id;
+  buffer[2] = static_cast<uint8_t>(length & 0xFF);
+  buffer[3] = static_cast<uint8_t>(length >> 8);
+  if (length > 0)
+  {
+    std::memcpy(&buffer[FRAME_HEADER_SIZE], payload, length);
+  }
+  const uint16_t crc = Crc16(&buffer[1], FRAME_HEADER_SIZE - 1 + length);
+  buffer[FRAME_HEADER_SIZE + length] = static_cast<uint8_t>(crc & 0xFF);
+  buffer[FRAME_HEADER_SIZE + length + 1] = static_cast<uint8_t>(crc >> 8);
+  return frameSize;
+}
+
+void FrameDecoder::Reset()
+{
+  mFill = 0;
+  mConsumed = 0;
+}
+
+size_t FrameDecoder::Append(const uint8_t* data, const size_t length)
+{
+  Discard(mConsumed);
+  mConsumed = 0;
+  const size_t taken = std::min(length, sizeof(mBuffer) - mFill);
+  if (taken > 0)
+  {
+    std::memcpy(&mBuffer[mFill], data, taken);
+    mFill += taken;
+  }
+  return taken;
+}
+
+bool FrameDecoder::Extract(CommandFrame& frame)
+{
+  Discard(mConsumed);
+  mConsumed = 0;
+  while (mFill > 0)
+  {
+    if (mBuffer[0] != FRAME_SYNC)
+    {
+      const auto* sync = static_cast<const uint8_t*>(std::memchr(mBuffer, FRAME_SYNC, mFill));
+      const size_t skip = sync ? static_cast<size_t>(sync - mBuffer) : mFill;
+      mStatistics.skipped += skip;
+      Discard(skip);
+      continue;
+    }
+    if (mFill < FRAME_HEADER_SIZE)
+    {
+      return false;
+    }
+    const size_t length = mBuffer[2] | (static_cast<size_t>(mBuffer[3]) << 8);
+    if (length > FRAME_MAX_PAYLOAD)
+    {
+      ++mStatistics.corrupted;
+      Discard(1);  // Not a frame start after all, resynchronize.
+      continue;
+    }
+    const size_t frameSize = FRAME_HEADER_SIZE + length + FRAME_TRAILER_SIZE;
+    if (mFill < frameSize)
+    {
+      return false;  // Wait for the remaining fragments.
+    }
+    const uint16_t crc = mBuffer[FRAME_HEADER_SIZE + length] |
+                         (static_cast<uint16_t>(mBuffer[FRAME_HEADER_SIZE + length + 1]) << 8);
+    if (Crc16(&mBuffer[1], FRAME_HEADER_SIZE - 1 + length) != crc)
+    {
+      ++mStatistics.corrupted;
+      Discard(1);
+      continue;
+    }
+    ++mStatistics.frames;
+    frame = {mBuffer[1], &mBuffer[FRAME_HEADER_SIZE], length};
+    mConsumed = frameSize;  // Keep the payload valid until the decoder is used again.
+    return true;
+  }
+  return false;
+}
+
+void FrameDecoder::Discard(const size_t count)
+{
+  if (count == 0)
+  {
+    return;
+  }
+  mFill -= count;
+  std::memmove(mBuffer, &mBuffer[count], mFill);
+}
+}  // namespace Esp32Modules::Connectivity
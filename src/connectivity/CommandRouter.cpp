@@ -0,0 +1,42 @@
+#include "esp32-modules/connectivity/CommandRouter.hpp"
+
+namespace Esp32Modules::Connectivity
+{
+bool CommandRouter::Register(const std::string_view token, Callback callback)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return mTable.Register(token, std::move(callback));
+}
+
+CommandRouter::DispatchResult CommandRouter::Dispatch(const std::string_view command)
+{
+  return Dispatch(ParseCommand(command));
+}
+
+CommandRouter::DispatchResult CommandRouter::Dispatch(const CommandView& command)
+{
+  if (command.token.empty())
+  {
+    mUnknown.fetch_add(1, std::memory_order_relaxed);
+    return DispatchResult::EMPTY_COMMAND;
+  }
+  Callback* callback{nullptr};
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    callback = mTable.Find(command.token);
+  }
+  if (not callback)
+  {
+    mUnknown.fetch_add(1, std::memory_order_relaxed);
+    return DispatchResult::UNKNOWN_COMMAND;
+  }
+  (*callback)(command.parameters);  // Stays valid, callbacks are never removed.
+  mDispatched.fetch_add(1, std::memory_order_relaxed);
+  return DispatchResult::OK;
+}
+
+CommandRouter::Statistics CommandRouter::GetStatistics() const
+{
+  return {mDispatched.load(std::memory_order_relaxed), mUnknown.load(std::memory_order_relaxed)};
+}
+}  // namespace Esp32Modules::Connectivity
@@ -0,0 +1,49 @@
+#include "esp32-modules/connectivity/CommandTable.hpp"
+
+// Standard header
+#include <algorithm>
+
+namespace Esp32Modules::Connectivity
+{
+CommandView ParseCommand(const std::string_view command)
+{
+  const auto splitPos = command.find(' ');
+  if (splitPos == std::string_view::npos)
+  {
+    return {command, {}};
+  }
+  return {command.substr(0, splitPos), command.substr(splitPos + 1)};
+}
+
+bool CommandTable::Register(const std::string_view token, Callback callback)
+{
+  if (Find(token))
+  {
+    return false;
+  }
+  mCommands.push_front({std::string{token}, std::move(callback)});
+  const IndexEntry entry{HashToken(token), &mCommands.front()};
+  // Tokens with colliding hashes are kept next to each other (upper bound keeps the order).
+  const auto position = std::upper_bound(
+      mIndex.begin(), mIndex.end(), entry.hash,
+      [](const uint32_t hash, const IndexEntry& other) { return hash < other.hash; });
+  mIndex.insert(position, entry);
+  return true;
+}
+
+CommandTable::Callback* CommandTable::Find(const std::string_view token)
+{
+  const uint32_t hash = HashToken(token);
+  auto it = std::lower_bound(
+      mIndex.begin(), mIndex.end(), hash,
+      [](const IndexEntry& entry, const uint32_t value) { return entry.hash < value; });
+  for (; it != mIndex.end() and it->hash == hash; ++it)
+  {
+    if (it->command->token == token)
+    {
+      return &it->command->callback;
+    }
+  }
+  return nullptr;
+}
+}  // namespace Esp32Modules::Connectivity
@@ -0,0 +1,156 @@
+#include "esp32-modules/connectivity/ConnectionManager.hpp"
+
+// Standard header
+#include <algorithm>
+
+namespace Esp32Modules::Connectivity::BluetoothLE
+{
+namespace
+{
+/** Bits of the link events signaled by the BLE stack. */
+constexpr uint8_t LINK_CONNECTED{0x01};
+constexpr uint8_t LINK_DISCONNECTED{0x02};
+}  // namespace
+
+ConnectionManager::ConnectionManager(AdvertisingFunction advertise,
+                                     const AdvertisingConfig& config, Core::Time::Clock* clock)
+    : mAdvertise{std::move(advertise)},
+      mConfig{config},
+      mClock{clock ? *clock : Core::Time::GetSystemClock()},
+      mStateCallback{},
+      mLinkUp{false},
+      mLinkEvents{0},
+      mDisconnectTime{0},
+      mState{ConnectionState::IDLE},
+      mInterval{config.minInterval},
+      mIntervalStart{0},
+      mStatistics{}
+{
+}
+
+void ConnectionManager::Start()
+{
+  if (mState == ConnectionState::IDLE)
+  {
+    Advertise(mConfig.minInterval);
+    Transition(ConnectionState::ADVERTISING);
+  }
+}
+
+void ConnectionManager::OnConnect()
+{
+  mLinkUp.store(true);
+  mLinkEvents.fetch_or(LINK_CONNECTED);
+}
+
+void ConnectionManager::OnDisconnect()
+{
+  mDisconnectTime.store(mClock.Millis());
+  mLinkUp.store(false);
+  mLinkEvents.fetch_or(LINK_DISCONNECTED);
+}
+
+void ConnectionManager::Update()
+{
+  if (mState == ConnectionState::IDLE)
+  {
+    return;
+  }
+  const uint8_t events = mLinkEvents.exchange(0);
+  const bool linkUp = mLinkUp.load();
+  if (events & LINK_CONNECTED)
+  {
+    ++mStatistics.connects;
+  }
+  if (events & LINK_DISCONNECTED)
+  {
+    ++mStatistics.disconnects;
+    if (mState != ConnectionState::CONNECTED)
+    {
+      Transition(ConnectionState::CONNECTED);  // Connected and disconnected since the last update.
+    }
+    Transition(ConnectionState::DISCONNECTED);
+  }
+  if (linkUp)
+  {
+    if (mState != ConnectionState::CONNECTED)
+    {
+      Transition(ConnectionState::CONNECTED);  // The stack stops advertising on its own.
+    }
+    return;
+  }
+  if (mState == ConnectionState::CONNECTED)
+  {
+    return;  // Disconnected right now, the event is processed with the next update.
+  }
+
+  const uint32_t now = mClock.Millis();
+  if (mState == ConnectionState::DISCONNECTED)
+  {
+    const uint32_t disconnectTime = mDisconnectTime.load();
+    if (now - disconnectTime < mConfig.restartDelay)
+    {
+      return;
+    }
+    Advertise(mConfig.minInterval);
+    mStatistics.readvertiseDelay = now - disconnectTime;
+    Transition(ConnectionState::ADVERTISING);
+  }
+  else if (mInterval < mConfig.maxInterval and now - mIntervalStart >= mConfig.backoffStep)
+  {
+    Advertise(static_cast<uint16_t>(
+        std::min<uint32_t>(static_cast<uint32_t>(mInterval) * 2, mConfig.maxInterval)));
+  }
+}
+
+uint32_t ConnectionManager::TimeUntilUpdate() const
+{
+  if (mState == ConnectionState::IDLE)
+  {
+    return NO_UPDATE_DUE;
+  }
+  if (mLinkEvents.load() != 0)
+  {
+    return 0;
+  }
+  uint32_t elapsed{0};
+  uint32_t wait{0};
+  if (mState == ConnectionState::DISCONNECTED)
+  {
+    elapsed = mClock.Millis() - mDisconnectTime.load();
+    wait = mConfig.restartDelay;
+  }
+  else if (mState == ConnectionState::ADVERTISING and mInterval < mConfig.maxInterval)
+  {
+    elapsed = mClock.Millis() - mIntervalStart;
+    wait = mConfig.backoffStep;
+  }
+  else
+  {
+    return NO_UPDATE_DUE;
+  }
+  return (elapsed < wait) ? wait - elapsed : 0;
+}
+
+void ConnectionManager::SetStateCallback(StateCallback callback)
+{
+  mStateCallback = std::move(callback);
+}
+
+void ConnectionManager::Transition(const ConnectionState state)
+{
+  mState = state;
+  if (mStateCallback)
+  {
+    mStateCallback(state);
+  }
+}
+
+void ConnectionManager::Advertise(const uint16_t interval)
+{
+  mInterval = interval;
+  mIntervalStart = mClock.Millis();
+  mAdvertise(interval);
+}
+
+}  // namespace Esp32Modules::Connectivity::BluetoothLE
@@ -0,0 +1,179 @@
+#include "esp32-modules/connectivity/EventHub.hpp"
+
+// Standard header
+#include <algorithm>
+#include <cstring>
+
+namespace Esp32Modules::Connectivity::Http
+{
+EventHub::EventHub(const size_t queueLength, const size_t maxSubscribers)
+    : mMutex{}, mSubscribers{}, mNextId{1}, mNextEventId{1}, mStatistics{}
+{
+  mSubscribers.resize(maxSubscribers);
+  for (auto& subscriber : mSubscribers)
+  {
+    subscriber.id = NO_SUBSCRIBER;
+    subscriber.queue.resize(std::max<size_t>(queueLength, 1));
+    subscriber.head = 0;
+    subscriber.count = 0;
+    subscriber.offset = 0;
+  }
+}
+
+EventHub::SubscriberId EventHub::Subscribe()
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  for (auto& subscriber : mSubscribers)
+  {
+    if (subscriber.id == NO_SUBSCRIBER)
+    {
+      subscriber.id = mNextId;
+      // Identifiers are not reused soon, so a removed subscriber cannot read the queue of others.
+      mNextId = (mNextId + 1 == NO_SUBSCRIBER ? 1 : mNextId + 1);
+      return subscriber.id;
+    }
+  }
+  return NO_SUBSCRIBER;
+}
+
+void EventHub::Unsubscribe(const SubscriberId id)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (auto* subscriber = Find(id))
+  {
+    Release(*subscriber);
+  }
+}
+
+bool EventHub::IsSubscribed(const SubscriberId id) const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return std::any_of(mSubscribers.begin(), mSubscribers.end(), [id](const Subscriber& subscriber) {
+    return id != NO_SUBSCRIBER and subscriber.id == id;
+  });
+}
+
+size_t EventHub::Publish(const std::string_view data, const std::string_view event)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  const uint32_t eventId = mNextEventId++;
+  ++mStatistics.published;
+  if (std::none_of(mSubscribers.begin(), mSubscribers.end(),
+                   [](const Subscriber& subscriber) { return subscriber.id != NO_SUBSCRIBER; }))
+  {
+    return 0;  // Not even serialized.
+  }
+
+  // Serialized once for all subscribers.
+  std::string serialized{"id: "};
+  serialized.reserve(data.size() + event.size() + 32);
+  serialized += std::to_string(eventId);
+  serialized += '\n';
+  if (not event.empty())
+  {
+    serialized += "event: ";
+    serialized += event;
+    serialized += '\n';
+  }
+  size_t lineStart{0};
+  do
+  {
+    const auto lineEnd = std::min(data.find('\n', lineStart), data.size());
+    serialized += "data: ";
+    serialized += data.substr(lineStart, lineEnd - lineStart);
+    serialized += '\n';
+    lineStart = lineEnd + 1;
+  } while (lineStart <= data.size());
+  serialized += '\n';
+  const auto shared = std::make_shared<const std::string>(std::move(serialized));
+
+  size_t queued{0};
+  for (auto& subscriber : mSubscribers)
+  {
+    if (subscriber.id == NO_SUBSCRIBER)
+    {
+      continue;
+    }
+    if (subscriber.count == subscriber.queue.size())
+    {
+      Release(subscriber);  // Too slow, dropped.
+      ++mStatistics.dropped;
+      continue;
+    }
+    subscriber.queue[(subscriber.head + subscriber.count) % subscriber.queue.size()] = shared;
+    ++subscriber.count;
+    ++queued;
+  }
+  return queued;
+}
+
+size_t EventHub::Read(const SubscriberId id, uint8_t* buffer, const size_t capacity)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  auto* subscriber = Find(id);
+  if (not subscriber)
+  {
+    return 0;
+  }
+  size_t length{0};
+  while (subscriber->count > 0 and length < capacity)
+  {
+    auto& event = subscriber->queue[subscriber->head];
+    const size_t chunk = std::min(capacity - length, event->size() - subscriber->offset);
+    std::memcpy(buffer + length, event->data() + subscriber->offset, chunk);
+    length += chunk;
+    subscriber->offset += chunk;
+    if (subscriber->offset == event->size())
+    {
+      event.reset();
+      subscriber->head = (subscriber->head + 1) % subscriber->queue.size();
+      --subscriber->count;
+      subscriber->offset = 0;
+      ++mStatistics.delivered;
+    }
+  }
+  return length;
+}
+
+size_t EventHub::GetSubscriberCount() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return std::count_if(mSubscribers.begin(), mSubscribers.end(),
+                       [](const Subscriber& subscriber) { return subscriber.id != NO_SUBSCRIBER; });
+}
+
+EventHub::Statistics EventHub::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  return mStatistics;
+}
+
+EventHub::Subscriber* EventHub::Find(const SubscriberId id)
+{
+  if (id == NO_SUBSCRIBER)
+  {
+    return nullptr;
+  }
+  for (auto& subscriber : mSubscribers)
+  {
+    if (subscriber.id == id)
+    {
+      return &subscriber;
+    }
+  }
+  return nullptr;
+}
+
+void EventHub::Release(Subscriber& subscriber)
+{
+  subscriber.id = NO_SUBSCRIBER;
+  for (auto& event : subscriber.queue)
+  {
+    event.reset();
+  }
+  subscriber.head = 0;
+  subscriber.count = 0;
+  subscriber.offset = 0;
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
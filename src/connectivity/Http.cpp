@@ -1,40 +1,639 @@
 #include "esp32-modules/connectivity/Http.hpp"
 
+// Standard header
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Platform header
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+
+// Project header
+#include <esp32-modules/core/time/Clock.hpp>
+
 namespace Esp32Modules::Connectivity::Http
 {
+namespace
+{
+/**
+ * @brief Stream passing everything written to it on to a chunk sink.
+ */
+class SinkStream : public Stream
+{
+ public:
+  explicit SinkStream(const ChunkSink& sink) : mBody{sink} {}
+  ~SinkStream() = default;
+
+  size_t write(const uint8_t* data, size_t length) override { return mBody.Write(data, length); }
+  size_t write(uint8_t value) override { return write(&value, 1); }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+
+  /** Number of bytes passed on to the sink. */
+  size_t GetWritten() const { return mBody.GetWritten(); }
+
+ private:
+  BodySink mBody;
+};
+
+/** Durations of opening a connection in microseconds. */
+struct ConnectTimes
+{
+  uint32_t dns{0};      //!< Resolving the host.
+  uint32_t connect{0};  //!< Opening the connection (including the TLS handshake).
+};
+
+/**
+ * @brief Pooled connection of the client: a (secure) socket with an HTTPClient on top.
+ */
+class ArduinoTransport : public HttpTransport
+{
+ public:
+  /**
+   * @brief Sets up the (not yet connected) socket to the origin.
+   *
+   * @param origin Origin to connect to.
+   * @param caCert Root certificate to verify HTTPS servers with - nullptr to not verify.
+   */
+  ArduinoTransport(const HttpOrigin& origin, const char* caCert)
+      : mOrigin{origin}, mCACert{caCert}, mSecureSocket{nullptr}, mTimes{}, mTimesPending{false}
+  {
+    if (origin.secure)
+    {
+      auto socket = std::make_unique<WiFiClientSecure>();
+      if (not caCert)
+      {
+        socket->setInsecure();
+      }
+      mSecureSocket = socket.get();
+      mSocket = std::move(socket);
+    }
+    else
+    {
+      mSocket = std::make_unique<WiFiClient>();
+    }
+    mClient = std::make_unique<HTTPClient>();
+    mClient->setReuse(true);
+  }
+
+  ~ArduinoTransport() override
+  {
+    // The client refers to the socket, so it has to go first.
+    mClient->end();
+    mClient.reset();
+    mSocket->stop();
+  }
+
+  bool Connect() override
+  {
+    // Resolves the host separately (instead of letting the socket do it) to time both steps.
+    auto& clock = Core::Time::GetSystemClock();
+    const uint32_t start = clock.Micros();
+    IPAddress address{};
+    if (not WiFi.hostByName(mOrigin.host.c_str(), address))
+    {
+      return false;
+    }
+    const uint32_t resolved = clock.Micros();
+    // The host is still passed for HTTPS, as it is needed for SNI and to verify the certificate.
+    const int connected =
+        mSecureSocket ? mSecureSocket->connect(address, mOrigin.port, mOrigin.host.c_str(),
+                                               mCACert, nullptr, nullptr)
+                      : mSocket->connect(address, mOrigin.port);
+    mTimes = ConnectTimes{resolved - start, clock.Micros() - resolved};
+    mTimesPending = true;
+    return connected;
+  }
+  bool Begin(const std::string& url) override { return mClient->begin(*mSocket, url.c_str()); }
+  void End() override { mClient->end(); }
+  bool Connected() override { return mSocket->connected(); }
+
+  /** Client to send the request with (between Begin() and End()). */
+  HTTPClient& Client() { return *mClient; }
+
+  /**
+   * Provides the durations of opening the connection, once (for the request that opened it).
+   *
+   * @return true if the connection was opened since the last call, false if it is reused.
+   */
+  bool TakeConnectTimes(ConnectTimes& times)
+  {
+    times = mTimes;
+    return std::exchange(mTimesPending, false);
+  }
+
+ private:
+  const HttpOrigin mOrigin;             //!< Origin connected to.
+  const char* mCACert;                  //!< Root certificate to verify the server with (optional).
+  WiFiClientSecure* mSecureSocket;      //!< Socket if secure (aliasing mSocket), nullptr otherwise.
+  ConnectTimes mTimes;                  //!< Durations of opening the connection.
+  bool mTimesPending;                   //!< Indicates that the durations were not taken yet.
+  std::unique_ptr<HTTPClient> mClient;  //!< Client sending the requests, uses the socket.
+  std::unique_ptr<WiFiClient> mSocket;  //!< Connection to the server.
+};
+
+/** Extracts the host of the URL (without scheme, port and path). */
+std::string_view GetHost(const std::string_view url)
+{
+  const auto schemeEnd = url.find("://");
+  const auto hostStart = (schemeEnd == std::string_view::npos ? 0 : schemeEnd + 3);
+  const auto hostEnd = std::min(url.find_first_of(":/?#", hostStart), url.size());
+  return url.substr(hostStart, hostEnd - hostStart);
+}
 
-HttpClient::HttpClient() : mClient{} {}
+/**
+ * @brief Records a request of the client (if there are metrics of its host).
+ *
+ * @param times Durations of opening the connection - nullptr if a pooled one was reused.
+ * @param start Time the request was started on the (open) connection.
+ */
+void RecordRequest(EndpointMetrics* metrics, const int responseCode, const ConnectTimes* times,
+                   const uint32_t start, const uint32_t responded, const size_t sent,
+                   const size_t received)
+{
+  if (not metrics)
+  {
+    return;
+  }
+  const uint32_t end = Core::Time::GetSystemClock().Micros();
+  metrics->RecordStatus(responseCode);
+  if (times)
+  {
+    metrics->phases[EndpointMetrics::DNS].Record(times->dns);
+    metrics->phases[EndpointMetrics::CONNECT].Record(times->connect);
+  }
+  metrics->phases[EndpointMetrics::REQUEST].Record(responded - start);
+  metrics->phases[EndpointMetrics::TRANSFER].Record(end - responded);
+  metrics->bytesSent.fetch_add(static_cast<uint32_t>(sent), std::memory_order_relaxed);
+  metrics->bytesReceived.fetch_add(static_cast<uint32_t>(received), std::memory_order_relaxed);
+}
+}  // namespace
+
+HttpClient::HttpClient()
+    : mCACert{nullptr},
+      mVerificationRequired{false},
+      mPool{[this](const HttpOrigin& origin) -> std::unique_ptr<HttpTransport> {
+        if (origin.secure and not mCACert and mVerificationRequired)
+        {
+          return nullptr;  // Refuses to talk to an unverified server.
+        }
+        return std::make_unique<ArduinoTransport>(origin, mCACert);
+      }},
+      mMetrics{nullptr}
+{
+}
 
 HttpClient::~HttpClient()
 {
-  // Make sure, no active connection is left.
-  mClient.end();
+  // The pool makes sure, no active connection is left.
+}
+
+int HttpClient::Get(const std::string& url, std::string& result)
+{
+  // Appends the chunks right away instead of buffering the whole body in an Arduino String first.
+  result.clear();
+  return Get(url, BodySink::AppendTo(result));
+}
+
+int HttpClient::Get(const std::string& url, const ChunkSink& sink)
+{
+  return Send("GET", url, RequestBody{}, sink);
+}
+
+int HttpClient::Get(const std::string& url, Filesystem::RegularFile& file)
+{
+  auto* metrics = (mMetrics ? mMetrics->Get(HttpMetrics::Side::CLIENT, GetHost(url)) : nullptr);
+  auto& clock = Core::Time::GetSystemClock();
+  auto* transport = static_cast<ArduinoTransport*>(mPool.Acquire(url));
+  const uint32_t start = clock.Micros();
+  if (not transport)
+  {
+    RecordRequest(metrics, HTTPC_ERROR_CONNECTION_REFUSED, nullptr, start, start, 0, 0);
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  ConnectTimes times{};
+  const bool opened = transport->TakeConnectTimes(times);
+  auto* client = &transport->Client();
+  auto responseCode = client->GET();
+  const uint32_t responded = clock.Micros();
+  size_t received{0};
+  if (responseCode >= 200 and responseCode < 300)
+  {
+    File destination = file.OpenForWriting();
+    const int written =
+        destination ? client->writeToStream(&destination) : HTTPC_ERROR_STREAM_WRITE;
+    if (written < 0)
+    {
+      responseCode = written;
+    }
+    else
+    {
+      received = static_cast<size_t>(written);
+    }
+    destination.close();
+  }
+  mPool.Release(*transport);
+  RecordRequest(metrics, responseCode, opened ? &times : nullptr, start, responded, 0, received);
+  return responseCode;
 }
 
-int HttpClient::Get(const std::string url, std::string& result)
+int HttpClient::Send(const char* method, const std::string& url, const RequestBody& body,
+                     const ChunkSink& sink, const HttpHeaders& headers,
+                     HttpHeaders* responseHeaders)
 {
-  mClient.begin(url.c_str());
-  const auto responseCode = mClient.GET();
+  auto* metrics = (mMetrics ? mMetrics->Get(HttpMetrics::Side::CLIENT, GetHost(url)) : nullptr);
+  auto& clock = Core::Time::GetSystemClock();
+  auto* transport = static_cast<ArduinoTransport*>(mPool.Acquire(url));
+  const uint32_t start = clock.Micros();
+  if (not transport)
+  {
+    RecordRequest(metrics, HTTPC_ERROR_CONNECTION_REFUSED, nullptr, start, start, 0, 0);
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  ConnectTimes times{};
+  const bool opened = transport->TakeConnectTimes(times);
+  auto* client = &transport->Client();
+  for (const auto& header : headers)
+  {
+    client->addHeader(header.first.c_str(), header.second.c_str());
+  }
+  // Always set, as the pooled client keeps the names of previous requests otherwise.
+  std::vector<const char*> names{};
+  if (responseHeaders)
+  {
+    names.reserve(responseHeaders->size());
+    for (const auto& header : *responseHeaders)
+    {
+      names.push_back(header.first.c_str());
+    }
+  }
+  client->collectHeaders(names.data(), names.size());
+
+  // The client does not modify the payload, despite taking it as non-const.
+  auto responseCode =
+      body.GetStream()
+          ? client->sendRequest(method, body.GetStream(), body.GetLength())
+          : client->sendRequest(method, const_cast<uint8_t*>(body.GetData()), body.GetLength());
+  const uint32_t responded = clock.Micros();
+  SinkStream stream{sink};
   if (responseCode > 0)
   {
-    const auto raw = mClient.getString();
-    result = {raw.begin(), raw.end()};
+    if (responseHeaders)
+    {
+      for (auto& header : *responseHeaders)
+      {
+        header.second = client->header(header.first.c_str()).c_str();
+      }
+    }
+    const int written = client->writeToStream(&stream);
+    if (written < 0)
+    {
+      responseCode = written;
+    }
   }
-  mClient.end();
+  mPool.Release(*transport);
+  RecordRequest(metrics, responseCode, opened ? &times : nullptr, start, responded,
+                body.GetLength(), stream.GetWritten());
   return responseCode;
 }
 
-HttpServer::HttpServer(const uint16_t port) : mServer{port} {}
+int HttpClient::Post(const std::string& url, const RequestBody& body, const ChunkSink& sink,
+                     const HttpHeaders& headers, HttpHeaders* responseHeaders)
+{
+  return Send("POST", url, body, sink, headers, responseHeaders);
+}
+
+int HttpClient::Put(const std::string& url, const RequestBody& body, const ChunkSink& sink,
+                    const HttpHeaders& headers, HttpHeaders* responseHeaders)
+{
+  return Send("PUT", url, body, sink, headers, responseHeaders);
+}
+
+int HttpClient::Patch(const std::string& url, const RequestBody& body, const ChunkSink& sink,
+                      const HttpHeaders& headers, HttpHeaders* responseHeaders)
+{
+  return Send("PATCH", url, body, sink, headers, responseHeaders);
+}
+
+int HttpClient::Delete(const std::string& url, const ChunkSink& sink, const HttpHeaders& headers,
+                       HttpHeaders* responseHeaders)
+{
+  return Send("DELETE", url, RequestBody{}, sink, headers, responseHeaders);
+}
+
+void HttpClient::SetCACertificate(const char* caCert) { mCACert = caCert; }
+
+void HttpClient::SetVerificationRequired(const bool required) { mVerificationRequired = required; }
+
+HttpConnectionPool::Statistics HttpClient::GetConnectionStatistics() const
+{
+  return mPool.GetStatistics();
+}
+
+/**
+ * @brief Dispatches requests matching any route of the server to its callbacks.
+ *
+ * Requests are matched again for each step, which is cheaper than keeping the match per request.
+ */
+class HttpServer::RouteHandler : public AsyncWebHandler
+{
+ public:
+  explicit RouteHandler(const HttpServer& server) : mServer{server} {}
+  ~RouteHandler() = default;
+
+  bool canHandle(AsyncWebServerRequest* request) override
+  {
+    RouteMatch match{};
+    if (not mServer.FindRoute(request, match))
+    {
+      return false;
+    }
+    request->addInterestingHeader("ANY");  // Otherwise, the server drops the headers.
+    return true;
+  }
+
+  void handleRequest(AsyncWebServerRequest* request) override
+  {
+    RouteMatch match{};
+    const auto* route = mServer.FindRoute(request, match);
+    if (not route)
+    {
+      request->send(404);
+      return;
+    }
+    const HttpRequest view{*request, match};
+    mServer.Respond(request, route->pattern,
+                    [&view, route](HttpResponse& response) { route->request(view, response); });
+  }
+
+  void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t length, size_t index,
+                  size_t total) override
+  {
+    RouteMatch match{};
+    const auto* route = mServer.FindRoute(request, match);
+    if (route and route->body)
+    {
+      route->body(HttpRequest{*request, match}, data, length, index, total);
+    }
+  }
+
+  bool isRequestHandlerTrivial() override { return false; }
+
+ private:
+  const HttpServer& mServer;  //!< Server providing the routes.
+};
+
+HttpServer::HttpServer(const uint16_t port, const size_t cacheSize)
+    : mServer{port},
+      mRouter{},
+      mRoutes{},
+      mRouting{false},
+      mCache{cacheSize},
+      mMetrics{nullptr}
+{
+}
 
 HttpServer::~HttpServer() {}
 
 void HttpServer::SetCallback(const std::string& path, const WebRequestMethod methodType,
                              const OnRequestWithoutParams& cb)
 {
-  mServer.on(path.c_str(), methodType, [cb](AsyncWebServerRequest* request) {
-    const auto response = cb();
-    request->send_P(200, "text/plain", response.c_str());
+  SetCallback(path, methodType, OnRequest{[cb](HttpResponse& response) { response.Send(cb()); }});
+}
+
+void HttpServer::SetCallback(const std::string& path, const WebRequestMethod methodType,
+                             const OnRequest& cb)
+{
+  mServer.on(path.c_str(), methodType,
+             [this, path, cb](AsyncWebServerRequest* request) { Respond(request, path, cb); });
+}
+
+bool HttpServer::SetRoute(const std::string& pattern, const WebRequestMethodComposite methods,
+                          OnRoutedRequest cb, OnBodyChunk bodyCb)
+{
+  const auto route = mRouter.Add(pattern);
+  if (route == PathRouter::NO_ROUTE)
+  {
+    return false;
+  }
+  if (route == mRoutes.size())
+  {
+    mRoutes.emplace_back();
+  }
+  mRoutes[route].push_back({pattern, methods, std::move(cb), std::move(bodyCb)});
+  if (not mRouting)
+  {
+    // A single handler serves all routes, so the server does not try them one by one.
+    mServer.addHandler(new RouteHandler{*this});
+    mRouting = true;
+  }
+  return true;
+}
+
+bool HttpServer::SetCachedRoute(const std::string& pattern, OnRoutedRequest cb,
+                                const std::atomic<uint32_t>& version)
+{
+  return SetRoute(pattern, HTTP_GET,
+                  [this, cb = std::move(cb), &version](const HttpRequest& request,
+                                                       HttpResponse& response) {
+                    ServeCached(request, response, cb, version.load());
+                  });
+}
+
+const HttpServer::RouteCallbacks* HttpServer::FindRoute(AsyncWebServerRequest* request,
+                                                        RouteMatch& match) const
+{
+  const auto& url = request->url();
+  if (not mRouter.Match(std::string_view{url.c_str(), url.length()}, match))
+  {
+    return nullptr;
+  }
+  for (const auto& callbacks : mRoutes[match.route])
+  {
+    if (callbacks.methods & request->method())
+    {
+      return &callbacks;
+    }
+  }
+  return nullptr;
+}
+
+void HttpServer::Respond(AsyncWebServerRequest* request, const std::string_view endpoint,
+                         const OnRequest& cb) const
+{
+  auto* metrics = (mMetrics ? mMetrics->Get(HttpMetrics::Side::SERVER, endpoint) : nullptr);
+  HttpResponse response{};
+  if (not metrics)
+  {
+    cb(response);
+    response.SendTo(request);
+    return;
+  }
+
+  auto& clock = Core::Time::GetSystemClock();
+  const uint32_t start = clock.Micros();
+  cb(response);
+  metrics->phases[EndpointMetrics::HANDLER].Record(clock.Micros() - start);
+  metrics->RecordStatus(response.mStatus);
+  metrics->bytesReceived.fetch_add(static_cast<uint32_t>(request->contentLength()),
+                                   std::memory_order_relaxed);
+  // The connection is closed once the response was transmitted.
+  request->onDisconnect([metrics, start]() {
+    metrics->phases[EndpointMetrics::TOTAL].Record(Core::Time::GetSystemClock().Micros() - start);
+  });
+  response.SendTo(request, &metrics->bytesSent);
+}
+
+void HttpServer::ServeCached(const HttpRequest& request, HttpResponse& response,
+                             const OnRoutedRequest& cb, const uint32_t version)
+{
+  const auto key = request.GetPath();
+  const auto* entry = mCache.Find(key, version);
+  if (not entry)
+  {
+    cb(request, response);
+    if (response.mStatus != 200 or response.mSource or not response.mBody)
+    {
+      return;
+    }
+    entry = mCache.Store(key, version, response.mContentType, response.mBody);
+    if (not entry)
+    {
+      return;  // Too large to be cached.
+    }
+  }
+  response.AddHeader("ETag", entry->etag);
+  response.AddHeader("Cache-Control", "no-cache");  // Clients revalidate on each use.
+
+  std::string_view ifNoneMatch{};
+  if (request.GetHeader("If-None-Match", ifNoneMatch) and
+      ResponseCache::MatchesETag(ifNoneMatch, entry->etag))
+  {
+    response.mStatus = 304;
+    response.mBody.reset();
+    return;
+  }
+  response.mStatus = 200;
+  response.mContentType = entry->contentType;
+  response.mBody = entry->body;
+}
+
+void HttpServer::SetEventRoute(const std::string& path, EventHub& hub)
+{
+  mServer.on(path.c_str(), HTTP_GET, [&hub](AsyncWebServerRequest* request) {
+    const auto id = hub.Subscribe();
+    if (id == EventHub::NO_SUBSCRIBER)
+    {
+      request->send(503);
+      return;
+    }
+    request->onDisconnect([&hub, id]() { hub.Unsubscribe(id); });
+
+    HttpResponse response{};
+    response.SetContentType("text/event-stream");
+    response.AddHeader("Cache-Control", "no-cache");
+    response.Stream([&hub, id](uint8_t* buffer, const size_t capacity) {
+      const size_t length = hub.Read(id, buffer, capacity);
+      if (length == 0 and hub.IsSubscribed(id))
+      {
+        return HttpResponse::TRY_AGAIN;  // Keeps the stream open until the next event.
+      }
+      return length;  // Ends the stream once dropped.
+    });
+    response.SendTo(request);
+  });
+}
+
+void HttpServer::SetStaticRoute(const std::string& prefix, fs::FS& fs, const std::string& root,
+                                const std::string& cacheControl)
+{
+  mServer.addHandler(new StaticFileHandler{prefix, fs, root, cacheControl});
+}
+
+void HttpServer::EnableMetrics(HttpMetrics& metrics, const std::string& path)
+{
+  mMetrics = &metrics;
+  if (path.empty())
+  {
+    return;
+  }
+  mServer.on(path.c_str(), HTTP_GET, [&metrics](AsyncWebServerRequest* request) {
+    HttpResponse response{};
+    response.SetContentType("text/plain; version=0.0.4");
+    // Renders the next piece whenever the previous one was transmitted completely.
+    response.Stream([&metrics, cursor = size_t{0}, piece = std::string{}, offset = size_t{0}](
+                        uint8_t* buffer, const size_t capacity) mutable {
+      size_t length{0};
+      while (length < capacity)
+      {
+        if (offset == piece.size())
+        {
+          piece.clear();
+          offset = 0;
+          if (not metrics.Render(cursor, piece))
+          {
+            break;
+          }
+        }
+        const size_t chunk = std::min(capacity - length, piece.size() - offset);
+        std::memcpy(buffer + length, piece.data() + offset, chunk);
+        length += chunk;
+        offset += chunk;
+      }
+      return length;
+    });
+    response.SendTo(request);
   });
 }
 
+void HttpServer::SetCommandRoute(const std::string& path, CommandRouter& router)
+{
+  // The body handler runs before the request handler, which sends the status determined here.
+  mServer.on(
+      path.c_str(), HTTP_POST,
+      [](AsyncWebServerRequest* request) {
+        const auto* status = static_cast<const int*>(request->_tempObject);
+        request->send(status ? *status : 400);
+      },
+      nullptr,
+      [&router](AsyncWebServerRequest* request, uint8_t* data, const size_t length,
+                const size_t index, const size_t total) {
+        if (request->_tempObject)
+        {
+          return;  // Already rejected.
+        }
+        // Freed by the request (with free()).
+        auto* status = static_cast<int*>(malloc(sizeof(int)));
+        if (not status)
+        {
+          return;
+        }
+        *status = 413;
+        if (index == 0 and length == total)
+        {
+          using DispatchResult = CommandRouter::DispatchResult;
+          switch (router.Dispatch(std::string_view{reinterpret_cast<const char*>(data), length}))
+          {
+            case DispatchResult::OK:
+              *status = 200;
+              break;
+            case DispatchResult::UNKNOWN_COMMAND:
+              *status = 404;
+              break;
+            case DispatchResult::EMPTY_COMMAND:
+              *status = 400;
+              break;
+          }
+        }
+        request->_tempObject = status;
+      });
+}
+
 }  // namespace Esp32Modules::Connectivity::Http
\ No newline at end of file
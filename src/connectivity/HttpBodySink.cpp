@@ -0,0 +1,23 @@
+#include "esp32-modules/connectivity/HttpBodySink.hpp"
+
+namespace Esp32Modules::Connectivity::Http
+{
+size_t BodySink::Write(const uint8_t* data, const size_t length)
+{
+  // Taking less aborts the transfer, without a sink the body is drained to keep the connection.
+  if (mSink and not mSink(data, length))
+  {
+    return 0;
+  }
+  mWritten += length;
+  return length;
+}
+
+ChunkSink BodySink::AppendTo(std::string& result)
+{
+  return [&result](const uint8_t* data, const size_t length) {
+    result.append(reinterpret_cast<const char*>(data), length);
+    return true;
+  };
+}
+}  // namespace Esp32Modules::Connectivity::Http
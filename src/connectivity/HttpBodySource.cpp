@@ -0,0 +1,61 @@
+#include "esp32-modules/connectivity/HttpBodySource.hpp"
+
+// Standard header
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace Esp32Modules::Connectivity::Http
+{
+BodySource::BodySource(ChunkSource source, const size_t length,
+                       std::atomic<uint32_t>* sentBytes)
+    : mSource{std::move(source)},
+      mBody{},
+      mLength{length},
+      mProduced{0},
+      mSentBytes{sentBytes}
+{
+}
+
+BodySource::BodySource(std::shared_ptr<const std::string> body, std::atomic<uint32_t>* sentBytes)
+    : mSource{}, mBody{std::move(body)}, mLength{0}, mProduced{0}, mSentBytes{sentBytes}
+{
+  mLength = (mBody ? mBody->size() : 0);
+}
+
+size_t BodySource::Fill(uint8_t* buffer, const size_t capacity)
+{
+  if (mProduced >= mLength)
+  {
+    return 0;  // Complete (or ended by the source before).
+  }
+  const size_t room =
+      (mLength == UNKNOWN_LENGTH ? capacity : std::min(capacity, mLength - mProduced));
+  size_t length{0};
+  if (mBody)
+  {
+    length = room;
+    std::memcpy(buffer, mBody->data() + mProduced, length);
+  }
+  else if (mSource)
+  {
+    length = mSource(buffer, room);
+    if (length == TRY_AGAIN)
+    {
+      return TRY_AGAIN;
+    }
+    if (length == 0)
+    {
+      mLength = mProduced;  // Ended, the source is not executed again.
+      return 0;
+    }
+    length = std::min(length, room);
+  }
+  mProduced += length;
+  if (mSentBytes)
+  {
+    mSentBytes->fetch_add(static_cast<uint32_t>(length), std::memory_order_relaxed);
+  }
+  return length;
+}
+}  // namespace Esp32Modules::Connectivity::Http
@@ -0,0 +1,181 @@
+#include "esp32-modules/connectivity/HttpConnectionPool.hpp"
+
+// Standard header
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace Esp32Modules::Connectivity::Http
+{
+bool ParseOrigin(const std::string_view url, HttpOrigin& origin)
+{
+  const auto schemeEnd = url.find("://");
+  if (schemeEnd == std::string_view::npos)
+  {
+    return false;
+  }
+  const auto scheme = url.substr(0, schemeEnd);
+  if (scheme != "http" and scheme != "https")
+  {
+    return false;
+  }
+  origin.secure = (scheme == "https");
+  const auto hostStart = schemeEnd + 3;
+  const auto hostEnd = std::min(url.find_first_of(":/?#", hostStart), url.size());
+  origin.host = std::string{url.substr(hostStart, hostEnd - hostStart)};
+  origin.port = (origin.secure ? 443 : 80);
+  if (hostEnd < url.size() and url[hostEnd] == ':')
+  {
+    const auto portEnd = std::min(url.find_first_of("/?#", hostEnd), url.size());
+    uint32_t port{0};
+    const auto* end = url.data() + portEnd;
+    const auto result = std::from_chars(url.data() + hostEnd + 1, end, port);
+    if (result.ec != std::errc{} or result.ptr != end or port == 0 or port > 0xFFFF)
+    {
+      return false;
+    }
+    origin.port = static_cast<uint16_t>(port);
+  }
+  return not origin.host.empty();
+}
+
+HttpConnectionPool::HttpConnectionPool(TransportFactory factory, const uint32_t idleTimeout,
+                                       Core::Time::Clock* clock)
+    : mFactory{std::move(factory)},
+      mIdleTimeout{idleTimeout},
+      mClock{clock ? *clock : Core::Time::GetSystemClock()},
+      mConnections{},
+      mStatistics{}
+{
+}
+
+HttpConnectionPool::~HttpConnectionPool()
+{
+  for (auto& connection : mConnections)
+  {
+    Close(connection);
+  }
+}
+
+HttpTransport* HttpConnectionPool::Acquire(const std::string& url)
+{
+  HttpOrigin origin{};
+  if (not ParseOrigin(url, origin))
+  {
+    return nullptr;
+  }
+  CloseIdle();
+
+  Connection* match{nullptr};
+  Connection* unused{nullptr};
+  Connection* leastRecentlyUsed{nullptr};
+  for (auto& connection : mConnections)
+  {
+    if (connection.inUse)
+    {
+      continue;
+    }
+    if (connection.origin.host.empty())
+    {
+      unused = &connection;
+    }
+    else if (connection.origin.host == origin.host and connection.origin.port == origin.port and
+             connection.origin.secure == origin.secure)
+    {
+      match = &connection;
+      break;
+    }
+    else if (not leastRecentlyUsed or
+             static_cast<int32_t>(connection.lastUse - leastRecentlyUsed->lastUse) < 0)
+    {
+      leastRecentlyUsed = &connection;
+    }
+  }
+
+  if (match)
+  {
+    ++mStatistics.reused;  // Still connected, otherwise it would have been closed above.
+  }
+  else
+  {
+    match = (unused ? unused : leastRecentlyUsed);
+    if (not match)
+    {
+      return nullptr;  // All connections are in use.
+    }
+    auto transport = mFactory(origin);
+    if (not transport)
+    {
+      return nullptr;  // Keeps the connection to another server.
+    }
+    if (not match->origin.host.empty())
+    {
+      ++mStatistics.closed;  // Make room for the new server.
+    }
+    Close(*match);
+    if (not transport->Connect())
+    {
+      return nullptr;
+    }
+    match->origin = std::move(origin);
+    match->transport = std::move(transport);
+  }
+
+  if (not match->transport->Begin(url))
+  {
+    Close(*match);
+    return nullptr;
+  }
+  match->inUse = true;
+  ++mStatistics.requests;
+  return match->transport.get();
+}
+
+void HttpConnectionPool::Release(HttpTransport& transport)
+{
+  for (auto& connection : mConnections)
+  {
+    if (connection.transport.get() == &transport)
+    {
+      // Keeps the connection open if both sides agreed on keep-alive and the body was read
+      // completely.
+      transport.End();
+      connection.lastUse = mClock.Millis();
+      connection.inUse = false;
+      return;
+    }
+  }
+}
+
+void HttpConnectionPool::CloseIdle()
+{
+  const uint32_t now = mClock.Millis();
+  for (auto& connection : mConnections)
+  {
+    if (not connection.inUse and connection.transport and
+        (now - connection.lastUse >= mIdleTimeout or not connection.transport->Connected()))
+    {
+      ++mStatistics.closed;
+      Close(connection);
+    }
+  }
+}
+
+size_t HttpConnectionPool::GetConnectionCount() const
+{
+  size_t count{0};
+  for (const auto& connection : mConnections)
+  {
+    count += (connection.transport ? 1 : 0);
+  }
+  return count;
+}
+
+void HttpConnectionPool::Close(Connection& connection)
+{
+  connection.transport.reset();  // Closes the connection.
+  connection.origin = HttpOrigin{};
+  connection.inUse = false;
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
@@ -0,0 +1,116 @@
+#include "esp32-modules/connectivity/HttpContent.hpp"
+
+// Standard header
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/** Parses a decimal number taking the whole text, returns false if there is none. */
+bool ParseNumber(const std::string_view text, size_t& value)
+{
+  const auto* end = text.data() + text.size();
+  const auto result = std::from_chars(text.data(), end, value);
+  return not text.empty() and result.ec == std::errc{} and result.ptr == end;
+}
+
+/** MIME types by file extension. */
+constexpr std::pair<std::string_view, const char*> CONTENT_TYPES[]{
+    {".html", "text/html"},
+    {".htm", "text/html"},
+    {".css", "text/css"},
+    {".js", "application/javascript"},
+    {".json", "application/json"},
+    {".txt", "text/plain"},
+    {".log", "text/plain"},
+    {".csv", "text/csv"},
+    {".xml", "text/xml"},
+    {".png", "image/png"},
+    {".jpg", "image/jpeg"},
+    {".jpeg", "image/jpeg"},
+    {".gif", "image/gif"},
+    {".svg", "image/svg+xml"},
+    {".ico", "image/x-icon"},
+    {".woff", "font/woff"},
+    {".woff2", "font/woff2"},
+    {".pdf", "application/pdf"},
+    {".zip", "application/zip"},
+    {".gz", "application/gzip"},
+    {".bin", "application/octet-stream"}};
+}  // namespace
+
+ByteRange ParseByteRange(const std::string_view header, const size_t size, size_t& first,
+                         size_t& last)
+{
+  constexpr std::string_view UNIT{"bytes="};
+  if (header.substr(0, UNIT.size()) != UNIT or header.find(',') != std::string_view::npos)
+  {
+    return ByteRange::FULL;
+  }
+  const auto spec = header.substr(UNIT.size());
+  const auto dash = spec.find('-');
+  if (dash == std::string_view::npos)
+  {
+    return ByteRange::FULL;
+  }
+  const auto start = spec.substr(0, dash);
+  const auto end = spec.substr(dash + 1);
+
+  size_t value{0};
+  if (start.empty())
+  {
+    // Suffix range ("-500" for the last 500 bytes).
+    if (not ParseNumber(end, value))
+    {
+      return ByteRange::FULL;
+    }
+    if (value == 0 or size == 0)
+    {
+      return ByteRange::UNSATISFIABLE;
+    }
+    first = size - std::min(value, size);
+    last = size - 1;
+    return ByteRange::PARTIAL;
+  }
+
+  size_t startValue{0};
+  if (not ParseNumber(start, startValue))
+  {
+    return ByteRange::FULL;
+  }
+  size_t endValue{size > 0 ? size - 1 : 0};
+  if (not end.empty())
+  {
+    if (not ParseNumber(end, value) or value < startValue)
+    {
+      return ByteRange::FULL;
+    }
+    endValue = std::min(value, endValue);
+  }
+  if (startValue >= size)
+  {
+    return ByteRange::UNSATISFIABLE;
+  }
+  first = startValue;
+  last = endValue;
+  return ByteRange::PARTIAL;
+}
+
+const char* GetContentType(const std::string_view path)
+{
+  for (const auto& contentType : CONTENT_TYPES)
+  {
+    const auto& extension = contentType.first;
+    if (path.size() >= extension.size() and
+        path.substr(path.size() - extension.size()) == extension)
+    {
+      return contentType.second;
+    }
+  }
+  return "application/octet-stream";
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
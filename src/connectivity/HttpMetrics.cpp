@@ -0,0 +1,205 @@
+#include "esp32-modules/connectivity/HttpMetrics.hpp"
+
+// Standard header
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/** Metric families, each one rendered for all endpoints before the next one. */
+enum Family : size_t
+{
+  REQUESTS,
+  RESPONSES,
+  BYTES_RECEIVED,
+  BYTES_SENT,
+  DURATION,
+  FAMILY_COUNT
+};
+
+/** Names and types of the families. */
+constexpr const char* FAMILY_HEADERS[FAMILY_COUNT]{
+    "# TYPE http_requests_total counter\n", "# TYPE http_responses_total counter\n",
+    "# TYPE http_received_bytes_total counter\n", "# TYPE http_sent_bytes_total counter\n",
+    "# TYPE http_duration_seconds histogram\n"};
+
+/** Labels of the status classes. */
+constexpr const char* STATUS_CLASSES[EndpointMetrics::STATUS_CLASS_COUNT]{"error", "1xx", "2xx",
+                                                                          "3xx",   "4xx", "5xx"};
+
+/** Number of phases per side. */
+constexpr size_t PHASE_COUNTS[2]{EndpointMetrics::SERVER_PHASE_COUNT,
+                                 EndpointMetrics::CLIENT_PHASE_COUNT};
+
+/** Names of the phases per side. */
+constexpr const char* PHASES[2][EndpointMetrics::PHASE_COUNT]{
+    {"handler", "total"}, {"dns", "connect", "request", "transfer"}};
+
+/** Appends the formatted text. */
+template <typename... Args>
+void Append(std::string& out, const char* format, Args... args)
+{
+  char buffer[48];
+  const int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+  if (length > 0)
+  {
+    out.append(buffer, std::min<size_t>(static_cast<size_t>(length), sizeof(buffer) - 1));
+  }
+}
+
+/** Appends the labels identifying the endpoint (without the closing brace). */
+void AppendLabels(std::string& out, const EndpointMetrics& endpoint)
+{
+  out += (endpoint.side == EndpointMetrics::Side::SERVER ? "{side=\"server\",endpoint=\""
+                                                         : "{side=\"client\",endpoint=\"");
+  for (const char* c = endpoint.label; *c; ++c)
+  {
+    if (*c == '"' or *c == '\\')
+    {
+      out += '\\';
+    }
+    out += *c;
+  }
+  out += '"';
+}
+}  // namespace
+
+void LatencyHistogram::Record(const uint32_t duration)
+{
+  // First bucket whose upper bound is not exceeded (the unbounded one if all are).
+  const auto bucket = std::lower_bound(BOUNDS, BOUNDS + BOUND_COUNT, duration) - BOUNDS;
+  mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  mCount.fetch_add(1, std::memory_order_relaxed);
+  mSum.fetch_add(duration, std::memory_order_relaxed);
+}
+
+void EndpointMetrics::RecordStatus(const int status)
+{
+  const size_t statusClass = (status < 100 or status > 599) ? 0 : static_cast<size_t>(status / 100);
+  requests.fetch_add(1, std::memory_order_relaxed);
+  statusClasses[statusClass].fetch_add(1, std::memory_order_relaxed);
+}
+
+EndpointMetrics* HttpMetrics::Get(const Side side, const std::string_view label)
+{
+  const auto truncated = label.substr(0, ESP32MODULES_HTTP_METRICS_LABEL_LENGTH - 1);
+  const auto find = [this, side, truncated](const size_t count) -> EndpointMetrics* {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (mEndpoints[i].side == side and truncated == mEndpoints[i].label)
+      {
+        return &mEndpoints[i];
+      }
+    }
+    return nullptr;
+  };
+
+  // Endpoints are published by the count (after being set up), so no lock is needed to find one.
+  if (auto* endpoint = find(mCount.load(std::memory_order_acquire)))
+  {
+    return endpoint;
+  }
+  std::lock_guard<std::mutex> lock{mMutex};
+  const size_t count = mCount.load(std::memory_order_relaxed);
+  if (auto* endpoint = find(count))
+  {
+    return endpoint;  // Added concurrently.
+  }
+  if (count == ESP32MODULES_HTTP_MAX_METRICS)
+  {
+    return nullptr;
+  }
+  auto& endpoint = mEndpoints[count];
+  endpoint.side = side;
+  std::memcpy(endpoint.label, truncated.data(), truncated.size());
+  endpoint.label[truncated.size()] = '\0';
+  mCount.store(count + 1, std::memory_order_release);
+  return &endpoint;
+}
+
+bool HttpMetrics::Render(size_t& cursor, std::string& out) const
+{
+  const size_t count = mCount.load(std::memory_order_acquire);
+  size_t family = cursor / ESP32MODULES_HTTP_MAX_METRICS;
+  size_t index = cursor % ESP32MODULES_HTTP_MAX_METRICS;
+  if (index >= count)
+  {
+    ++family;
+    index = 0;
+  }
+  if (family >= FAMILY_COUNT or count == 0)
+  {
+    return false;
+  }
+  cursor = family * ESP32MODULES_HTTP_MAX_METRICS + index + 1;
+
+  if (index == 0)
+  {
+    out += FAMILY_HEADERS[family];
+  }
+  const auto& endpoint = mEndpoints[index];
+  switch (family)
+  {
+    case REQUESTS:
+    case BYTES_RECEIVED:
+    case BYTES_SENT:
+    {
+      const auto& counter = (family == REQUESTS         ? endpoint.requests
+                             : family == BYTES_RECEIVED ? endpoint.bytesReceived
+                                                        : endpoint.bytesSent);
+      out += (family == REQUESTS         ? "http_requests_total"
+              : family == BYTES_RECEIVED ? "http_received_bytes_total"
+                                         : "http_sent_bytes_total");
+      AppendLabels(out, endpoint);
+      Append(out, "} %u\n", static_cast<unsigned>(counter.load(std::memory_order_relaxed)));
+      break;
+    }
+    case RESPONSES:
+      for (size_t i = 0; i < EndpointMetrics::STATUS_CLASS_COUNT; ++i)
+      {
+        out += "http_responses_total";
+        AppendLabels(out, endpoint);
+        Append(out, ",class=\"%s\"} %u\n", STATUS_CLASSES[i],
+               static_cast<unsigned>(endpoint.statusClasses[i].load(std::memory_order_relaxed)));
+      }
+      break;
+    case DURATION:
+      for (size_t phase = 0; phase < PHASE_COUNTS[static_cast<size_t>(endpoint.side)]; ++phase)
+      {
+        const auto& histogram = endpoint.phases[phase];
+        const char* phaseName = PHASES[static_cast<size_t>(endpoint.side)][phase];
+        uint32_t cumulative{0};
+        for (size_t i = 0; i <= LatencyHistogram::BOUND_COUNT; ++i)
+        {
+          cumulative += histogram.GetBucket(i);
+          out += "http_duration_seconds_bucket";
+          AppendLabels(out, endpoint);
+          if (i < LatencyHistogram::BOUND_COUNT)
+          {
+            Append(out, ",phase=\"%s\",le=\"%g\"} %u\n", phaseName,
+                   LatencyHistogram::BOUNDS[i] / 1e6, static_cast<unsigned>(cumulative));
+          }
+          else
+          {
+            Append(out, ",phase=\"%s\",le=\"+Inf\"} %u\n", phaseName,
+                   static_cast<unsigned>(cumulative));
+          }
+        }
+        out += "http_duration_seconds_sum";
+        AppendLabels(out, endpoint);
+        Append(out, ",phase=\"%s\"} %.6f\n", phaseName, histogram.GetSum() / 1e6);
+        out += "http_duration_seconds_count";
+        AppendLabels(out, endpoint);
+        Append(out, ",phase=\"%s\"} %u\n", phaseName, static_cast<unsigned>(cumulative));
+      }
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
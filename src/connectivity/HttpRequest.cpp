@@ -0,0 +1,36 @@
+#include "esp32-modules/connectivity/HttpRequest.hpp"
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/** Refers to the characters of an Arduino string. */
+std::string_view View(const String& string) { return {string.c_str(), string.length()}; }
+}  // namespace
+
+std::string_view HttpRequest::GetPath() const { return View(mRequest.url()); }
+
+bool HttpRequest::GetParameter(const char* name, std::string_view& value) const
+{
+  for (const bool post : {true, false})
+  {
+    if (const auto* parameter = mRequest.getParam(name, post))
+    {
+      value = View(parameter->value());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HttpRequest::GetHeader(const char* name, std::string_view& value) const
+{
+  if (const auto* header = mRequest.getHeader(name))
+  {
+    value = View(header->value());
+    return true;
+  }
+  return false;
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
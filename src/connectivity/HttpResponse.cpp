@@ -0,0 +1,98 @@
+#include "esp32-modules/connectivity/HttpResponse.hpp"
+
+// Standard header
+#include <utility>
+
+namespace Esp32Modules::Connectivity::Http
+{
+HttpResponse::HttpResponse()
+    : mStatus{200},
+      mContentType{"text/plain"},
+      mHeaders{},
+      mBody{},
+      mSource{},
+      mLength{UNKNOWN_LENGTH}
+{
+}
+
+void HttpResponse::SetStatus(const int status) { mStatus = status; }
+
+void HttpResponse::SetContentType(const std::string& contentType) { mContentType = contentType; }
+
+void HttpResponse::AddHeader(const std::string& name, const std::string& value)
+{
+  mHeaders.emplace_back(name, value);
+}
+
+void HttpResponse::Send(std::string body)
+{
+  mBody = std::make_shared<const std::string>(std::move(body));
+  mSource = nullptr;
+}
+
+void HttpResponse::Stream(ChunkSource source, const size_t length)
+{
+  mBody.reset();
+  mSource = std::move(source);
+  mLength = length;
+}
+
+void HttpResponse::Stream(File file)
+{
+  const size_t length = file.size() - file.position();
+  Stream(
+      [file](uint8_t* buffer, const size_t capacity) mutable {
+        const size_t read = file.read(buffer, capacity);
+        if (read == 0)
+        {
+          file.close();
+        }
+        return read;
+      },
+      length);
+}
+
+void HttpResponse::SendTo(AsyncWebServerRequest* request, std::atomic<uint32_t>* sentBytes)
+{
+  static_assert(TRY_AGAIN == RESPONSE_TRY_AGAIN, "Sources have to signal the value of the server");
+
+  // The server asks for the pieces whenever there is room in its TCP buffers.
+  const auto fill = [](BodySource body) {
+    return [body = std::move(body)](uint8_t* buffer, const size_t capacity,
+                                    const size_t) mutable { return body.Fill(buffer, capacity); };
+  };
+
+  AsyncWebServerResponse* response{nullptr};
+  if (mSource)
+  {
+    auto filler = fill(BodySource{std::move(mSource), mLength, sentBytes});
+    response = (mLength == UNKNOWN_LENGTH)
+                   ? request->beginChunkedResponse(mContentType.c_str(), filler)
+                   : request->beginResponse(mContentType.c_str(), mLength, filler);
+  }
+  else if (not mBody or mBody->empty())
+  {
+    // Keeps the content type set by the handler, even without a body (e.g. 204).
+    response = request->beginResponse(mStatus, mContentType.c_str());
+  }
+  else
+  {
+    // Sent straight from the string instead of copying it into the response first.
+    const size_t length = mBody->size();
+    response = request->beginResponse(mContentType.c_str(), length,
+                                      fill(BodySource{std::move(mBody), sentBytes}));
+  }
+  if (not response)
+  {
+    request->send(500);
+    return;
+  }
+  response->setCode(mStatus);
+  for (const auto& header : mHeaders)
+  {
+    response->addHeader(header.first.c_str(), header.second.c_str());
+  }
+  request->send(response);
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
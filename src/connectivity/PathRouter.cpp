@@ -0,0 +1,179 @@
+#include "esp32-modules/connectivity/PathRouter.hpp"
+
+// Standard header
+#include <algorithm>
+#include <tuple>
+
+// Project header
+#include <esp32-modules/connectivity/CommandTable.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/**
+ * @brief Splits the next non-empty segment off the path.
+ *
+ * @param path Remaining path, the segment is removed from it.
+ * @param segment Split off segment.
+ * @return true if there was a segment, false if the path is exhausted.
+ */
+bool NextSegment(std::string_view& path, std::string_view& segment)
+{
+  while (not path.empty() and path.front() == '/')
+  {
+    path.remove_prefix(1);
+  }
+  if (path.empty())
+  {
+    return false;
+  }
+  const auto end = std::min(path.find('/'), path.size());
+  segment = path.substr(0, end);
+  path.remove_prefix(end);
+  return true;
+}
+
+/** Removes the query string (and fragment) from the path. */
+std::string_view StripQuery(const std::string_view path)
+{
+  return path.substr(0, std::min(path.find_first_of("?#"), path.size()));
+}
+}  // namespace
+
+std::string_view RouteMatch::GetCapture(const std::string_view name) const
+{
+  for (size_t i = 0; i < captureCount; ++i)
+  {
+    if (captureNames[i] == name)
+    {
+      return captureValues[i];
+    }
+  }
+  return {};
+}
+
+PathRouter::PathRouter() : mNodes{{NONE, NONE}}, mEdges{}, mRoutes{} {}
+
+size_t PathRouter::Add(const std::string_view pattern)
+{
+  // Validates the pattern before changing the tree.
+  CaptureNames captures{};
+  std::string_view remaining = StripQuery(pattern);
+  std::string_view segment{};
+  while (NextSegment(remaining, segment))
+  {
+    const bool opening = (segment.find('{') != std::string_view::npos);
+    const bool closing = (segment.find('}') != std::string_view::npos);
+    if (not opening and not closing)
+    {
+      continue;
+    }
+    if (segment.size() < 3 or segment.front() != '{' or segment.back() != '}' or
+        captures.size() == ESP32MODULES_HTTP_MAX_CAPTURES)
+    {
+      return NO_ROUTE;  // Partial captures like "id{x}" or "{}" are not supported.
+    }
+    captures.emplace_back(segment.substr(1, segment.size() - 2));
+  }
+
+  uint32_t node{0};
+  remaining = StripQuery(pattern);
+  while (NextSegment(remaining, segment))
+  {
+    uint32_t next{NONE};
+    if (segment.front() == '{')
+    {
+      next = mNodes[node].captureChild;
+      if (next == NONE)
+      {
+        next = static_cast<uint32_t>(mNodes.size());
+        mNodes[node].captureChild = next;
+        mNodes.push_back({NONE, NONE});
+      }
+    }
+    else
+    {
+      const uint32_t hash = HashToken(segment);
+      if (const auto* edge = FindEdge(node, segment, hash))
+      {
+        next = edge->child;
+      }
+      else
+      {
+        next = static_cast<uint32_t>(mNodes.size());
+        mNodes.push_back({NONE, NONE});
+        // Segments with colliding hashes are kept next to each other (upper bound keeps the order).
+        const auto position = std::upper_bound(
+            mEdges.begin(), mEdges.end(), std::make_tuple(node, hash),
+            [](const std::tuple<uint32_t, uint32_t>& key, const Edge& other) {
+              return key < std::make_tuple(other.parent, other.hash);
+            });
+        mEdges.insert(position, Edge{node, hash, next, std::string{segment}});
+      }
+    }
+    node = next;
+  }
+
+  if (mNodes[node].route == NONE)
+  {
+    mNodes[node].route = static_cast<uint32_t>(mRoutes.size());
+    mRoutes.push_back(std::move(captures));
+  }
+  return mNodes[node].route;
+}
+
+bool PathRouter::Match(const std::string_view path, RouteMatch& match) const
+{
+  match.captureCount = 0;
+  uint32_t node{0};
+  std::string_view remaining = StripQuery(path);
+  std::string_view segment{};
+  while (NextSegment(remaining, segment))
+  {
+    if (const auto* edge = FindEdge(node, segment, HashToken(segment)))
+    {
+      node = edge->child;
+      continue;
+    }
+    node = mNodes[node].captureChild;
+    if (node == NONE)
+    {
+      return false;
+    }
+    // Bounded by the number of captures of the deepest pattern.
+    match.captureValues[match.captureCount++] = segment;
+  }
+
+  const uint32_t route = mNodes[node].route;
+  if (route == NONE)
+  {
+    return false;
+  }
+  match.route = route;
+  for (size_t i = 0; i < match.captureCount; ++i)
+  {
+    match.captureNames[i] = mRoutes[route][i];
+  }
+  return true;
+}
+
+const PathRouter::Edge* PathRouter::FindEdge(const uint32_t parent,
+                                             const std::string_view segment,
+                                             const uint32_t hash) const
+{
+  auto it = std::lower_bound(mEdges.begin(), mEdges.end(), std::make_tuple(parent, hash),
+                             [](const Edge& edge, const std::tuple<uint32_t, uint32_t>& key) {
+                               return std::make_tuple(edge.parent, edge.hash) < key;
+                             });
+  for (; it != mEdges.end() and it->parent == parent and it->hash == hash; ++it)
+  {
+    if (it->segment == segment)
+    {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
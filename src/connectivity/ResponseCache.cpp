@@ -0,0 +1,151 @@
+#include "esp32-modules/connectivity/ResponseCache.hpp"
+
+// Standard header
+#include <cstdio>
+
+// Project header
+#include <esp32-modules/connectivity/CommandTable.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/** Number of bytes taken by the entry. */
+size_t SizeOf(const ResponseCache::Entry& entry)
+{
+  return sizeof(entry) + entry.key.size() + entry.etag.size() + entry.contentType.size() +
+         entry.body->size();
+}
+}  // namespace
+
+ResponseCache::ResponseCache(const size_t budget)
+    : mBudget{budget}, mEntries{}, mSize{0}, mTick{0}, mStatistics{}
+{
+}
+
+const ResponseCache::Entry* ResponseCache::Find(const std::string_view key, const uint32_t version)
+{
+  for (auto& entry : mEntries)
+  {
+    if (entry.key == key)
+    {
+      if (entry.version != version)
+      {
+        break;
+      }
+      entry.lastUse = ++mTick;
+      ++mStatistics.hits;
+      return &entry;
+    }
+  }
+  ++mStatistics.misses;
+  return nullptr;
+}
+
+const ResponseCache::Entry* ResponseCache::Store(const std::string_view key,
+                                                 const uint32_t version,
+                                                 const std::string& contentType,
+                                                 std::shared_ptr<const std::string> body)
+{
+  for (size_t i = 0; i < mEntries.size(); ++i)
+  {
+    if (mEntries[i].key == key)
+    {
+      Remove(i);  // Outdated.
+      break;
+    }
+  }
+
+  Entry entry{std::string{key}, version, MakeETag(*body), contentType, std::move(body), ++mTick};
+  const size_t size = SizeOf(entry);
+  if (size > mBudget)
+  {
+    return nullptr;
+  }
+  while (mSize + size > mBudget)
+  {
+    size_t leastRecentlyUsed{0};
+    for (size_t i = 1; i < mEntries.size(); ++i)
+    {
+      if (static_cast<int32_t>(mEntries[i].lastUse - mEntries[leastRecentlyUsed].lastUse) < 0)
+      {
+        leastRecentlyUsed = i;
+      }
+    }
+    Remove(leastRecentlyUsed);
+    ++mStatistics.evictions;
+  }
+  mSize += size;
+  mEntries.push_back(std::move(entry));
+  return &mEntries.back();
+}
+
+std::string ResponseCache::MakeETag(const std::string_view body)
+{
+  char etag[20];
+  std::snprintf(etag, sizeof(etag), "\"%08x-%x\"", static_cast<unsigned>(HashToken(body)),
+                static_cast<unsigned>(body.size()));
+  return etag;
+}
+
+bool ResponseCache::MatchesETag(const std::string_view ifNoneMatch, const std::string_view etag)
+{
+  constexpr std::string_view WHITESPACE{" \t"};
+  constexpr std::string_view WEAK{"W/"};
+  const auto strip = [WEAK](std::string_view tag) {
+    return (tag.substr(0, WEAK.size()) == WEAK ? tag.substr(WEAK.size()) : tag);
+  };
+  const auto first = ifNoneMatch.find_first_not_of(WHITESPACE);
+  const auto last = ifNoneMatch.find_last_not_of(WHITESPACE);
+  if (first != std::string_view::npos and ifNoneMatch.substr(first, last - first + 1) == "*")
+  {
+    return true;
+  }
+
+  // Entity tags are quoted and may contain commas themselves, so the list is split by the quotes.
+  const auto current = strip(etag);
+  size_t position{0};
+  while (position < ifNoneMatch.size())
+  {
+    position = ifNoneMatch.find_first_not_of(" \t,", position);
+    if (position == std::string_view::npos)
+    {
+      break;
+    }
+    const size_t start = position;
+    if (ifNoneMatch.substr(position, WEAK.size()) == WEAK)
+    {
+      position += WEAK.size();
+    }
+    if (position < ifNoneMatch.size() and ifNoneMatch[position] == '"')
+    {
+      const auto end = ifNoneMatch.find('"', position + 1);
+      if (end == std::string_view::npos)
+      {
+        return false;  // Unterminated.
+      }
+      position = end + 1;
+      if (strip(ifNoneMatch.substr(start, position - start)) == current)
+      {
+        return true;
+      }
+    }
+    else
+    {
+      position = ifNoneMatch.find(',', position);  // Not an entity tag, skipped.
+    }
+  }
+  return false;
+}
+
+void ResponseCache::Remove(const size_t index)
+{
+  mSize -= SizeOf(mEntries[index]);
+  if (index + 1 != mEntries.size())
+  {
+    mEntries[index] = std::move(mEntries.back());
+  }
+  mEntries.pop_back();
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
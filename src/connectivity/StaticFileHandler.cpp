@@ -0,0 +1,155 @@
+#include "esp32-modules/connectivity/StaticFileHandler.hpp"
+
+// Standard header
+#include <algorithm>
+#include <cstdio>
+
+// Project header
+#include <esp32-modules/connectivity/HttpResponse.hpp>
+
+namespace Esp32Modules::Connectivity::Http
+{
+namespace
+{
+/** Removes a trailing '/' (so "/" becomes empty). */
+std::string WithoutTrailingSlash(std::string path)
+{
+  if (not path.empty() and path.back() == '/')
+  {
+    path.pop_back();
+  }
+  return path;
+}
+
+/** Indicates whether the header field contains the token. */
+bool HeaderContains(AsyncWebServerRequest* request, const char* name, const std::string_view token)
+{
+  const auto* header = request->getHeader(name);
+  return header and
+         std::string_view{header->value().c_str()}.find(token) != std::string_view::npos;
+}
+}  // namespace
+
+StaticFileHandler::StaticFileHandler(const std::string& prefix, fs::FS& fs,
+                                     const std::string& root, const std::string& cacheControl)
+    : mPrefix{WithoutTrailingSlash(prefix)},
+      mFS{fs},
+      mRoot{WithoutTrailingSlash(root)},
+      mCacheControl{cacheControl}
+{
+}
+
+bool StaticFileHandler::canHandle(AsyncWebServerRequest* request)
+{
+  const auto& url = request->url();
+  const std::string_view path{url.c_str(), url.length()};
+  if (request->method() != HTTP_GET or path.substr(0, mPrefix.size()) != mPrefix or
+      (path.size() > mPrefix.size() and path[mPrefix.size()] != '/'))
+  {
+    return false;
+  }
+  // Otherwise, the server drops the headers.
+  request->addInterestingHeader("Accept-Encoding");
+  request->addInterestingHeader("If-None-Match");
+  request->addInterestingHeader("Range");
+  return true;
+}
+
+void StaticFileHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  const auto& url = request->url();
+  const std::string_view relative{url.c_str() + mPrefix.size(), url.length() - mPrefix.size()};
+  if (relative.find("..") != std::string_view::npos)
+  {
+    request->send(400);  // Outside of the root.
+    return;
+  }
+  std::string path{mRoot};
+  path += relative;
+  if (path.empty() or path.back() == '/')
+  {
+    path += "index.html";
+  }
+
+  // Prefers the pre-compressed variant (checked first, as opening a missing file logs an error).
+  File file{};
+  const std::string compressedPath{path + ".gz"};
+  const bool gzip = HeaderContains(request, "Accept-Encoding", "gzip") and
+                    mFS.exists(compressedPath.c_str());
+  if (gzip)
+  {
+    file = mFS.open(compressedPath.c_str(), FILE_READ);
+  }
+  else if (mFS.exists(path.c_str()))
+  {
+    file = mFS.open(path.c_str(), FILE_READ);
+  }
+  if (not file or file.isDirectory())
+  {
+    request->send(404);
+    return;
+  }
+
+  const size_t size = file.size();
+  char etag[40];
+  std::snprintf(etag, sizeof(etag), "\"%x-%lx%s\"", static_cast<unsigned>(size),
+                static_cast<unsigned long>(file.getLastWrite()), (gzip ? "-gz" : ""));
+
+  HttpResponse response{};
+  response.SetContentType(GetContentType(path));
+  response.AddHeader("ETag", etag);
+  response.AddHeader("Accept-Ranges", "bytes");
+  response.AddHeader("Vary", "Accept-Encoding");
+  if (gzip)
+  {
+    response.AddHeader("Content-Encoding", "gzip");
+  }
+  if (not mCacheControl.empty())
+  {
+    response.AddHeader("Cache-Control", mCacheControl);
+  }
+  if (HeaderContains(request, "If-None-Match", etag))
+  {
+    file.close();
+    response.SetStatus(304);
+    response.SendTo(request);
+    return;
+  }
+
+  size_t first{0};
+  size_t last{size > 0 ? size - 1 : 0};
+  const auto* range = request->getHeader("Range");
+  switch (range ? ParseByteRange(range->value().c_str(), size, first, last) : ByteRange::FULL)
+  {
+    case ByteRange::UNSATISFIABLE:
+      file.close();
+      response.SetStatus(416);
+      response.AddHeader("Content-Range", "bytes */" + std::to_string(size));
+      response.SendTo(request);
+      return;
+    case ByteRange::PARTIAL:
+      response.SetStatus(206);
+      response.AddHeader("Content-Range", "bytes " + std::to_string(first) + "-" +
+                                              std::to_string(last) + "/" + std::to_string(size));
+      break;
+    case ByteRange::FULL:
+      break;
+  }
+
+  const size_t length = (size > 0 ? last - first + 1 : 0);
+  file.seek(first);
+  response.Stream(
+      [file, remaining = length](uint8_t* buffer, const size_t capacity) mutable {
+        const size_t read = file.read(buffer, std::min(capacity, remaining));
+        remaining -= read;
+        if (read == 0 or remaining == 0)
+        {
+          file.close();
+        }
+        return read;
+      },
+      length);
+  response.SendTo(request);
+}
+
+}  // namespace Esp32Modules::Connectivity::Http
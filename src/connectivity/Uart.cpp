@@ -0,0 +1,54 @@
+#include "esp32-modules/connectivity/Uart.hpp"
+
+// Standard header
+#include <string_view>
+
+namespace Esp32Modules::Connectivity::Uart
+{
+UartCommandReceiver::UartCommandReceiver(Stream& stream, CommandRouter& router)
+    : mStream{stream}, mRouter{router}, mLine{}, mLength{0}, mOverflow{false}, mStatistics{}
+{
+}
+
+void UartCommandReceiver::ProcessPendingCommands()
+{
+  while (mStream.available() > 0)
+  {
+    const int value = mStream.read();
+    if (value < 0)
+    {
+      return;
+    }
+    const char c = static_cast<char>(value);
+    if (c != '\n')
+    {
+      if (mLength < sizeof(mLine))
+      {
+        mLine[mLength++] = c;
+      }
+      else
+      {
+        mOverflow = true;
+      }
+      continue;
+    }
+    size_t length = mLength;
+    if (length > 0 and mLine[length - 1] == '\r')
+    {
+      --length;
+    }
+    if (mOverflow)
+    {
+      ++mStatistics.discarded;
+    }
+    else if (length > 0)
+    {
+      ++mStatistics.lines;
+      mRouter.Dispatch(std::string_view{mLine, length});
+    }
+    mLength = 0;
+    mOverflow = false;
+  }
+}
+
+}  // namespace Esp32Modules::Connectivity::Uart
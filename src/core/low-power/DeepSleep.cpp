@@ -1,10 +1,16 @@
 #include <esp32-modules/core/low-power/DeepSleep.hpp>
 
+#ifdef ARDUINO
 // Platform header
 #include <esp_sleep.h>
+#else
+// Standard header
+#include <thread>
+#endif
 
 using namespace Esp32Modules::Core;
 
+#ifdef ARDUINO
 namespace
 {
 constexpr uint32_t SECONDS_TO_US_FACTOR{1000000};
@@ -14,4 +20,11 @@ void LowPower::DeepSleepFor(const std::chrono::seconds duration)
 {
   esp_sleep_enable_timer_wakeup(duration.count() * SECONDS_TO_US_FACTOR);
   esp_deep_sleep_start();
-}
\ No newline at end of file
+}
+#else
+// Host builds just block and return (there is no reboot like on real hardware).
+void LowPower::DeepSleepFor(const std::chrono::seconds duration)
+{
+  std::this_thread::sleep_for(duration);
+}
+#endif
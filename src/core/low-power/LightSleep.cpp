@@ -0,0 +1,31 @@
+#include <esp32-modules/core/low-power/LightSleep.hpp>
+
+#ifdef ARDUINO
+// Platform header
+#include <esp_sleep.h>
+#else
+// Standard header
+#include <thread>
+#endif
+
+using namespace Esp32Modules::Core;
+
+#ifdef ARDUINO
+namespace
+{
+constexpr uint32_t MILLISECONDS_TO_US_FACTOR{1000};
+}  // namespace
+
+void LowPower::LightSleepFor(const std::chrono::milliseconds duration)
+{
+  esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(duration.count()) *
+                                MILLISECONDS_TO_US_FACTOR);
+  esp_light_sleep_start();
+}
+#else
+// Host builds just block (like the system clock does).
+void LowPower::LightSleepFor(const std::chrono::milliseconds duration)
+{
+  std::this_thread::sleep_for(duration);
+}
+#endif
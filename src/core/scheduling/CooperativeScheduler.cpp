@@ -1,120 +1,477 @@
 #include "esp32-modules/core/scheduling/CooperativeScheduler.hpp"
 
-// Now include the TaskScheduler implementation
-#include <TaskScheduler.h>
+// Platform header
+#ifdef ESP_PLATFORM
+#include <esp_attr.h>
+#include <esp_timer.h>
+#else
+#define IRAM_ATTR
+#endif
+
+// Project header
+#include <esp32-modules/core/scheduling/IdlePolicy.hpp>
+#include <esp32-modules/core/scheduling/TaskEvent.hpp>
 
 using namespace Esp32Modules::Core::Scheduling;
 
-namespace
+TaskId CooperativeScheduler::AddOneShotTask(const TaskDuration delay, TaskFunction task,
+                                            const TaskDuration timeout,
+                                            const TaskPriority priority)
 {
-constexpr TaskDuration GARBAGE_COLLECTION_INTERVAL{
-    10 * TASK_SECOND};  //!< Run garbage collection every 10 seconds.
+  return AddTask(TaskType::ONE_SHOT, delay, timeout, priority, std::move(task));
 }
 
-CooperativeScheduler::CooperativeScheduler(const TaskCallback& mainTask,
-                                           const TaskDuration mainInterval)
-    : mScheduler{new Scheduler{}}, mTasks{}, mDisabledTasks{}, mMainTask{}, mGarbageCollectionTask{}
+TaskId CooperativeScheduler::AddCyclicTask(const TaskDuration interval, TaskFunction task,
+                                           const TaskDuration timeout, const TaskPriority priority)
 {
-  mScheduler->init();
-  // Setup main task
-  mMainTask.set(mainInterval, TASK_FOREVER, mainTask);
-  mScheduler->addTask(mMainTask);
-  mMainTask.enableDelayed();  // enableDelayed to not immediately execute (enable does that).
-  // Setup garbage collection
-  mGarbageCollectionTask.set(GARBAGE_COLLECTION_INTERVAL, TASK_FOREVER,
-                             [this]() { RemoveDisabledTasks(); });
-  mScheduler->addTask(mGarbageCollectionTask);
-  mGarbageCollectionTask.enableDelayed();
+  return AddTask(TaskType::CYCLIC, interval, timeout, priority, std::move(task));
 }
 
-CooperativeScheduler::~CooperativeScheduler()
+void CooperativeScheduler::SetIdlePolicy(IdlePolicy* policy)
 {
-  AbortAllTasks();
-  RemoveDisabledTasks();  // Trigger the garbage collection one last time
+  // The policy replaces the 1 ms powerdowns of the TaskScheduler engine (see ExecuteNext).
+  mIdlePolicy = policy;
+}
+
+void CooperativeScheduler::SetPassBudget(const uint32_t budget) { mPassBudget = budget; }
+
+bool CooperativeScheduler::IsWithinPassBudget(const TaskPriority priority) const
+{
+  if (priority == TaskPriority::CRITICAL or mPassBudget == NO_PASS_BUDGET)
+  {
+    return true;
+  }
+  return (mClock.Micros() - mPassStart < mPassBudget);
+}
+
+void IRAM_ATTR CooperativeScheduler::EnqueueEvent(TaskEvent& event)
+{
+  TaskEvent* head = mSignaledEvents.load(std::memory_order_relaxed);
+  do
+  {
+    event.mNext = head;
+  } while (not mSignaledEvents.compare_exchange_weak(head, &event, std::memory_order_release,
+                                                     std::memory_order_relaxed));
+}
+
+void CooperativeScheduler::WithdrawEvent(TaskEvent& event)
+{
+  CollectSignaledEvents();
+  for (TaskEvent** link = &mReadyEvents; *link; link = &(*link)->mNext)
+  {
+    if (*link == &event)
+    {
+      *link = event.mNext;
+      event.mNext = nullptr;
+      event.mPending.store(false, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+void CooperativeScheduler::CollectSignaledEvents()
+{
+  // The stack holds the most recent signal first, reverse it to execute in order of signaling.
+  TaskEvent* stack = mSignaledEvents.exchange(nullptr, std::memory_order_acquire);
+  TaskEvent* ordered{nullptr};
+  while (stack)
+  {
+    TaskEvent* next = stack->mNext;
+    stack->mNext = ordered;
+    ordered = stack;
+    stack = next;
+  }
+  TaskEvent** tail = &mReadyEvents;
+  while (*tail)
+  {
+    tail = &(*tail)->mNext;
+  }
+  *tail = ordered;
+}
+
+uint16_t CooperativeScheduler::DispatchEvents()
+{
+  CollectSignaledEvents();
+  // Only execute the events signaled before this pass, re-signaling from within a task (or an
+  // interrupt firing continuously) cannot starve the loop.
+  uint16_t due{0};
+  for (const TaskEvent* event = mReadyEvents; event; event = event->mNext)
+  {
+    ++due;
+  }
+  uint16_t executed{0};
+  while (executed < due and mReadyEvents)
+  {
+    TaskEvent& event = *mReadyEvents;
+    mReadyEvents = event.mNext;
+    event.mNext = nullptr;
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+#ifdef ESP_PLATFORM
+    const uint32_t now = static_cast<uint32_t>(esp_timer_get_time());  // As in TaskEvent::Signal.
+#else
+    const uint32_t now = mClock.Micros();
+#endif
+    const uint32_t latency = now - event.mSignalTime.load(std::memory_order_relaxed);
+    event.mMaxLatency = (latency > event.mMaxLatency) ? latency : event.mMaxLatency;
+    event.mTotalLatency += latency;
+#endif
+    // Signals from now on request another execution.
+    event.mPending.store(false, std::memory_order_release);
+    ++event.mExecutions;
+    ++executed;
+    if (event.mTask)
+    {
+      event.mTask();  // May destroy the event, so do not touch it afterwards.
+    }
+  }
+  return executed;
 }
 
-TaskId CooperativeScheduler::AddOneShotTask(const TaskDuration delay, const TaskCallback& task,
-                                            const TaskDuration timeout)
+bool CooperativeScheduler::HasPendingEvents() const
 {
-  return AddTask(TaskType::ONE_SHOT, delay, timeout, task);
+  return (mReadyEvents or mSignaledEvents.load(std::memory_order_relaxed));
 }
 
-TaskId CooperativeScheduler::AddCyclicTask(const TaskDuration interval, const TaskCallback& task,
-                                           const TaskDuration timeout)
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+void CooperativeScheduler::RunProfiled(TaskFunction& callback, TaskProfile& profile,
+                                       const uint32_t startLatency)
 {
-  return AddTask(TaskType::CYCLIC, interval, timeout, task);
+  const uint32_t start = mClock.Micros();
+  callback();
+  profile.Record(startLatency, mClock.Micros() - start);
+}
+#endif
+
+// The timing wheel engine is implemented in CooperativeSchedulerTimingWheel.cpp.
+#ifndef ESP32MODULES_SCHEDULER_TIMING_WHEEL
+
+// Now include the TaskScheduler implementation
+#include <TaskScheduler.h>
+
+CooperativeScheduler::CooperativeScheduler(TaskFunction mainTask, const TaskDuration mainInterval,
+                                           Time::Clock* clock)
+    : mClock{clock ? *clock : Time::GetSystemClock()},
+      mIdlePolicy{nullptr},
+      mPassBudget{NO_PASS_BUDGET},
+      mPassStart{0},
+      mSignaledEvents{nullptr},
+      mReadyEvents{nullptr},
+      mSchedulers{},
+      mTasks{},
+      mMainCallback{std::move(mainTask)},
+      mMainTask{},
+      mIsExecuting{false},
+      mIsAbortingAllTasks{false},
+      mFinishedTasks{},
+      mNumFinishedTasks{0},
+      mDeferredTasks{},
+      mNumDeferredTasks{0}
+{
+  for (auto& scheduler : mSchedulers)
+  {
+    scheduler.reset(new Scheduler{});
+    scheduler->init();
+    scheduler->allowSleep(false);  // Decided per pass, see ExecuteNext.
+  }
+  // Setup main task
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  mMainProfile.timeout = DEFAULT_TIMEOUT;
+  mMainTask.set(mainInterval, TASK_FOREVER, [this]() {
+    if (not DeferIfOverBudget(mMainTask, INVALID_TASKID, TaskPriority::NORMAL))
+    {
+      RunProfiled(mMainCallback, mMainProfile, mMainTask.getStartDelay());
+    }
+  });
+#else
+  mMainTask.set(mainInterval, TASK_FOREVER, [this]() {
+    if (not DeferIfOverBudget(mMainTask, INVALID_TASKID, TaskPriority::NORMAL))
+    {
+      mMainCallback();
+    }
+  });
+#endif
+  mSchedulers[static_cast<uint8_t>(TaskPriority::NORMAL)]->addTask(mMainTask);
+  mMainTask.enableDelayed();  // enableDelayed to not immediately execute (enable does that).
+}
+
+CooperativeScheduler::~CooperativeScheduler()
+{
+  AbortAllTasks();
+  mTasks.ForEach([this](const TaskId id, TaskEntry&) { Release(id); });
 }
 
 CooperativeScheduler::ExecutionResult CooperativeScheduler::ExecuteNext()
 {
-  if (not mScheduler)
+  if (not mSchedulers[0])
   {
     return ExecutionResult::ERR_INIT;
   }
-  return (mScheduler->execute() ? ExecutionResult::IDLE : ExecutionResult::OK);
+  mIsExecuting = true;
+  mPassStart = mClock.Micros();
+  // Signaled events first, then one pass through each priority class, most important first
+  // (starting with the tasks deferred by the budget). Only the last pass may power down for 1 ms,
+  // and only if nothing was executed at all and no idle policy replaces the powerdowns.
+  bool idle = (DispatchEvents() == 0);
+  for (uint8_t i = 0; i < NUM_PRIORITIES; ++i)
+  {
+    idle = (RunDeferredTasks(static_cast<TaskPriority>(i)) == 0) and idle;
+    if (i == NUM_PRIORITIES - 1)
+    {
+      mSchedulers[i]->allowSleep(idle and mIdlePolicy == nullptr);
+    }
+    idle = mSchedulers[i]->execute() and idle;
+  }
+  mIsExecuting = false;
+  // Recycle the tasks finished during the pass (not possible while the scheduler iterates them).
+  for (uint16_t i = 0; i < mNumFinishedTasks; ++i)
+  {
+    Release(mFinishedTasks[i]);
+  }
+  mNumFinishedTasks = 0;
+  if (not idle)
+  {
+    return ExecutionResult::OK;
+  }
+  if (mIdlePolicy)
+  {
+    mIdlePolicy->OnIdle(TimeUntilNextTask());
+  }
+  return ExecutionResult::IDLE;
+}
+
+TaskDuration CooperativeScheduler::TimeUntilNextTask() const
+{
+  if (HasPendingEvents() or mNumDeferredTasks > 0)
+  {
+    return 0;
+  }
+  // The TaskScheduler does not order its tasks, so all of them need to be checked. Its interface
+  // is not const-correct, although determining the next iteration does not modify the task.
+  auto& scheduler = *mSchedulers[0];  // Only evaluates the timing of the given task.
+  long closest = scheduler.timeUntilNextIteration(const_cast<Task&>(mMainTask));
+  mTasks.ForEach([&scheduler, &closest](const TaskId, const TaskEntry& entry) {
+    const long next = scheduler.timeUntilNextIteration(const_cast<Task&>(entry.task));
+    if (next >= 0 and (closest < 0 or next < closest))
+    {
+      closest = next;
+    }
+  });
+  return (closest < 0 ? NO_TASK_PENDING : static_cast<TaskDuration>(closest));
 }
 
 bool CooperativeScheduler::AbortTask(const TaskId id)
 {
-  auto item = mTasks.find(id);
-  if (item == mTasks.end())
+  auto* entry = mTasks.Get(id);
+  if (not entry)
   {
     return false;
   }
-  item->second->abort();  // This will lead to the execution of MarkTaskAsDisabled for this task.
+  entry->task.abort();  // Does not call the OnDisable callback.
+  MarkTaskAsFinished(id);
   return true;
 }
 
-void CooperativeScheduler::AbortAllTasks() { mScheduler->disableAll(); }
+void CooperativeScheduler::AbortAllTasks()
+{
+  mIsAbortingAllTasks = true;  // Keep the tasks to be able to restart them.
+  for (auto& scheduler : mSchedulers)
+  {
+    scheduler->disableAll();
+  }
+  mIsAbortingAllTasks = false;
+}
 
 TaskId CooperativeScheduler::AddTask(const TaskType type, const TaskDuration timespan,
-                                     const TaskDuration timeout, const TaskCallback& task)
+                                     const TaskDuration timeout, const TaskPriority priority,
+                                     TaskFunction task)
 {
-  std::unique_ptr<Task> t{new Task(timespan, static_cast<uint32_t>(type), task, mScheduler.get(),
-                                   false, nullptr, [this]() { MarkTaskAsDisabled(); })};
-  const TaskId id = t->getId();
-  const auto res = mTasks.emplace(id, std::move(t));
-  const auto success = res.second;
-  if (not success)
+  if (not task)
   {
     return INVALID_TASKID;
   }
-  auto& it = res.first;
-  auto& stored = it->second;
-  stored->enableDelayed();  // enableDelayed to not immediately execute (enable does that).
+  const TaskId id = mTasks.Emplace(priority, std::move(task));
+  auto* entry = mTasks.Get(id);
+  if (not entry)
+  {
+    return INVALID_TASKID;
+  }
+  entry->id = id;
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  entry->profile.timeout = timeout;
+#else
+  (void)timeout;  // Running callbacks cannot be interrupted, so the timeout is only profiled.
+#endif
+  // Capturing only pointers and the id keeps the std::function wrappers within their small buffer.
+  TaskCallback run = [this, entry]() {
+    if (DeferIfOverBudget(entry->task, entry->id, entry->priority))
+    {
+      return;
+    }
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    RunProfiled(entry->callback, entry->profile, entry->task.getStartDelay());
+#else
+    entry->callback();
+#endif
+  };
+  entry->task.set(timespan, static_cast<long>(type), run, nullptr,
+                  [this, id]() { MarkTaskAsFinished(id); });
+  mSchedulers[static_cast<uint8_t>(priority)]->addTask(entry->task);
+  entry->task.enableDelayed();  // enableDelayed to not immediately execute (enable does that).
   return id;
 }
 
-void CooperativeScheduler::RestartMainTask()
+void CooperativeScheduler::RestartMainTask() { mMainTask.enable(); }
+
+void CooperativeScheduler::RestartAllTasks()
+{
+  for (auto& scheduler : mSchedulers)
+  {
+    scheduler->enableAll();
+  }
+}
+
+CooperativeScheduler::PoolStatistics CooperativeScheduler::GetPoolStatistics() const
 {
-  mMainTask.enable();
-  mGarbageCollectionTask.enable();
+  return {mTasks.GetCapacity(), mTasks.Size(), mTasks.HighWaterMark(),
+          static_cast<uint16_t>(mTasks.GetSlotSize())};
 }
 
-void CooperativeScheduler::RestartAllTasks() { mScheduler->enableAll(); }
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+uint16_t CooperativeScheduler::GetTaskProfiles(TaskProfileSnapshot* snapshots,
+                                               const uint16_t maxSnapshots) const
+{
+  if (maxSnapshots == 0)
+  {
+    return 0;
+  }
+  snapshots[0] = {INVALID_TASKID, mMainProfile};
+  uint16_t count{1};
+  mTasks.ForEach([&](const TaskId id, const TaskEntry& entry) {
+    if (count < maxSnapshots)
+    {
+      snapshots[count++] = {id, entry.profile};
+    }
+  });
+  return count;
+}
 
-void CooperativeScheduler::MarkTaskAsDisabled()
+void CooperativeScheduler::ResetTaskProfiles()
 {
-  const auto id = mScheduler->getCurrentTask()->getId();
-  mDisabledTasks.emplace_back(id);
-  // The next time the garbage collection is executed, this task will be removed.
+  mMainProfile = TaskProfile{DEFAULT_TIMEOUT};
+  mTasks.ForEach([](const TaskId, TaskEntry& entry) {
+    entry.profile = TaskProfile{entry.profile.timeout};
+  });
 }
+#endif
 
-void CooperativeScheduler::RemoveDisabledTasks()
+bool CooperativeScheduler::DeferIfOverBudget(Task& task, const TaskId id,
+                                             const TaskPriority priority)
 {
-  for (const auto id : mDisabledTasks)
+  if (IsWithinPassBudget(priority))
   {
-    auto item = mTasks.find(id);
-    if (item == mTasks.end())
+    return false;
+  }
+  const long iterations = task.getIterations();
+  if (iterations >= 0)
+  {
+    // Retry on the next pass. The TaskScheduler already counted this iteration, so give it back.
+    task.setIterations(iterations + 1);
+    task.forceNextIteration();
+    return true;
+  }
+  // Forcing the next iteration of a cyclic task would restart its cadence from the deferred
+  // execution. Run the callback separately instead, the TaskScheduler already scheduled the next
+  // iteration in phase.
+  for (uint16_t i = 0; i < mNumDeferredTasks; ++i)
+  {
+    if (mDeferredTasks[i].id == id)
+    {
+      return true;  // Still deferred from an earlier iteration, skip this one (like an overrun).
+    }
+  }
+  // Each task is deferred at most once, so the list cannot overflow.
+  mDeferredTasks[mNumDeferredTasks++] = {id, priority, mClock.Millis()};
+  return true;
+}
+
+uint16_t CooperativeScheduler::RunDeferredTasks(const TaskPriority priority)
+{
+  uint16_t executed{0};
+  uint16_t kept{0};
+  for (uint16_t i = 0; i < mNumDeferredTasks; ++i)
+  {
+    const DeferredTask deferred = mDeferredTasks[i];
+    if (deferred.priority != priority or not IsWithinPassBudget(priority))
+    {
+      mDeferredTasks[kept++] = deferred;  // Keep the order for the next pass.
+      continue;
+    }
+    // Tasks aborted in the meantime are dropped.
+    Task* task{&mMainTask};
+    TaskFunction* callback{&mMainCallback};
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    TaskProfile* profile{&mMainProfile};
+#endif
+    if (deferred.id != INVALID_TASKID)
+    {
+      auto* entry = mTasks.Get(deferred.id);
+      if (not entry)
+      {
+        continue;
+      }
+      task = &entry->task;
+      callback = &entry->callback;
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+      profile = &entry->profile;
+#endif
+    }
+    if (not task->isEnabled())
     {
-      continue;  // Task already removed.
+      continue;
     }
-    auto* task = item->second.get();
-    if (task)
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+    RunProfiled(*callback, *profile, task->getStartDelay() + mClock.Millis() - deferred.deferredAt);
+#else
+    (*callback)();
+#endif
+    ++executed;
+  }
+  mNumDeferredTasks = kept;
+  return executed;
+}
+
+void CooperativeScheduler::MarkTaskAsFinished(const TaskId id)
+{
+  if (mIsAbortingAllTasks)
+  {
+    return;
+  }
+  if (not mIsExecuting)
+  {
+    Release(id);
+    return;
+  }
+  for (uint16_t i = 0; i < mNumFinishedTasks; ++i)
+  {
+    if (mFinishedTasks[i] == id)
     {
-      mScheduler->deleteTask(*task);
+      return;  // Already marked (e.g. disabled and aborted during the same pass).
     }
-    mTasks.erase(item);
   }
-  mDisabledTasks.clear();
-}
\ No newline at end of file
+  // Each task is marked at most once per pass, so the list cannot overflow.
+  mFinishedTasks[mNumFinishedTasks++] = id;
+}
+
+void CooperativeScheduler::Release(const TaskId id)
+{
+  auto* entry = mTasks.Get(id);
+  if (not entry)
+  {
+    return;  // Task already released.
+  }
+  entry->task.abort();  // Make sure the OnDisable callback is not triggered by the destructor.
+  mSchedulers[static_cast<uint8_t>(entry->priority)]->deleteTask(entry->task);
+  mTasks.Release(id);
+}
+
+#endif  // ESP32MODULES_SCHEDULER_TIMING_WHEEL
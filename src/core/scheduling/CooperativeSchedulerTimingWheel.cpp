@@ -0,0 +1,273 @@
+#include "esp32-modules/core/scheduling/CooperativeScheduler.hpp"
+
+// Project header
+#include <esp32-modules/core/scheduling/IdlePolicy.hpp>
+
+// The TaskScheduler engine is implemented in CooperativeScheduler.cpp.
+#ifdef ESP32MODULES_SCHEDULER_TIMING_WHEEL
+
+using namespace Esp32Modules::Core::Scheduling;
+
+CooperativeScheduler::CooperativeScheduler(TaskFunction mainTask, const TaskDuration mainInterval,
+                                           Time::Clock* clock)
+    : mClock{clock ? *clock : Time::GetSystemClock()},
+      mIdlePolicy{nullptr},
+      mPassBudget{NO_PASS_BUDGET},
+      mPassStart{0},
+      mSignaledEvents{nullptr},
+      mReadyEvents{nullptr},
+      mWheel{mClock.Millis()},
+      mTasks{},
+      mMainTask{INVALID_TASKID, TaskType::CYCLIC, TaskPriority::NORMAL, mainInterval,
+                std::move(mainTask)},
+      mCurrentTask{nullptr},
+      mReadyHead{},
+      mReadyTail{}
+{
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  mMainTask.profile.timeout = DEFAULT_TIMEOUT;
+#endif
+  // Do not immediately execute the main task (the TaskScheduler engine does the same).
+  mWheel.Schedule(mMainTask, mWheel.Now() + mainInterval);
+}
+
+CooperativeScheduler::~CooperativeScheduler()
+{
+  AbortAllTasks();  // Unlink all tasks from the wheel, the pool destroys them afterwards.
+}
+
+CooperativeScheduler::ExecutionResult CooperativeScheduler::ExecuteNext()
+{
+  mPassStart = mClock.Micros();
+  uint32_t executed = DispatchEvents();  // Signaled events first.
+  mWheel.Advance(mClock.Millis());
+  // Only the tasks due at the beginning of this pass are moved to the ready lists. This way,
+  // (re-)scheduling tasks without delay from within a callback cannot starve the loop.
+  while (auto* timer = mWheel.PopExpired())
+  {
+    MakeReady(static_cast<TaskEntry&>(*timer));
+  }
+
+  for (uint8_t priority = 0; priority < NUM_PRIORITIES; ++priority)
+  {
+    auto*& head = mReadyHead[priority];
+    while (head)
+    {
+      if (not IsWithinPassBudget(head->priority))
+      {
+        break;  // Keep the remaining tasks (in order) for the next pass.
+      }
+      auto& entry = *head;
+      head = entry.nextReady;
+      entry.nextReady = nullptr;
+      entry.ready = false;
+      if (entry.aborted)
+      {
+        Release(entry);
+      }
+      else if (entry.enabled)
+      {
+        Dispatch(entry);
+        ++executed;
+      }
+      // Tasks disabled by AbortAllTasks are dropped until they are restarted.
+    }
+    if (not head)
+    {
+      mReadyTail[priority] = nullptr;
+    }
+  }
+  if (executed > 0)
+  {
+    return ExecutionResult::OK;
+  }
+  if (mIdlePolicy)
+  {
+    mIdlePolicy->OnIdle(TimeUntilNextTask());
+  }
+  return ExecutionResult::IDLE;
+}
+
+TaskDuration CooperativeScheduler::TimeUntilNextTask() const
+{
+  if (HasPendingEvents())
+  {
+    return 0;
+  }
+  for (const auto* head : mReadyHead)
+  {
+    if (head)
+    {
+      return 0;  // Deferred by the pass budget.
+    }
+  }
+  TimingWheel::Tick next{0};
+  if (not mWheel.NextExpiry(next))
+  {
+    return NO_TASK_PENDING;
+  }
+  const auto delta = static_cast<int32_t>(next - mClock.Millis());
+  return (delta > 0 ? static_cast<TaskDuration>(delta) : 0);
+}
+
+bool CooperativeScheduler::AbortTask(const TaskId id)
+{
+  auto* entry = mTasks.Get(id);
+  if (not entry)
+  {
+    return false;
+  }
+  if (entry == mCurrentTask or entry->ready)
+  {
+    entry->aborted = true;  // Freed as soon as the callback returned or it is taken from the list.
+    return true;
+  }
+  Release(*entry);
+  return true;
+}
+
+void CooperativeScheduler::AbortAllTasks()
+{
+  mMainTask.enabled = false;
+  mWheel.Cancel(mMainTask);
+  mTasks.ForEach([this](const TaskId, TaskEntry& entry) {
+    entry.enabled = false;
+    mWheel.Cancel(entry);
+  });
+}
+
+TaskId CooperativeScheduler::AddTask(const TaskType type, const TaskDuration timespan,
+                                     const TaskDuration timeout, const TaskPriority priority,
+                                     TaskFunction task)
+{
+  if (not task)
+  {
+    return INVALID_TASKID;
+  }
+  const TaskId id = mTasks.Emplace(INVALID_TASKID, type, priority, timespan, std::move(task));
+  auto* entry = mTasks.Get(id);
+  if (not entry)
+  {
+    return INVALID_TASKID;
+  }
+  entry->id = id;
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  entry->profile.timeout = timeout;
+#else
+  (void)timeout;  // Running callbacks cannot be interrupted, so the timeout is only profiled.
+#endif
+  // Like enableDelayed of the TaskScheduler: first execution after the given timespan.
+  mWheel.Schedule(*entry, mClock.Millis() + timespan);
+  return id;
+}
+
+void CooperativeScheduler::RestartMainTask()
+{
+  mMainTask.enabled = true;
+  if (not mMainTask.ready)
+  {
+    mWheel.Schedule(mMainTask, mWheel.Now());
+  }
+}
+
+void CooperativeScheduler::RestartAllTasks()
+{
+  RestartMainTask();
+  mTasks.ForEach([this](const TaskId, TaskEntry& entry) {
+    entry.enabled = true;
+    if (not entry.ready)  // Otherwise still waiting for its execution.
+    {
+      mWheel.Schedule(entry, mWheel.Now());
+    }
+  });
+}
+
+CooperativeScheduler::PoolStatistics CooperativeScheduler::GetPoolStatistics() const
+{
+  return {mTasks.GetCapacity(), mTasks.Size(), mTasks.HighWaterMark(),
+          static_cast<uint16_t>(mTasks.GetSlotSize())};
+}
+
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+uint16_t CooperativeScheduler::GetTaskProfiles(TaskProfileSnapshot* snapshots,
+                                               const uint16_t maxSnapshots) const
+{
+  if (maxSnapshots == 0)
+  {
+    return 0;
+  }
+  snapshots[0] = {INVALID_TASKID, mMainTask.profile};
+  uint16_t count{1};
+  mTasks.ForEach([&](const TaskId id, const TaskEntry& entry) {
+    if (count < maxSnapshots)
+    {
+      snapshots[count++] = {id, entry.profile};
+    }
+  });
+  return count;
+}
+
+void CooperativeScheduler::ResetTaskProfiles()
+{
+  mMainTask.profile = TaskProfile{mMainTask.profile.timeout};
+  mTasks.ForEach([](const TaskId, TaskEntry& entry) {
+    entry.profile = TaskProfile{entry.profile.timeout};
+  });
+}
+#endif
+
+void CooperativeScheduler::MakeReady(TaskEntry& entry)
+{
+  const auto priority = static_cast<uint8_t>(entry.priority);
+  auto*& head = mReadyHead[priority];
+  auto*& tail = mReadyTail[priority];
+  entry.ready = true;
+  entry.nextReady = nullptr;
+  // Tasks mostly expire in order of their due time, so appending is the common case.
+  if (not tail or static_cast<int32_t>(entry.Expiry() - tail->Expiry()) >= 0)
+  {
+    (tail ? tail->nextReady : head) = &entry;
+    tail = &entry;
+    return;
+  }
+  TaskEntry** link = &head;
+  while (static_cast<int32_t>(entry.Expiry() - (*link)->Expiry()) >= 0)
+  {
+    link = &(*link)->nextReady;
+  }
+  entry.nextReady = *link;
+  *link = &entry;
+}
+
+void CooperativeScheduler::Dispatch(TaskEntry& entry)
+{
+  mCurrentTask = &entry;
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  RunProfiled(entry.callback, entry.profile, mClock.Millis() - entry.Expiry());
+#else
+  entry.callback();
+#endif
+  mCurrentTask = nullptr;
+
+  if (entry.aborted or entry.type == TaskType::ONE_SHOT)
+  {
+    Release(entry);
+  }
+  else if (entry.enabled and not entry.IsScheduled())
+  {
+    // Keep the cadence (like the TaskScheduler does) instead of drifting with execution times.
+    mWheel.Schedule(entry, entry.Expiry() + entry.interval);
+  }
+}
+
+void CooperativeScheduler::Release(TaskEntry& entry)
+{
+  mWheel.Cancel(entry);
+  if (&entry == &mMainTask)
+  {
+    return;  // The main task is never freed during the lifetime of the scheduler.
+  }
+  mTasks.Release(entry.id);  // Destroys the entry, the slot is available right away.
+}
+
+#endif  // ESP32MODULES_SCHEDULER_TIMING_WHEEL
@@ -0,0 +1,168 @@
+#include "esp32-modules/core/scheduling/Coroutine.hpp"
+
+#ifdef ESP32MODULES_SCHEDULER_COROUTINES
+
+// Standard header
+#include <exception>
+
+using namespace Esp32Modules::Core::Scheduling;
+
+namespace
+{
+/** Storage of a single coroutine frame (or the link to the next free one). */
+union FrameBlock
+{
+  FrameBlock* nextFree;
+  alignas(std::max_align_t) unsigned char storage[ESP32MODULES_COROUTINE_FRAME_SIZE];
+};
+
+constexpr uint16_t MAX_FRAMES{ESP32MODULES_COROUTINE_MAX_FRAMES};
+
+FrameBlock gFrames[MAX_FRAMES];    //!< Storage of all frames.
+FrameBlock* gFreeFrames{nullptr};  //!< Frames returned to the pool.
+uint16_t gUntouchedFrames{0};      //!< Index of the first frame never handed out.
+uint16_t gUsedFrames{0};           //!< Number of frames alive.
+uint16_t gHighWaterMark{0};        //!< Maximum number of frames alive at the same time.
+uint32_t gFailures{0};             //!< Number of failed allocations.
+
+/**
+ * @brief Schedules the resumption of the coroutine.
+ *
+ * @return true if the resumption was scheduled, false otherwise.
+ */
+bool ScheduleResume(CoTask::Handle handle, const TaskDuration delay)
+{
+  auto& promise = handle.promise();
+  return (promise.scheduler->AddOneShotTask(
+              delay, [handle]() { handle.resume(); }, DEFAULT_TIMEOUT, promise.priority) !=
+          INVALID_TASKID);
+}
+}  // namespace
+
+void* CoroutineFramePool::Allocate(const size_t size) noexcept
+{
+  FrameBlock* frame{nullptr};
+  if (size <= sizeof(FrameBlock))
+  {
+    if (gFreeFrames)
+    {
+      frame = gFreeFrames;
+      gFreeFrames = frame->nextFree;
+    }
+    else if (gUntouchedFrames < MAX_FRAMES)
+    {
+      frame = &gFrames[gUntouchedFrames++];
+    }
+  }
+  if (not frame)
+  {
+    ++gFailures;
+    return nullptr;
+  }
+  ++gUsedFrames;
+  if (gUsedFrames > gHighWaterMark)
+  {
+    gHighWaterMark = gUsedFrames;
+  }
+  return frame->storage;
+}
+
+void CoroutineFramePool::Deallocate(void* frame) noexcept
+{
+  if (not frame)
+  {
+    return;
+  }
+  auto* block = static_cast<FrameBlock*>(frame);
+  block->nextFree = gFreeFrames;
+  gFreeFrames = block;
+  --gUsedFrames;
+}
+
+CoroutineFramePool::Statistics CoroutineFramePool::GetStatistics() noexcept
+{
+  return {MAX_FRAMES, gUsedFrames, gHighWaterMark, gFailures};
+}
+
+void CoTask::promise_type::unhandled_exception() noexcept
+{
+  std::terminate();  // Exceptions are not used by the modules.
+}
+
+CoTask& CoTask::operator=(CoTask&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (mHandle)
+    {
+      mHandle.destroy();
+    }
+    mHandle = other.mHandle;
+    other.mHandle = {};
+  }
+  return *this;
+}
+
+CoTask::~CoTask()
+{
+  if (mHandle)
+  {
+    mHandle.destroy();  // Never spawned, i.e. still suspended initially.
+  }
+}
+
+bool Esp32Modules::Core::Scheduling::Spawn(CooperativeScheduler& scheduler, CoTask task,
+                                           const TaskPriority priority)
+{
+  if (not task)
+  {
+    return false;
+  }
+  auto& promise = task.mHandle.promise();
+  promise.scheduler = &scheduler;
+  promise.priority = priority;
+  if (not ScheduleResume(task.mHandle, 0))
+  {
+    return false;  // Destroyed together with the task.
+  }
+  task.mHandle = {};  // Owned by the scheduler from now on, freed when finished.
+  return true;
+}
+
+bool DelayAwaiter::await_suspend(CoTask::Handle handle) noexcept
+{
+  mScheduled = ScheduleResume(handle, mDelay);
+  return mScheduled;  // Continue right away if the resumption could not be scheduled.
+}
+
+void CoEvent::Set() noexcept
+{
+  mIsSet = true;
+  // Detach the waiters first, resumed coroutines may wait for the event again.
+  Awaiter* waiters{nullptr};
+  while (mWaiters)
+  {
+    Awaiter* waiter = mWaiters;
+    mWaiters = waiter->mNext;
+    waiter->mNext = waiters;
+    waiters = waiter;  // Reverses the order, i.e. resumes in order of waiting.
+  }
+  while (waiters)
+  {
+    Awaiter* waiter = waiters;
+    waiters = waiter->mNext;  // The awaiter is gone once its coroutine continued.
+    if (not ScheduleResume(waiter->mHandle, 0))
+    {
+      waiter->mHandle.resume();  // Better late than never.
+    }
+  }
+}
+
+void CoEvent::Awaiter::await_suspend(CoTask::Handle handle) noexcept
+{
+  mHandle = handle;
+  mNext = mEvent.mWaiters;
+  mEvent.mWaiters = this;
+}
+
+#endif  // ESP32MODULES_SCHEDULER_COROUTINES
@@ -0,0 +1,23 @@
+#include "esp32-modules/core/scheduling/IdlePolicy.hpp"
+
+using namespace Esp32Modules::Core::Scheduling;
+
+TicklessIdlePolicy::TicklessIdlePolicy(Time::Clock& clock, const TaskDuration deepSleepThreshold,
+                                       const TaskDuration minSleep)
+    : mClock{clock}, mDeepSleepThreshold{deepSleepThreshold}, mMinSleep{minSleep}
+{
+}
+
+void TicklessIdlePolicy::OnIdle(const TaskDuration timeUntilNextTask)
+{
+  if (timeUntilNextTask == NO_TASK_PENDING or timeUntilNextTask < mMinSleep)
+  {
+    return;  // Nothing would wake us up again or the gap is too short.
+  }
+  if (timeUntilNextTask >= mDeepSleepThreshold)
+  {
+    mClock.DeepSleep(timeUntilNextTask);
+    return;
+  }
+  mClock.LightSleep(timeUntilNextTask);
+}
@@ -0,0 +1,62 @@
+#include "esp32-modules/core/scheduling/TaskEvent.hpp"
+
+// Platform header
+#ifdef ESP_PLATFORM
+#include <esp_attr.h>
+#include <esp_timer.h>
+#else
+#define IRAM_ATTR
+#endif
+
+using namespace Esp32Modules::Core::Scheduling;
+
+TaskEvent::TaskEvent(CooperativeScheduler& scheduler, TaskFunction task)
+    : mScheduler{scheduler},
+      mTask{std::move(task)},
+      mPending{false},
+      mSignals{0},
+      mExecutions{0},
+      mNext{nullptr}
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+      ,
+      mSignalTime{0},
+      mMaxLatency{0},
+      mTotalLatency{0}
+#endif
+{
+}
+
+TaskEvent::~TaskEvent()
+{
+  if (mPending.load(std::memory_order_acquire))
+  {
+    mScheduler.WithdrawEvent(*this);
+  }
+}
+
+void IRAM_ATTR TaskEvent::Signal()
+{
+  mSignals.fetch_add(1, std::memory_order_relaxed);
+  if (mPending.exchange(true, std::memory_order_acq_rel))
+  {
+    return;  // Already in the ready queue.
+  }
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+#ifdef ESP_PLATFORM
+  // The clock of the scheduler is a virtual call into flash, read the timer directly instead.
+  mSignalTime.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_relaxed);
+#else
+  mSignalTime.store(mScheduler.mClock.Micros(), std::memory_order_relaxed);
+#endif
+#endif
+  mScheduler.EnqueueEvent(*this);
+}
+
+TaskEvent::Statistics TaskEvent::GetStatistics() const
+{
+#ifdef ESP32MODULES_SCHEDULER_PROFILING
+  return {mSignals.load(std::memory_order_relaxed), mExecutions, mMaxLatency, mTotalLatency};
+#else
+  return {mSignals.load(std::memory_order_relaxed), mExecutions};
+#endif
+}
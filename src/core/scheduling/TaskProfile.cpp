@@ -0,0 +1,43 @@
+#include "esp32-modules/core/scheduling/TaskProfile.hpp"
+
+using namespace Esp32Modules::Core::Scheduling;
+
+namespace
+{
+constexpr uint64_t MILLISECONDS_TO_US_FACTOR{1000};
+
+/** Maps the latency to its power of two bucket (0 -> 0, 1 -> 1, 2-3 -> 2, 4-7 -> 3, ...). */
+uint8_t LatencyBucket(const uint32_t latency)
+{
+  const uint8_t bucket = (latency == 0) ? 0 : (32 - __builtin_clz(latency));
+  return (bucket < TaskProfile::LATENCY_BUCKETS) ? bucket : (TaskProfile::LATENCY_BUCKETS - 1);
+}
+}  // namespace
+
+void TaskProfile::Record(const uint32_t startLatency, const uint32_t executionTime)
+{
+  if (runs == 0 or executionTime < minExecutionTime)
+  {
+    minExecutionTime = executionTime;
+  }
+  if (executionTime > maxExecutionTime)
+  {
+    maxExecutionTime = executionTime;
+  }
+  totalExecutionTime += executionTime;
+  ++runs;
+  if (executionTime > timeout * MILLISECONDS_TO_US_FACTOR)
+  {
+    ++overruns;
+  }
+  auto& bucket = latencyHistogram[LatencyBucket(startLatency)];
+  if (bucket < UINT16_MAX)
+  {
+    ++bucket;
+  }
+}
+
+uint32_t TaskProfile::AverageExecutionTime() const
+{
+  return (runs == 0) ? 0 : static_cast<uint32_t>(totalExecutionTime / runs);
+}
@@ -0,0 +1,212 @@
+#include "esp32-modules/core/scheduling/TimingWheel.hpp"
+
+using namespace Esp32Modules::Core::Scheduling;
+
+namespace
+{
+constexpr TimingWheel::Tick MAX_DELTA{0x7FFFFFFF};  //!< Expiries further away count as overdue.
+
+/** Rotates the 64 bit @p value by @p shift bits to the right. */
+inline uint64_t RotateRight(const uint64_t value, const uint8_t shift)
+{
+  return (shift == 0) ? value : ((value >> shift) | (value << (64 - shift)));
+}
+}  // namespace
+
+TimingWheel::TimingWheel(const Tick now)
+    : mNow{now},
+      mSlots{},
+      mOccupied{},
+      mExpiredHead{nullptr},
+      mExpiredTail{nullptr},
+      mExpiredCount{0}
+{
+}
+
+void TimingWheel::Schedule(Timer& timer, const Tick expiry)
+{
+  Cancel(timer);
+  timer.mExpiry = expiry;
+  Insert(timer);
+}
+
+void TimingWheel::Cancel(Timer& timer)
+{
+  if (not timer.IsScheduled())
+  {
+    return;
+  }
+  const bool expired = (timer.mLevel == EXPIRED_LEVEL);
+  Timer*& head = (expired ? mExpiredHead : mSlots[timer.mLevel][timer.mSlot]);
+  if (timer.mPrev)
+  {
+    timer.mPrev->mNext = timer.mNext;
+  }
+  else
+  {
+    head = timer.mNext;
+  }
+  if (timer.mNext)
+  {
+    timer.mNext->mPrev = timer.mPrev;
+  }
+  else if (expired)
+  {
+    mExpiredTail = timer.mPrev;
+  }
+  if (expired)
+  {
+    --mExpiredCount;
+  }
+  if (not expired and not head)
+  {
+    mOccupied[timer.mLevel] &= ~(uint64_t{1} << timer.mSlot);
+  }
+  timer.mNext = nullptr;
+  timer.mPrev = nullptr;
+  timer.mLevel = Timer::UNSCHEDULED;
+}
+
+void TimingWheel::Advance(const Tick now)
+{
+  while (mNow != now)
+  {
+    // Find the closest point in time at which a slot has to be processed.
+    Tick closest{0};
+    uint8_t closestLevel{LEVELS};
+    uint8_t closestSlot{0};
+    for (uint8_t level = 0; level < LEVELS; ++level)
+    {
+      if (not mOccupied[level])
+      {
+        continue;
+      }
+      const uint8_t shift = level * LEVEL_BITS;
+      const uint8_t slot = ClosestSlot(level);
+      // Time at which the slot is entered (lower bits zero, higher bits like now).
+      const uint8_t blockBits = shift + LEVEL_BITS;
+      const Tick higher = (blockBits >= 32) ? 0 : (mNow & ~((Tick{1} << blockBits) - 1));
+      const Tick delta = (higher | (static_cast<Tick>(slot) << shift)) - mNow;
+      if (closestLevel == LEVELS or delta < closest)
+      {
+        closest = delta;
+        closestLevel = level;
+        closestSlot = slot;
+      }
+    }
+    if (closestLevel == LEVELS or closest > (now - mNow))
+    {
+      mNow = now;  // Nothing of interest until now, the placement of all timers stays valid.
+      return;
+    }
+    mNow += closest;
+    Cascade(closestLevel, closestSlot);
+  }
+}
+
+bool TimingWheel::NextExpiry(Tick& expiry) const
+{
+  if (mExpiredHead)
+  {
+    expiry = mExpiredHead->mExpiry;  // Already expired, no need to look any further.
+    return true;
+  }
+  bool found{false};
+  Tick closest{0};
+  for (uint8_t level = 0; level < LEVELS; ++level)
+  {
+    if (not mOccupied[level])
+    {
+      continue;
+    }
+    // Only the closest slot of each level can contain the earliest expiry of the level.
+    for (const Timer* timer = mSlots[level][ClosestSlot(level)]; timer; timer = timer->mNext)
+    {
+      const Tick delta = timer->mExpiry - mNow;
+      if (not found or delta < closest)
+      {
+        closest = delta;
+        found = true;
+      }
+    }
+  }
+  expiry = mNow + closest;
+  return found;
+}
+
+TimingWheel::Timer* TimingWheel::PopExpired()
+{
+  Timer* timer = mExpiredHead;
+  if (timer)
+  {
+    Cancel(*timer);
+  }
+  return timer;
+}
+
+void TimingWheel::Insert(Timer& timer)
+{
+  const Tick delta = timer.mExpiry - mNow;
+  if (delta == 0 or delta > MAX_DELTA)
+  {
+    AppendExpired(timer);
+    return;
+  }
+  const uint8_t level = (31 - __builtin_clz(timer.mExpiry ^ mNow)) / LEVEL_BITS;
+  const uint8_t slot = (timer.mExpiry >> (level * LEVEL_BITS)) & (SLOTS - 1);
+  Timer*& head = mSlots[level][slot];
+  timer.mPrev = nullptr;
+  timer.mNext = head;
+  if (head)
+  {
+    head->mPrev = &timer;
+  }
+  head = &timer;
+  timer.mLevel = level;
+  timer.mSlot = slot;
+  mOccupied[level] |= (uint64_t{1} << slot);
+}
+
+void TimingWheel::AppendExpired(Timer& timer)
+{
+  timer.mNext = nullptr;
+  timer.mPrev = mExpiredTail;
+  if (mExpiredTail)
+  {
+    mExpiredTail->mNext = &timer;
+  }
+  else
+  {
+    mExpiredHead = &timer;
+  }
+  mExpiredTail = &timer;
+  timer.mLevel = EXPIRED_LEVEL;
+  ++mExpiredCount;
+}
+
+void TimingWheel::Cascade(const uint8_t level, const uint8_t slot)
+{
+  Timer* timer = mSlots[level][slot];
+  mSlots[level][slot] = nullptr;
+  mOccupied[level] &= ~(uint64_t{1} << slot);
+  // Slots are filled at the front, so moving the timers from the back keeps timers with the same
+  // expiry in order of scheduling.
+  while (timer and timer->mNext)
+  {
+    timer = timer->mNext;
+  }
+  while (timer)
+  {
+    Timer* previous = timer->mPrev;
+    Insert(*timer);  // Either expires the timer or moves it to a lower level.
+    timer = previous;
+  }
+}
+
+uint8_t TimingWheel::ClosestSlot(const uint8_t level) const
+{
+  // Search the occupied slots in circular order, starting right after the current one.
+  const uint8_t current = (mNow >> (level * LEVEL_BITS)) & (SLOTS - 1);
+  const uint8_t start = (current + 1) & (SLOTS - 1);
+  return (start + __builtin_ctzll(RotateRight(mOccupied[level], start))) & (SLOTS - 1);
+}
@@ -0,0 +1,198 @@
+#include "esp32-modules/core/scheduling/WorkStealingExecutor.hpp"
+
+// Platform header
+#ifdef ESP_PLATFORM
+#include <esp_pthread.h>
+#endif
+
+using namespace Esp32Modules::Core::Scheduling;
+
+static_assert((WorkStealingExecutor::MAX_JOBS & (WorkStealingExecutor::MAX_JOBS - 1)) == 0,
+              "ESP32MODULES_EXECUTOR_MAX_JOBS must be a power of two.");
+static_assert(WorkStealingExecutor::WORKERS > 0, "At least one worker is required.");
+
+WorkStealingExecutor::WorkStealingExecutor(CooperativeScheduler& scheduler,
+                                           const TaskDuration completionInterval)
+    : mScheduler{scheduler},
+      mCompletionTask{INVALID_TASKID},
+      mJobs{},
+      mWorkers{},
+      mNextWorker{0},
+      mCompleted{nullptr},
+      mPending{0},
+      mRunning{true},
+      mWakeMutex{},
+      mWakeUp{}
+{
+  for (uint8_t i = 0; i < WORKERS; ++i)
+  {
+#ifdef ESP_PLATFORM
+    // Pin each worker to its own core, the threads inherit this configuration. Never preempt the
+    // cooperative loop on its core (see the class description).
+    auto config = esp_pthread_get_default_config();
+    config.stack_size = ESP32MODULES_EXECUTOR_STACK_SIZE;
+    config.pin_to_core = i % portNUM_PROCESSORS;
+    if (config.pin_to_core == ESP32MODULES_EXECUTOR_LOOP_CORE)
+    {
+      config.prio = ESP32MODULES_EXECUTOR_LOOP_CORE_PRIORITY;
+    }
+    esp_pthread_set_cfg(&config);
+#endif
+    mWorkers[i].thread = std::thread{[this, i]() { RunWorker(i); }};
+  }
+#ifdef ESP_PLATFORM
+  auto config = esp_pthread_get_default_config();
+  esp_pthread_set_cfg(&config);
+#endif
+  mCompletionTask =
+      mScheduler.AddCyclicTask(completionInterval, [this]() { ProcessCompletions(); });
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+  mScheduler.AbortTask(mCompletionTask);
+  {
+    std::lock_guard<std::mutex> lock{mWakeMutex};
+    mRunning.store(false);
+  }
+  mWakeUp.notify_all();
+  for (auto& worker : mWorkers)
+  {
+    if (worker.thread.joinable())
+    {
+      worker.thread.join();
+    }
+  }
+  // Jobs left in the deques or the completion queue are destroyed by the pool.
+}
+
+JobId WorkStealingExecutor::Post(TaskFunction work, TaskFunction completion, const int8_t affinity)
+{
+  if (not work)
+  {
+    return INVALID_JOBID;
+  }
+  const JobId id = mJobs.Emplace(std::move(work), std::move(completion));
+  auto* job = mJobs.Get(id);
+  if (not job)
+  {
+    return INVALID_JOBID;
+  }
+  job->id = id;
+
+  // Prefer the requested worker, fall back to the others if its deque is full.
+  uint8_t first = mNextWorker;
+  if (affinity >= 0 and affinity < WORKERS)
+  {
+    first = static_cast<uint8_t>(affinity);
+  }
+  else
+  {
+    mNextWorker = (mNextWorker + 1) % WORKERS;
+  }
+  {
+    // Count the job before it becomes visible, so the counter never drops below zero when a
+    // worker takes it right away. Incrementing under the mutex ensures no worker misses the
+    // wake-up between checking the counter and waiting.
+    std::lock_guard<std::mutex> lock{mWakeMutex};
+    mPending.fetch_add(1);
+  }
+  bool posted{false};
+  for (uint8_t i = 0; i < WORKERS and not posted; ++i)
+  {
+    posted = mWorkers[(first + i) % WORKERS].deque.Push(job);
+  }
+  if (not posted)
+  {
+    // Cannot happen as long as the deques hold as many jobs as the pool.
+    mPending.fetch_sub(1);
+    mJobs.Release(id);
+    return INVALID_JOBID;
+  }
+  mWakeUp.notify_all();
+  return id;
+}
+
+uint16_t WorkStealingExecutor::ProcessCompletions()
+{
+  // Detach all completed jobs at once, they are stacked in reverse order of completion.
+  Job* stack = mCompleted.exchange(nullptr, std::memory_order_acquire);
+  Job* queue{nullptr};
+  while (stack)
+  {
+    Job* next = stack->next;
+    stack->next = queue;
+    queue = stack;
+    stack = next;
+  }
+
+  uint16_t count{0};
+  while (queue)
+  {
+    Job* job = queue;
+    queue = job->next;
+    if (job->completion)
+    {
+      job->completion();
+    }
+    mJobs.Release(job->id);
+    ++count;
+  }
+  return count;
+}
+
+WorkStealingExecutor::WorkerStatistics WorkStealingExecutor::GetWorkerStatistics(
+    const uint8_t worker) const
+{
+  if (worker >= WORKERS)
+  {
+    return {0, 0};
+  }
+  return {mWorkers[worker].executed.load(std::memory_order_relaxed),
+          mWorkers[worker].stolen.load(std::memory_order_relaxed)};
+}
+
+void WorkStealingExecutor::RunWorker(const uint8_t index)
+{
+  auto& self = mWorkers[index];
+  while (mRunning.load(std::memory_order_relaxed))
+  {
+    Job* job = TakeJob(index);
+    if (not job)
+    {
+      std::unique_lock<std::mutex> lock{mWakeMutex};
+      mWakeUp.wait(lock, [this]() { return not mRunning.load() or mPending.load() > 0; });
+      continue;
+    }
+
+    job->work();
+    self.executed.fetch_add(1, std::memory_order_relaxed);
+
+    // Hand the job back to the cooperative loop (lock-free push onto the completion stack).
+    Job* head = mCompleted.load(std::memory_order_relaxed);
+    do
+    {
+      job->next = head;
+    } while (not mCompleted.compare_exchange_weak(head, job, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+  }
+}
+
+WorkStealingExecutor::Job* WorkStealingExecutor::TakeJob(const uint8_t index)
+{
+  for (uint8_t i = 0; i < WORKERS; ++i)
+  {
+    const uint8_t victim = (index + i) % WORKERS;
+    Job* job = mWorkers[victim].deque.Steal();
+    if (job)
+    {
+      mPending.fetch_sub(1);
+      if (victim != index)
+      {
+        mWorkers[index].stolen.fetch_add(1, std::memory_order_relaxed);
+      }
+      return job;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,69 @@
+#include "esp32-modules/core/time/Clock.hpp"
+
+// Standard header
+#include <chrono>
+
+#ifdef ARDUINO
+// Platform header
+#include <Arduino.h>  // Necessary for millis and micros
+
+// Project header
+#include <esp32-modules/core/low-power/DeepSleep.hpp>
+#include <esp32-modules/core/low-power/LightSleep.hpp>
+#else
+// Standard header
+#include <thread>
+#endif
+
+namespace Esp32Modules::Core::Time
+{
+#ifdef ARDUINO
+uint32_t SystemClock::Millis() const { return millis(); }
+
+uint32_t SystemClock::Micros() const { return micros(); }
+
+void SystemClock::LightSleep(const uint32_t duration)
+{
+  LowPower::LightSleepFor(std::chrono::milliseconds{duration});
+}
+
+void SystemClock::DeepSleep(const uint32_t duration)
+{
+  // Round up: waking up early would find the next task not yet due (and 999 ms would not sleep).
+  LowPower::DeepSleepFor(
+      std::chrono::ceil<std::chrono::seconds>(std::chrono::milliseconds{duration}));
+}
+#else
+// Host builds (e.g. for off-target runs of the scheduler) use the steady clock and just block.
+namespace
+{
+uint64_t MicrosSinceStart()
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               start)
+      .count();
+}
+}  // namespace
+
+uint32_t SystemClock::Millis() const { return static_cast<uint32_t>(MicrosSinceStart() / 1000); }
+
+uint32_t SystemClock::Micros() const { return static_cast<uint32_t>(MicrosSinceStart()); }
+
+void SystemClock::LightSleep(const uint32_t duration)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds{duration});
+}
+
+void SystemClock::DeepSleep(const uint32_t duration)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds{duration});
+}
+#endif
+
+Clock& GetSystemClock()
+{
+  static SystemClock clock;
+  return clock;
+}
+}  // namespace Esp32Modules::Core::Time
@@ -0,0 +1,44 @@
+#include "esp32-modules/core/time/SimulatedClock.hpp"
+
+namespace Esp32Modules::Core::Time
+{
+namespace
+{
+constexpr uint64_t MILLISECONDS_TO_US_FACTOR{1000};
+}  // namespace
+
+SimulatedClock::SimulatedClock(const uint32_t start)
+    : mNow{start * MILLISECONDS_TO_US_FACTOR}, mStatistics{0, 0, 0}
+{
+}
+
+uint32_t SimulatedClock::Millis() const
+{
+  return static_cast<uint32_t>(mNow / MILLISECONDS_TO_US_FACTOR);
+}
+
+uint32_t SimulatedClock::Micros() const { return static_cast<uint32_t>(mNow); }
+
+void SimulatedClock::LightSleep(const uint32_t duration)
+{
+  ++mStatistics.lightSleeps;
+  mStatistics.sleptDuration += duration;
+  mNow += duration * MILLISECONDS_TO_US_FACTOR;
+}
+
+void SimulatedClock::DeepSleep(const uint32_t duration)
+{
+  ++mStatistics.deepSleeps;
+  mStatistics.sleptDuration += duration;
+  mNow += duration * MILLISECONDS_TO_US_FACTOR;
+}
+
+void SimulatedClock::Advance(const uint32_t duration)
+{
+  mNow += duration * MILLISECONDS_TO_US_FACTOR;
+}
+
+void SimulatedClock::AdvanceMicros(const uint32_t duration) { mNow += duration; }
+
+const SimulatedClock::Statistics& SimulatedClock::GetStatistics() const { return mStatistics; }
+}  // namespace Esp32Modules::Core::Time
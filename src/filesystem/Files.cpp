@@ -73,6 +73,13 @@ bool RegularFile::Write(const std::string& data, const bool append)
   return WriteBytes(Bytestream{data.data(), data.data() + data.size()}, append);
 }
 
+File RegularFile::OpenForWriting(const bool append)
+{
+  return mFS.open(mPath.c_str(), (append ? FILE_APPEND : FILE_WRITE));
+}
+
+File RegularFile::OpenForReading() { return mFS.open(mPath.c_str(), FILE_READ); }
+
 bool RegularFile::Move(fs::FS& fs, const std::string& oldPath, const std::string& newPath)
 {
   return fs.rename(oldPath.c_str(), newPath.c_str());
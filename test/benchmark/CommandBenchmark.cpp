@@ -0,0 +1,129 @@
+// Benchmarks of the command handling, each with 10 to 1000 registered tokens:
+//   TableFind     Host time to parse a command and look up its callback.
+//   TableMiss     Host time to look up an unknown token.
+//   RouterShared  Host time per command dispatched by a router shared by 1 to 4 transport threads.
+//   FrameDecode   Host throughput of reassembling binary frames from writes of the given size.
+
+// Standard header
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-party header
+#include <benchmark/benchmark.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandFrame.hpp>
+#include <esp32-modules/connectivity/CommandRouter.hpp>
+#include <esp32-modules/connectivity/CommandTable.hpp>
+
+using namespace Esp32Modules::Connectivity;
+
+namespace
+{
+void TokenCounts(benchmark::internal::Benchmark* benchmark)
+{
+  for (const int64_t tokens : {10, 100, 1000})
+  {
+    benchmark->Arg(tokens);
+  }
+}
+
+/** Registers the tokens "command0" to "command<n-1>" and provides commands for them. */
+std::vector<std::string> Register(CommandTable& table, const int64_t tokens, uint64_t& calls)
+{
+  std::vector<std::string> commands;
+  for (int64_t i = 0; i < tokens; ++i)
+  {
+    const std::string token = "command" + std::to_string(i);
+    table.Register(token, [&calls](std::string_view) { ++calls; });
+    commands.push_back(token + " 42");
+  }
+  return commands;
+}
+
+void TableFind(benchmark::State& state)
+{
+  CommandTable table;
+  uint64_t calls{0};
+  const auto commands = Register(table, state.range(0), calls);
+  size_t next{0};
+  for (auto _ : state)
+  {
+    const auto command = ParseCommand(commands[next]);
+    (*table.Find(command.token))(command.parameters);
+    next = (next + 1) % commands.size();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(calls));
+}
+BENCHMARK(TableFind)->Apply(TokenCounts);
+
+void TableMiss(benchmark::State& state)
+{
+  CommandTable table;
+  uint64_t calls{0};
+  Register(table, state.range(0), calls);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(table.Find("unknown"));
+  }
+}
+BENCHMARK(TableMiss)->Apply(TokenCounts);
+
+/** Router shared by the benchmark threads, set up once. */
+CommandRouter& SharedRouter()
+{
+  static CommandRouter router;
+  static const bool registered = [] {
+    for (int i = 0; i < 100; ++i)
+    {
+      router.Register("command" + std::to_string(i), [](std::string_view) {});
+    }
+    return true;
+  }();
+  (void)registered;
+  return router;
+}
+
+void RouterShared(benchmark::State& state)
+{
+  auto& router = SharedRouter();
+  const std::string command = "command" + std::to_string(state.thread_index() * 7) + " 42";
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(router.Dispatch(command));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(RouterShared)->ThreadRange(1, 4)->UseRealTime();
+
+void FrameDecode(benchmark::State& state)
+{
+  const auto writeSize = static_cast<size_t>(state.range(0));
+  std::vector<uint8_t> stream;
+  uint8_t payload[64];
+  uint8_t frame[FRAME_MAX_SIZE];
+  for (size_t i = 0; i < 64; ++i)
+  {
+    payload[i] = static_cast<uint8_t>(i);
+    stream.insert(stream.end(), frame, frame + EncodeFrame(1, payload, i, frame, sizeof(frame)));
+  }
+  FrameDecoder decoder;
+  uint64_t frames{0};
+  for (auto _ : state)
+  {
+    for (size_t offset = 0; offset < stream.size(); offset += writeSize)
+    {
+      decoder.Feed(&stream[offset], std::min(writeSize, stream.size() - offset),
+                   [&frames](const CommandFrame&) { ++frames; });
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+  state.counters["frames"] = static_cast<double>(frames);
+}
+BENCHMARK(FrameDecode)->Arg(20)->Arg(244);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+// Benchmarks of the WorkStealingExecutor (host threads instead of the ESP32 cores):
+//   RoundTrip     Host time from posting a batch of jobs until all completions ran in the loop.
+//   Imbalanced    Same with all jobs posted to a single worker (the others have to steal).
+
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Third-party header
+#include <benchmark/benchmark.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/WorkStealingExecutor.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+/** Burns roughly the given number of iterations of host CPU time. */
+void Spin(const uint32_t iterations)
+{
+  uint32_t value{0};
+  for (uint32_t i = 0; i < iterations; ++i)
+  {
+    benchmark::DoNotOptimize(value += i);
+  }
+}
+
+void RunBatches(benchmark::State& state, const int8_t affinity)
+{
+  const auto work = static_cast<uint32_t>(state.range(0));
+  SchedulerHarness harness;
+  WorkStealingExecutor executor{harness.Scheduler()};
+  uint32_t completed{0};
+  for (auto _ : state)
+  {
+    completed = 0;
+    for (uint16_t i = 0; i < WorkStealingExecutor::MAX_JOBS; ++i)
+    {
+      executor.Post([work] { Spin(work); }, [&completed] { ++completed; }, affinity);
+    }
+    while (completed < WorkStealingExecutor::MAX_JOBS)
+    {
+      executor.ProcessCompletions();
+      std::this_thread::yield();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * WorkStealingExecutor::MAX_JOBS);
+  uint32_t stolen{0};
+  for (uint8_t i = 0; i < WorkStealingExecutor::WORKERS; ++i)
+  {
+    stolen += executor.GetWorkerStatistics(i).stolen;
+  }
+  state.counters["stolen"] = stolen;
+}
+
+void RoundTrip(benchmark::State& state) { RunBatches(state, ANY_WORKER); }
+BENCHMARK(RoundTrip)->Arg(0)->Arg(1000)->Arg(100000)->UseRealTime();
+
+void Imbalanced(benchmark::State& state) { RunBatches(state, 0); }
+BENCHMARK(Imbalanced)->Arg(0)->Arg(1000)->Arg(100000)->UseRealTime();
+}  // namespace
+
+BENCHMARK_MAIN();
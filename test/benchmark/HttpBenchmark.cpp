@@ -0,0 +1,134 @@
+// Benchmarks of the platform-independent HTTP helpers:
+//   RouterMatch  Host time to match a path against 10 to 1000 routes (half of them with a capture).
+//   HubFanOut    Host time to publish an event and read it by 1 to 16 subscribers.
+//   PoolAcquire  Host time to acquire and release a pooled connection, requesting 1 host (always
+//                reused) or more hosts than connections (always reconnected), with transports
+//                that do not touch the network, so only the bookkeeping of the pool is measured.
+
+// Standard header
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Third-party header
+#include <benchmark/benchmark.h>
+
+// Project header
+#include <esp32-modules/connectivity/EventHub.hpp>
+#include <esp32-modules/connectivity/HttpConnectionPool.hpp>
+#include <esp32-modules/connectivity/PathRouter.hpp>
+#include <esp32-modules/core/time/SimulatedClock.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+using Esp32Modules::Core::Time::SimulatedClock;
+
+namespace
+{
+void RouteCounts(benchmark::internal::Benchmark* benchmark)
+{
+  for (const int64_t routes : {10, 100, 1000})
+  {
+    benchmark->Arg(routes);
+  }
+}
+
+void RouterMatch(benchmark::State& state)
+{
+  PathRouter router;
+  std::vector<std::string> paths;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    const std::string prefix =
+        "/api/v1/group" + std::to_string(i % 10) + "/item" + std::to_string(i);
+    router.Add(prefix + (i % 2 ? "/{id}" : "/value"));
+    paths.push_back(prefix + (i % 2 ? "/123" : "/value"));
+  }
+  size_t next{0};
+  int64_t matched{0};
+  for (auto _ : state)
+  {
+    RouteMatch match;
+    matched += router.Match(paths[next], match);
+    benchmark::DoNotOptimize(match);
+    next = (next + 1) % paths.size();
+  }
+  if (matched != static_cast<int64_t>(state.iterations()))
+  {
+    state.SkipWithError("Path not matched");
+  }
+  state.SetItemsProcessed(matched);
+}
+BENCHMARK(RouterMatch)->Apply(RouteCounts);
+
+void HubFanOut(benchmark::State& state)
+{
+  const auto subscribers = static_cast<size_t>(state.range(0));
+  EventHub hub{ESP32MODULES_HTTP_EVENT_QUEUE_LENGTH, subscribers};
+  std::vector<EventHub::SubscriberId> ids;
+  for (size_t i = 0; i < subscribers; ++i)
+  {
+    ids.push_back(hub.Subscribe());
+  }
+  const std::string payload{"{\"temperature\":21.5,\"humidity\":40.2}"};
+  uint8_t buffer[1436];  // Payload of a TCP segment.
+  int64_t bytes{0};
+  for (auto _ : state)
+  {
+    hub.Publish(payload, "sensor");
+    for (const auto id : ids)
+    {
+      bytes += static_cast<int64_t>(hub.Read(id, buffer, sizeof(buffer)));
+    }
+  }
+  if (hub.GetStatistics().dropped != 0)
+  {
+    state.SkipWithError("Subscriber dropped");
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(hub.GetStatistics().delivered));
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(HubFanOut)->Arg(1)->Arg(4)->Arg(16);
+
+/** Transport connecting instantly, to measure the pool alone. */
+class NullTransport : public HttpTransport
+{
+ public:
+  bool Connect() override { return true; }
+  bool Begin(const std::string&) override { return true; }
+  void End() override {}
+  bool Connected() override { return true; }
+};
+
+void PoolAcquire(benchmark::State& state)
+{
+  SimulatedClock clock;  // Advanced per request, so the least recently used one is unambiguous.
+  HttpConnectionPool pool{[](const HttpOrigin&) { return std::make_unique<NullTransport>(); },
+                          ESP32MODULES_HTTP_IDLE_TIMEOUT, &clock};
+  std::vector<std::string> urls;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    urls.push_back("http://host" + std::to_string(i) + ".local:8080/api/v1/value");
+  }
+  size_t next{0};
+  for (auto _ : state)
+  {
+    auto* transport = pool.Acquire(urls[next]);
+    if (not transport)
+    {
+      state.SkipWithError("Not acquired");
+      break;
+    }
+    pool.Release(*transport);
+    clock.Advance(1);
+    next = (next + 1) % urls.size();
+  }
+  const auto statistics = pool.GetStatistics();
+  state.counters["reused"] = benchmark::Counter(
+      statistics.requests ? static_cast<double>(statistics.reused) / statistics.requests : 0.0);
+  state.SetItemsProcessed(static_cast<int64_t>(statistics.requests));
+}
+BENCHMARK(PoolAcquire)->Arg(1)->Arg(ESP32MODULES_HTTP_MAX_CONNECTIONS + 1);
+}  // namespace
+
+BENCHMARK_MAIN();
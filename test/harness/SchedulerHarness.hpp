@@ -0,0 +1,127 @@
+/**
+ * @file SchedulerHarness.hpp
+ * @author Joschka Seydell (joschka@seydell.org)
+ * @brief Provides a deterministic host harness running the scheduler on simulated time.
+ * @version 0.1
+ * @date 2021-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#ifndef ESP32MODULES__TEST_SCHEDULERHARNESS_HPP_
+#define ESP32MODULES__TEST_SCHEDULERHARNESS_HPP_
+
+// Standard header
+#include <cstdint>
+#include <memory>
+
+// Project header
+#include <esp32-modules/core/scheduling/CooperativeScheduler.hpp>
+#include <esp32-modules/core/scheduling/IdlePolicy.hpp>
+#include <esp32-modules/core/time/SimulatedClock.hpp>
+
+namespace Esp32Modules::Test
+{
+/**
+ * @brief Runs a CooperativeScheduler on a SimulatedClock.
+ *
+ * Idle passes are handled by a TicklessIdlePolicy, i.e. the simulated time jumps to the next due
+ * task instead of spinning. Time only passes while sleeping or when tasks charge simulated work
+ * (see Work()), so runs are fully deterministic and seconds of device time take microseconds.
+ */
+class SchedulerHarness
+{
+ public:
+  using CooperativeScheduler = Core::Scheduling::CooperativeScheduler;
+  using TaskDuration = Core::Scheduling::TaskDuration;
+  using TaskFunction = Core::Scheduling::TaskFunction;
+
+  /**
+   * @brief Sets up the clock, the idle policy and the scheduler.
+   *
+   * @param mainInterval Interval of the main task.
+   * @param mainTask Main task - does nothing if empty.
+   * @param start Initial time in milliseconds (e.g. close to the 32 bit wrap-around).
+   */
+  explicit SchedulerHarness(const TaskDuration mainInterval = TASK_HOUR,
+                            TaskFunction mainTask = {}, const uint32_t start = 0)
+      : mClock{start},
+        mIdlePolicy{mClock},
+        mScheduler{std::make_unique<CooperativeScheduler>(
+            mainTask ? std::move(mainTask) : TaskFunction{[] {}}, mainInterval, &mClock)},
+        mPasses{0}
+  {
+    mScheduler->SetIdlePolicy(&mIdlePolicy);
+  }
+  ~SchedulerHarness() = default;
+
+  SchedulerHarness(const SchedulerHarness&) = delete;
+  SchedulerHarness& operator=(const SchedulerHarness&) = delete;
+
+  /** @brief Scheduler under test (allocated on the heap, it may be large). */
+  CooperativeScheduler& Scheduler() { return *mScheduler; }
+
+  /** @brief Simulated time of the scheduler. */
+  Core::Time::SimulatedClock& Clock() { return mClock; }
+
+  /**
+   * @brief Charges simulated execution time (to be called from within tasks).
+   *
+   * @param duration Microseconds the current task takes.
+   */
+  void Work(const uint32_t duration) { mClock.AdvanceMicros(duration); }
+
+  /**
+   * @brief Executes all tasks due within the given time, sleeping in between.
+   *
+   * Afterwards, the simulated time is exactly the given time later (unless the tasks took longer).
+   *
+   * @param duration Simulated milliseconds to run.
+   * @return Number of passes executing at least one task.
+   */
+  uint32_t RunFor(const TaskDuration duration)
+  {
+    const uint32_t start = mClock.Millis();
+    uint32_t executed{0};
+    while (true)
+    {
+      const uint64_t elapsed = mClock.Millis() - start;
+      const TaskDuration next = mScheduler->TimeUntilNextTask();
+      if (next == Core::Scheduling::NO_TASK_PENDING or elapsed + next > duration)
+      {
+        if (elapsed < duration)
+        {
+          mClock.Advance(static_cast<uint32_t>(duration - elapsed));
+        }
+        return executed;
+      }
+      if (Pass())
+      {
+        ++executed;
+      }
+    }
+  }
+
+  /**
+   * @brief Executes a single pass.
+   *
+   * @return true if at least one task was executed.
+   */
+  bool Pass()
+  {
+    ++mPasses;
+    return mScheduler->ExecuteNext() == CooperativeScheduler::ExecutionResult::OK;
+  }
+
+  /** @brief Number of passes executed so far. */
+  uint32_t GetPasses() const { return mPasses; }
+
+ private:
+  Core::Time::SimulatedClock mClock;                 //!< Simulated time.
+  Core::Scheduling::TicklessIdlePolicy mIdlePolicy;  //!< Sleeps until the next task.
+  std::unique_ptr<CooperativeScheduler> mScheduler;  //!< Scheduler under test.
+  uint32_t mPasses;                                  //!< Number of passes executed.
+};
+}  // namespace Esp32Modules::Test
+
+#endif  // ESP32MODULES__TEST_SCHEDULERHARNESS_HPP_
@@ -0,0 +1,166 @@
+// Standard header
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandFrame.hpp>
+
+using namespace Esp32Modules::Connectivity;
+
+namespace
+{
+/** Frame as sent by a peer. */
+struct Sent
+{
+  uint8_t id;
+  std::vector<uint8_t> payload;
+
+  bool operator==(const Sent& other) const { return id == other.id and payload == other.payload; }
+};
+
+/** Encodes the frame and appends it to the stream. */
+void Append(const Sent& frame, std::vector<uint8_t>& stream)
+{
+  uint8_t buffer[FRAME_MAX_SIZE];
+  const size_t size = EncodeFrame(frame.id, frame.payload.data(), frame.payload.size(), buffer,
+                                  sizeof(buffer));
+  ASSERT_GT(size, 0u);
+  stream.insert(stream.end(), buffer, buffer + size);
+}
+
+/** Creates a frame with random id and payload (sync bytes included on purpose). */
+Sent RandomFrame(std::mt19937& random)
+{
+  Sent frame{static_cast<uint8_t>(random()), {}};
+  const size_t length = (random() % 8 == 0) ? FRAME_MAX_PAYLOAD : random() % 40;
+  for (size_t i = 0; i < length; ++i)
+  {
+    frame.payload.push_back((random() % 16 == 0) ? FRAME_SYNC : static_cast<uint8_t>(random()));
+  }
+  return frame;
+}
+
+/** Feeds the stream in writes of the given size and collects the decoded frames. */
+std::vector<Sent> Decode(FrameDecoder& decoder, const std::vector<uint8_t>& stream,
+                         const size_t writeSize)
+{
+  std::vector<Sent> decoded;
+  for (size_t offset = 0; offset < stream.size(); offset += writeSize)
+  {
+    const size_t length = std::min(writeSize, stream.size() - offset);
+    decoder.Feed(&stream[offset], length, [&decoded](const CommandFrame& frame) {
+      decoded.push_back({frame.id, {frame.payload, frame.payload + frame.length}});
+    });
+  }
+  return decoded;
+}
+}  // namespace
+
+TEST(CommandFrameTest, Crc16MatchesTheCcittFalseCheckValue)
+{
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(Crc16(check, sizeof(check)), 0x29B1);
+  // Continuing over split data yields the same checksum.
+  EXPECT_EQ(Crc16(&check[4], 5, Crc16(check, 4)), 0x29B1);
+}
+
+TEST(CommandFrameTest, EncodingRejectsOversizedPayloadsAndSmallBuffers)
+{
+  std::vector<uint8_t> payload(FRAME_MAX_PAYLOAD + 1);
+  uint8_t buffer[FRAME_MAX_SIZE + 1];
+  EXPECT_EQ(EncodeFrame(1, payload.data(), payload.size(), buffer, sizeof(buffer)), 0u);
+  EXPECT_EQ(EncodeFrame(1, payload.data(), 3, buffer, FRAME_HEADER_SIZE + 4), 0u);
+  EXPECT_EQ(EncodeFrame(1, payload.data(), 3, buffer, FRAME_HEADER_SIZE + 5), 9u);
+  EXPECT_EQ(EncodeFrame(1, nullptr, 0, buffer, sizeof(buffer)), 6u);
+}
+
+TEST(CommandFrameTest, RoundTripsAcrossAllWriteSizes)
+{
+  std::mt19937 random{7};
+  std::vector<Sent> frames;
+  std::vector<uint8_t> stream;
+  for (int i = 0; i < 300; ++i)
+  {
+    frames.push_back(RandomFrame(random));
+    Append(frames.back(), stream);
+  }
+  // Single bytes, default and typical negotiated MTUs (minus the ATT header), whole buffer.
+  for (const size_t writeSize : {size_t{1}, size_t{7}, size_t{20}, size_t{182}, size_t{244},
+                                 size_t{509}, FRAME_MAX_SIZE, stream.size()})
+  {
+    FrameDecoder decoder;
+    ASSERT_EQ(Decode(decoder, stream, writeSize), frames) << "write size " << writeSize;
+    const auto statistics = decoder.GetStatistics();
+    EXPECT_EQ(statistics.frames, frames.size());
+    EXPECT_EQ(statistics.corrupted, 0u);
+    EXPECT_EQ(statistics.skipped, 0u);
+  }
+}
+
+TEST(CommandFrameTest, RecoversAllIntactFramesFromACorruptedStream)
+{
+  for (const uint32_t seed : {1u, 2u, 3u, 4u})
+  {
+    std::mt19937 random{seed};
+    std::vector<Sent> intact;
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 500; ++i)
+    {
+      const Sent frame = RandomFrame(random);
+      const size_t start = stream.size();
+      Append(frame, stream);
+      switch (random() % 6)
+      {
+        case 0:  // Flip a single bit (always detected by the CRC).
+          stream[start + random() % (stream.size() - start)] ^= 1u << (random() % 8);
+          break;
+        case 1:  // Lose the end of the frame.
+          stream.resize(start + 1 + random() % (stream.size() - start - 1));
+          break;
+        case 2:  // Noise in between frames, possibly looking like a frame start.
+          intact.push_back(frame);
+          for (uint32_t n = random() % 10; n > 0; --n)
+          {
+            stream.push_back((random() % 4 == 0) ? FRAME_SYNC : static_cast<uint8_t>(random()));
+          }
+          break;
+        default:
+          intact.push_back(frame);
+          break;
+      }
+    }
+    // Frames claimed by corrupted headers are only released once enough bytes followed.
+    stream.insert(stream.end(), FRAME_MAX_SIZE, 0);
+
+    FrameDecoder decoder;
+    EXPECT_EQ(Decode(decoder, stream, 1 + random() % 64), intact) << "seed " << seed;
+    EXPECT_GT(decoder.GetStatistics().corrupted, 0u);
+    EXPECT_GT(decoder.GetStatistics().skipped, 0u);
+  }
+}
+
+TEST(CommandFrameTest, ResetDropsAPartialFrame)
+{
+  std::vector<uint8_t> partial;
+  Append({1, std::vector<uint8_t>(100, 0x11)}, partial);
+  partial.resize(50);
+  std::vector<uint8_t> next;
+  const Sent frame{2, {1, 2, 3}};
+  Append(frame, next);
+
+  // Without a reset, the next frame is taken as the rest of the partial one.
+  FrameDecoder stale;
+  Decode(stale, partial, partial.size());
+  EXPECT_TRUE(Decode(stale, next, next.size()).empty());
+
+  FrameDecoder decoder;
+  Decode(decoder, partial, partial.size());
+  decoder.Reset();
+  EXPECT_EQ(Decode(decoder, next, next.size()), std::vector<Sent>{frame});
+  EXPECT_EQ(decoder.GetStatistics().corrupted, 0u);
+}
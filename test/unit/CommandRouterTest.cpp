@@ -0,0 +1,119 @@
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandRouter.hpp>
+
+using namespace Esp32Modules::Connectivity;
+using DispatchResult = CommandRouter::DispatchResult;
+
+namespace
+{
+/** Transport handing received lines to the router (like the UART or BLE receivers). */
+class FakeTransport
+{
+ public:
+  explicit FakeTransport(CommandRouter& router) : mRouter{router} {}
+
+  /** Dispatches each newline terminated command of the received bytes. */
+  std::vector<DispatchResult> Receive(std::string_view bytes)
+  {
+    std::vector<DispatchResult> results;
+    for (auto end = bytes.find('\n'); end != std::string_view::npos; end = bytes.find('\n'))
+    {
+      results.push_back(mRouter.Dispatch(bytes.substr(0, end)));
+      bytes.remove_prefix(end + 1);
+    }
+    return results;
+  }
+
+ private:
+  CommandRouter& mRouter;
+};
+}  // namespace
+
+TEST(CommandRouterTest, SharedRouterServesAllTransports)
+{
+  CommandRouter router;
+  std::vector<std::string> calls;
+  ASSERT_TRUE(router.Register("led", [&calls](const std::string_view parameters) {
+    calls.emplace_back(parameters);
+  }));
+  EXPECT_FALSE(router.Register("led", [](std::string_view) {}));
+
+  FakeTransport ble{router};
+  FakeTransport uart{router};
+  EXPECT_EQ(ble.Receive("led on\n"), std::vector<DispatchResult>{DispatchResult::OK});
+  EXPECT_EQ(uart.Receive("led off\nfan on\n\nled\n"),
+            (std::vector<DispatchResult>{DispatchResult::OK, DispatchResult::UNKNOWN_COMMAND,
+                                         DispatchResult::EMPTY_COMMAND, DispatchResult::OK}));
+  EXPECT_EQ(calls, (std::vector<std::string>{"on", "off", ""}));
+
+  const auto statistics = router.GetStatistics();
+  EXPECT_EQ(statistics.dispatched, 3u);
+  EXPECT_EQ(statistics.unknown, 2u);
+}
+
+TEST(CommandRouterTest, DispatchesSplitCommands)
+{
+  CommandRouter router;
+  std::string received;
+  router.Register("set", [&received](const std::string_view parameters) {
+    received = parameters;
+  });
+  EXPECT_EQ(router.Dispatch(CommandView{"set", "a b"}), DispatchResult::OK);
+  EXPECT_EQ(received, "a b");
+  EXPECT_EQ(router.Dispatch(CommandView{"", "a"}), DispatchResult::EMPTY_COMMAND);
+}
+
+TEST(CommandRouterTest, CallbacksMayRegisterFurtherCommands)
+{
+  CommandRouter router;
+  int later{0};
+  router.Register("enable", [&](std::string_view) {
+    router.Register("later", [&later](std::string_view) { ++later; });
+  });
+  EXPECT_EQ(router.Dispatch("later"), DispatchResult::UNKNOWN_COMMAND);
+  EXPECT_EQ(router.Dispatch("enable"), DispatchResult::OK);
+  EXPECT_EQ(router.Dispatch("later"), DispatchResult::OK);
+  EXPECT_EQ(later, 1);
+}
+
+TEST(CommandRouterTest, TransportsDispatchConcurrentlyWhileCommandsAreRegistered)
+{
+  constexpr int TRANSPORTS{3};
+  constexpr uint32_t COMMANDS{20000};
+  CommandRouter router;
+  std::atomic<uint32_t> calls{0};
+  router.Register("ping", [&calls](std::string_view) { calls.fetch_add(1); });
+
+  std::vector<std::thread> transports;
+  for (int i = 0; i < TRANSPORTS; ++i)
+  {
+    transports.emplace_back([&router] {
+      for (uint32_t n = 0; n < COMMANDS; ++n)
+      {
+        router.Dispatch("ping 1");
+      }
+    });
+  }
+  for (int i = 0; i < 500; ++i)
+  {
+    ASSERT_TRUE(router.Register("command" + std::to_string(i), [](std::string_view) {}));
+  }
+  for (auto& transport : transports)
+  {
+    transport.join();
+  }
+  EXPECT_EQ(calls.load(), TRANSPORTS * COMMANDS);
+  EXPECT_EQ(router.GetStatistics().dispatched, TRANSPORTS * COMMANDS);
+  EXPECT_EQ(router.Dispatch("command499"), DispatchResult::OK);
+}
@@ -0,0 +1,89 @@
+// Standard header
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/CommandTable.hpp>
+
+using namespace Esp32Modules::Connectivity;
+
+TEST(CommandTableTest, ParseCommandSplitsAtTheFirstSpace)
+{
+  EXPECT_EQ(ParseCommand("led on 5").token, "led");
+  EXPECT_EQ(ParseCommand("led on 5").parameters, "on 5");
+  EXPECT_EQ(ParseCommand("reset").token, "reset");
+  EXPECT_TRUE(ParseCommand("reset").parameters.empty());
+  EXPECT_EQ(ParseCommand("reset ").parameters, "");
+  EXPECT_EQ(ParseCommand(" x").token, "");
+  EXPECT_EQ(ParseCommand("").token, "");
+}
+
+TEST(CommandTableTest, HashesAreAvailableAtCompileTime)
+{
+  static_assert(HashToken("") == 2166136261u);
+  static_assert(HashToken("a") == 0xE40C292Cu);  // Reference value of 32 bit FNV-1a.
+}
+
+TEST(CommandTableTest, FindsRegisteredTokensOnly)
+{
+  CommandTable table;
+  std::vector<std::string> calls;
+  for (const char* token : {"led", "reset", "status", "ota", "l", "led2"})
+  {
+    ASSERT_TRUE(table.Register(token, [&calls, token](const std::string_view parameters) {
+      calls.push_back(std::string{token} + ":" + std::string{parameters});
+    }));
+  }
+  EXPECT_FALSE(table.Register("led", [](std::string_view) {}));
+  EXPECT_EQ(table.Size(), 6u);
+
+  for (const char* token : {"led", "reset", "status", "ota", "l", "led2"})
+  {
+    auto* callback = table.Find(token);
+    ASSERT_NE(callback, nullptr) << token;
+    (*callback)("x");
+  }
+  EXPECT_EQ(calls, (std::vector<std::string>{"led:x", "reset:x", "status:x", "ota:x", "l:x",
+                                             "led2:x"}));
+  EXPECT_EQ(table.Find("le"), nullptr);
+  EXPECT_EQ(table.Find("LED"), nullptr);
+  EXPECT_EQ(table.Find(""), nullptr);
+}
+
+TEST(CommandTableTest, TokensWithCollidingHashesAreDistinguished)
+{
+  static_assert(HashToken("gwzx") == HashToken("16cd"));
+  CommandTable table;
+  int first{0};
+  int second{0};
+  ASSERT_TRUE(table.Register("gwzx", [&first](std::string_view) { ++first; }));
+  EXPECT_EQ(table.Find("16cd"), nullptr);
+  ASSERT_TRUE(table.Register("16cd", [&second](std::string_view) { ++second; }));
+  EXPECT_FALSE(table.Register("gwzx", [](std::string_view) {}));
+
+  (*table.Find("16cd"))({});
+  (*table.Find("gwzx"))({});
+  (*table.Find("16cd"))({});
+  EXPECT_EQ(first, 1);
+  EXPECT_EQ(second, 2);
+}
+
+TEST(CommandTableTest, CallbacksKeepTheirAddressesWhileTheTableGrows)
+{
+  CommandTable table;
+  table.Register("first", [](std::string_view) {});
+  auto* callback = table.Find("first");
+  for (int i = 0; i < 1000; ++i)
+  {
+    ASSERT_TRUE(table.Register("token" + std::to_string(i), [](std::string_view) {}));
+  }
+  EXPECT_EQ(table.Find("first"), callback);
+  for (int i = 0; i < 1000; ++i)
+  {
+    ASSERT_NE(table.Find("token" + std::to_string(i)), nullptr);
+  }
+}
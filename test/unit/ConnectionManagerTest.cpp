@@ -0,0 +1,103 @@
+// Standard header
+#include <cstdint>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/ConnectionManager.hpp>
+#include <esp32-modules/core/time/SimulatedClock.hpp>
+
+using namespace Esp32Modules::Connectivity::BluetoothLE;
+using Esp32Modules::Core::Time::SimulatedClock;
+
+namespace
+{
+constexpr AdvertisingConfig CONFIG{500, 20, 80, 30000};
+
+/** Connection manager recording the advertising intervals and state changes. */
+struct Fixture
+{
+  SimulatedClock clock{1000};
+  std::vector<uint16_t> intervals;
+  std::vector<ConnectionState> states;
+  ConnectionManager manager{[this](const uint16_t interval) { intervals.push_back(interval); },
+                            CONFIG, &clock};
+
+  Fixture()
+  {
+    manager.SetStateCallback([this](const ConnectionState state) { states.push_back(state); });
+  }
+
+  /** Sleeps until the next update is due and runs it, like the wake-up timer of the receiver. */
+  void WakeUp()
+  {
+    const uint32_t delay = manager.TimeUntilUpdate();
+    ASSERT_NE(delay, NO_UPDATE_DUE);
+    clock.Advance(delay);
+    manager.Update();
+  }
+};
+}  // namespace
+
+TEST(ConnectionManagerTest, ReadvertisesAfterTheRestartDelay)
+{
+  Fixture fixture;
+  auto& manager = fixture.manager;
+  EXPECT_EQ(manager.TimeUntilUpdate(), NO_UPDATE_DUE);  // Not started.
+  manager.Start();
+  EXPECT_EQ(fixture.intervals, std::vector<uint16_t>{20});
+
+  manager.OnConnect();
+  EXPECT_EQ(manager.TimeUntilUpdate(), 0u);
+  manager.Update();
+  EXPECT_EQ(manager.GetState(), ConnectionState::CONNECTED);
+  EXPECT_EQ(manager.TimeUntilUpdate(), NO_UPDATE_DUE);
+
+  manager.OnDisconnect();
+  EXPECT_EQ(manager.TimeUntilUpdate(), 0u);
+  manager.Update();
+  EXPECT_EQ(manager.GetState(), ConnectionState::DISCONNECTED);
+  EXPECT_EQ(manager.TimeUntilUpdate(), 500u);
+  fixture.clock.Advance(200);
+  EXPECT_EQ(manager.TimeUntilUpdate(), 300u);
+  manager.Update();  // Too early.
+  EXPECT_EQ(manager.GetState(), ConnectionState::DISCONNECTED);
+
+  fixture.WakeUp();
+  EXPECT_EQ(manager.GetState(), ConnectionState::ADVERTISING);
+  EXPECT_EQ(fixture.intervals, (std::vector<uint16_t>{20, 20}));
+  EXPECT_EQ(manager.GetStatistics().readvertiseDelay, 500u);
+  EXPECT_EQ(fixture.states,
+            (std::vector<ConnectionState>{ConnectionState::ADVERTISING, ConnectionState::CONNECTED,
+                                          ConnectionState::DISCONNECTED,
+                                          ConnectionState::ADVERTISING}));
+}
+
+TEST(ConnectionManagerTest, WakeUpsBackOffTheAdvertisingUntilTheMaximum)
+{
+  Fixture fixture;
+  fixture.manager.Start();
+  EXPECT_EQ(fixture.manager.TimeUntilUpdate(), 30000u);
+  fixture.WakeUp();
+  fixture.WakeUp();
+  EXPECT_EQ(fixture.intervals, (std::vector<uint16_t>{20, 40, 80}));
+  EXPECT_EQ(fixture.manager.TimeUntilUpdate(), NO_UPDATE_DUE);  // At the maximum interval.
+}
+
+TEST(ConnectionManagerTest, ConnectAndDisconnectBetweenUpdatesAreReported)
+{
+  Fixture fixture;
+  fixture.manager.Start();
+  fixture.manager.OnConnect();
+  fixture.manager.OnDisconnect();
+  fixture.manager.Update();
+  EXPECT_EQ(fixture.states,
+            (std::vector<ConnectionState>{ConnectionState::ADVERTISING, ConnectionState::CONNECTED,
+                                          ConnectionState::DISCONNECTED}));
+  EXPECT_EQ(fixture.manager.GetStatistics().connects, 1u);
+  EXPECT_EQ(fixture.manager.GetStatistics().disconnects, 1u);
+  fixture.WakeUp();
+  EXPECT_EQ(fixture.manager.GetState(), ConnectionState::ADVERTISING);
+}
@@ -0,0 +1,135 @@
+// Standard header
+#include <cstdint>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+TEST(CooperativeSchedulerTest, CyclicTaskKeepsItsCadence)
+{
+  SchedulerHarness harness;
+  std::vector<uint32_t> starts;
+  harness.Scheduler().AddCyclicTask(10 * TASK_MILLISECOND, [&] {
+    starts.push_back(harness.Clock().Millis());
+    harness.Work(3000);  // Execution times must not shift the following executions.
+  });
+
+  harness.RunFor(100 * TASK_MILLISECOND);
+
+  ASSERT_EQ(starts.size(), 10u);
+  for (size_t i = 0; i < starts.size(); ++i)
+  {
+    EXPECT_EQ(starts[i], (i + 1) * 10);
+  }
+}
+
+TEST(CooperativeSchedulerTest, IdlePassesSleepUntilTheNextTask)
+{
+  SchedulerHarness harness;
+  uint32_t runs{0};
+  harness.Scheduler().AddCyclicTask(250 * TASK_MILLISECOND, [&] { ++runs; });
+
+  harness.RunFor(TASK_SECOND);
+
+  EXPECT_EQ(runs, 4u);
+  EXPECT_EQ(harness.Clock().GetStatistics().lightSleeps, 4u);
+  EXPECT_EQ(harness.Clock().GetStatistics().sleptDuration, TASK_SECOND);
+  EXPECT_EQ(harness.GetPasses(), 8u);  // One idle and one executing pass per run.
+}
+
+TEST(CooperativeSchedulerTest, OneShotTaskRunsOnceAndFreesItsSlot)
+{
+  SchedulerHarness harness;
+  uint32_t runs{0};
+  const TaskId id = harness.Scheduler().AddOneShotTask(5 * TASK_MILLISECOND, [&] { ++runs; });
+  ASSERT_NE(id, INVALID_TASKID);
+  EXPECT_EQ(harness.Scheduler().GetPoolStatistics().used, 1u);
+
+  harness.RunFor(50 * TASK_MILLISECOND);
+
+  EXPECT_EQ(runs, 1u);
+  EXPECT_EQ(harness.Scheduler().GetPoolStatistics().used, 0u);
+  EXPECT_FALSE(harness.Scheduler().AbortTask(id));  // Stale id.
+}
+
+TEST(CooperativeSchedulerTest, DueTasksRunInOrderOfPriority)
+{
+  SchedulerHarness harness;
+  std::vector<TaskPriority> order;
+  for (const auto priority : {TaskPriority::BACKGROUND, TaskPriority::NORMAL,
+                              TaskPriority::CRITICAL})
+  {
+    harness.Scheduler().AddOneShotTask(
+        10 * TASK_MILLISECOND, [&order, priority] { order.push_back(priority); },
+        DEFAULT_TIMEOUT, priority);
+  }
+
+  harness.RunFor(10 * TASK_MILLISECOND);
+
+  EXPECT_EQ(order, (std::vector<TaskPriority>{TaskPriority::CRITICAL, TaskPriority::NORMAL,
+                                              TaskPriority::BACKGROUND}));
+}
+
+TEST(CooperativeSchedulerTest, PassBudgetDefersAllButCriticalTasks)
+{
+  SchedulerHarness harness;
+  harness.Scheduler().SetPassBudget(100);
+  std::vector<int> order;
+  auto add = [&](const int tag, const TaskDuration delay, const TaskPriority priority) {
+    harness.Scheduler().AddOneShotTask(
+        delay,
+        [&harness, &order, tag] {
+          order.push_back(tag);
+          harness.Work(150);
+        },
+        DEFAULT_TIMEOUT, priority);
+  };
+  add(1, 10 * TASK_MILLISECOND, TaskPriority::NORMAL);
+  add(2, 11 * TASK_MILLISECOND, TaskPriority::NORMAL);
+  add(3, 10 * TASK_MILLISECOND, TaskPriority::CRITICAL);
+  add(4, 11 * TASK_MILLISECOND, TaskPriority::CRITICAL);
+
+  harness.Clock().Advance(20 * TASK_MILLISECOND);  // All due in the same pass.
+  ASSERT_TRUE(harness.Pass());
+  EXPECT_EQ(order, (std::vector<int>{3, 4}));  // Budget used up by the critical tasks.
+  EXPECT_EQ(harness.Scheduler().TimeUntilNextTask(), 0u);
+  ASSERT_TRUE(harness.Pass());
+  EXPECT_EQ(order, (std::vector<int>{3, 4, 1}));
+  ASSERT_TRUE(harness.Pass());
+  EXPECT_EQ(order, (std::vector<int>{3, 4, 1, 2}));
+}
+
+TEST(CooperativeSchedulerTest, TaskAbortingItselfIsFreedAfterTheCallback)
+{
+  SchedulerHarness harness;
+  uint32_t runs{0};
+  TaskId id{INVALID_TASKID};
+  id = harness.Scheduler().AddCyclicTask(10 * TASK_MILLISECOND, [&] {
+    if (++runs == 3)
+    {
+      EXPECT_TRUE(harness.Scheduler().AbortTask(id));
+    }
+  });
+
+  harness.RunFor(100 * TASK_MILLISECOND);
+
+  EXPECT_EQ(runs, 3u);
+  EXPECT_EQ(harness.Scheduler().GetPoolStatistics().used, 0u);
+}
+
+TEST(CooperativeSchedulerTest, KeepsTheCadenceAcrossTheMillisWrapAround)
+{
+  SchedulerHarness harness{TASK_HOUR, {}, UINT32_MAX - 45};
+  uint32_t runs{0};
+  harness.Scheduler().AddCyclicTask(20 * TASK_MILLISECOND, [&] { ++runs; });
+
+  harness.RunFor(200 * TASK_MILLISECOND);
+
+  EXPECT_EQ(runs, 10u);
+}
@@ -0,0 +1,137 @@
+// Standard header
+#include <cstdint>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/Coroutine.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+/** Records the simulated time of each step. */
+CoTask Steps(SchedulerHarness& harness, std::vector<uint32_t>& times)
+{
+  times.push_back(harness.Clock().Millis());
+  co_await Delay(200 * TASK_MILLISECOND);
+  times.push_back(harness.Clock().Millis());
+  co_await NextTick();
+  times.push_back(harness.Clock().Millis());
+  co_await Delay(TASK_SECOND);
+  times.push_back(harness.Clock().Millis());
+}
+
+/** Waits for the event and records its order of resumption. */
+CoTask Waiter(CoEvent& event, std::vector<int>& order, const int index)
+{
+  co_await event;
+  order.push_back(index);
+}
+
+/** Keeps the frame alive until the event is set. */
+CoTask Holder(CoEvent& event)
+{
+  co_await event;
+}
+
+/** Needs a frame larger than the pool provides. */
+CoTask Oversized(uint32_t& sum)
+{
+  volatile uint8_t buffer[2 * ESP32MODULES_COROUTINE_FRAME_SIZE]{};
+  co_await NextTick();
+  for (const auto value : buffer)
+  {
+    sum += value;
+  }
+}
+}  // namespace
+
+TEST(CoroutineTest, DelaysResumeOnSimulatedTime)
+{
+  SchedulerHarness harness;
+  std::vector<uint32_t> times;
+  ASSERT_TRUE(Spawn(harness.Scheduler(), Steps(harness, times)));
+  EXPECT_TRUE(times.empty());  // Started on the next pass.
+
+  harness.RunFor(2 * TASK_SECOND);
+  ASSERT_EQ(times.size(), 4u);
+  EXPECT_EQ(times[0], 0u);
+  EXPECT_EQ(times[1], 200u);
+  EXPECT_EQ(times[2], 200u);  // The next tick does not wait for time to pass.
+  EXPECT_EQ(times[3], 1200u);
+  EXPECT_EQ(harness.Scheduler().GetPoolStatistics().used, 0u);
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 0u);
+}
+
+TEST(CoroutineTest, EventResumesAllWaitersInOrderOfWaiting)
+{
+  SchedulerHarness harness;
+  CoEvent event;
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(Spawn(harness.Scheduler(), Waiter(event, order, i)));
+  }
+  harness.RunFor(10 * TASK_MILLISECOND);
+  EXPECT_TRUE(order.empty());
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 3u);
+
+  event.Set();
+  EXPECT_TRUE(order.empty());  // Resumed by the scheduler, not within Set().
+  harness.RunFor(TASK_MILLISECOND);
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+
+  // Set events do not suspend until they are reset.
+  ASSERT_TRUE(Spawn(harness.Scheduler(), Waiter(event, order, 3)));
+  harness.RunFor(TASK_MILLISECOND);
+  EXPECT_EQ(order.back(), 3);
+  event.Reset();
+  ASSERT_TRUE(Spawn(harness.Scheduler(), Waiter(event, order, 4)));
+  harness.RunFor(TASK_MILLISECOND);
+  EXPECT_EQ(order.back(), 3);
+  event.Set();
+  harness.RunFor(TASK_MILLISECOND);
+  EXPECT_EQ(order.back(), 4);
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 0u);
+}
+
+TEST(CoroutineTest, FramePoolLimitsTheCoroutinesAlive)
+{
+  SchedulerHarness harness;
+  CoEvent event;
+  const auto before = CoroutineFramePool::GetStatistics();
+  EXPECT_EQ(before.capacity, ESP32MODULES_COROUTINE_MAX_FRAMES);
+
+  for (uint16_t i = 0; i < before.capacity; ++i)
+  {
+    ASSERT_TRUE(Spawn(harness.Scheduler(), Holder(event)));
+  }
+  CoTask rejected = Holder(event);
+  EXPECT_FALSE(rejected);
+  EXPECT_FALSE(Spawn(harness.Scheduler(), std::move(rejected)));
+  auto statistics = CoroutineFramePool::GetStatistics();
+  EXPECT_EQ(statistics.used, before.capacity);
+  EXPECT_EQ(statistics.highWaterMark, before.capacity);
+  EXPECT_EQ(statistics.failures, before.failures + 1);
+
+  // Frames are returned once the coroutines finished, even if they never ran before.
+  harness.RunFor(TASK_MILLISECOND);
+  event.Set();
+  harness.RunFor(TASK_MILLISECOND);
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 0u);
+  {
+    CoTask unspawned = Holder(event);
+    EXPECT_TRUE(unspawned);
+    EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 1u);
+  }
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().used, 0u);
+
+  uint32_t sum{0};
+  EXPECT_FALSE(Spawn(harness.Scheduler(), Oversized(sum)));
+  EXPECT_EQ(CoroutineFramePool::GetStatistics().failures, before.failures + 2);
+}
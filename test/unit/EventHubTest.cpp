@@ -0,0 +1,148 @@
+// Standard header
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/EventHub.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+/** Reads everything queued for the subscriber in pieces of at most the given size. */
+std::string ReadAll(EventHub& hub, const EventHub::SubscriberId id, const size_t piece)
+{
+  std::string result;
+  uint8_t buffer[64];
+  while (const size_t read = hub.Read(id, buffer, std::min(piece, sizeof(buffer))))
+  {
+    result.append(reinterpret_cast<const char*>(buffer), read);
+  }
+  return result;
+}
+}  // namespace
+
+TEST(EventHubTest, SerializesEventsOnceForAllSubscribers)
+{
+  EventHub hub{4, 2};
+  const auto first = hub.Subscribe();
+  const auto second = hub.Subscribe();
+  ASSERT_NE(first, EventHub::NO_SUBSCRIBER);
+  ASSERT_NE(second, EventHub::NO_SUBSCRIBER);
+  EXPECT_NE(first, second);
+
+  EXPECT_EQ(hub.Publish("x\ny", "temp"), 2u);
+  EXPECT_EQ(hub.Publish("plain"), 2u);
+  const std::string expected{"id: 1\nevent: temp\ndata: x\ndata: y\n\nid: 2\ndata: plain\n\n"};
+  EXPECT_EQ(ReadAll(hub, first, 5), expected);  // Partially read events are continued.
+  EXPECT_EQ(ReadAll(hub, second, 64), expected);
+
+  const auto statistics = hub.GetStatistics();
+  EXPECT_EQ(statistics.published, 2u);
+  EXPECT_EQ(statistics.delivered, 4u);
+  EXPECT_EQ(statistics.dropped, 0u);
+}
+
+TEST(EventHubTest, DropsSlowSubscribersOnly)
+{
+  EventHub hub{2, 2};
+  const auto fast = hub.Subscribe();
+  const auto slow = hub.Subscribe();
+
+  hub.Publish("1");
+  hub.Publish("2");
+  EXPECT_EQ(ReadAll(hub, fast, 64), "id: 1\ndata: 1\n\nid: 2\ndata: 2\n\n");
+  // The slow subscriber has a full queue, the next event drops it instead of being buffered.
+  EXPECT_EQ(hub.Publish("3"), 1u);
+  EXPECT_TRUE(hub.IsSubscribed(fast));
+  EXPECT_FALSE(hub.IsSubscribed(slow));
+  EXPECT_EQ(hub.GetSubscriberCount(), 1u);
+  EXPECT_EQ(hub.GetStatistics().dropped, 1u);
+
+  uint8_t buffer[16];
+  EXPECT_EQ(hub.Read(slow, buffer, sizeof(buffer)), 0u);  // Its events are released.
+  EXPECT_EQ(ReadAll(hub, fast, 64), "id: 3\ndata: 3\n\n");
+
+  // A partially read event still counts as queued.
+  hub.Publish("4");
+  hub.Publish("5");
+  EXPECT_EQ(hub.Read(fast, buffer, 4), 4u);
+  hub.Publish("6");
+  EXPECT_FALSE(hub.IsSubscribed(fast));
+  EXPECT_EQ(hub.GetStatistics().dropped, 2u);
+}
+
+TEST(EventHubTest, ReusesSlotsWithNewIdentifiers)
+{
+  EventHub hub{2, 1};
+  const auto first = hub.Subscribe();
+  EXPECT_EQ(hub.Subscribe(), EventHub::NO_SUBSCRIBER);  // All slots taken.
+
+  hub.Publish("before");
+  hub.Unsubscribe(first);
+  EXPECT_FALSE(hub.IsSubscribed(first));
+  EXPECT_EQ(hub.Publish("nobody"), 0u);
+
+  const auto second = hub.Subscribe();
+  ASSERT_NE(second, EventHub::NO_SUBSCRIBER);
+  EXPECT_NE(second, first);  // The stale identifier does not address the new subscriber.
+  EXPECT_TRUE(ReadAll(hub, second, 64).empty());  // Only events published from now on.
+  hub.Unsubscribe(first);
+  EXPECT_TRUE(hub.IsSubscribed(second));
+}
+
+TEST(EventHubTest, PublishesAndReadsConcurrently)
+{
+  constexpr uint32_t EVENTS{20000};
+  constexpr size_t SUBSCRIBERS{3};
+  EventHub hub{EVENTS, SUBSCRIBERS};  // Large enough to never drop a subscriber.
+  std::vector<EventHub::SubscriberId> ids;
+  for (size_t i = 0; i < SUBSCRIBERS; ++i)
+  {
+    ids.push_back(hub.Subscribe());
+  }
+  const std::string payload{"{\"temperature\":21.5}"};
+  std::atomic<bool> published{false};
+  std::vector<size_t> received(SUBSCRIBERS, 0);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < SUBSCRIBERS; ++i)
+  {
+    readers.emplace_back([&, i] {
+      uint8_t buffer[100];
+      while (true)
+      {
+        const bool done = published.load();
+        const size_t read = hub.Read(ids[i], buffer, sizeof(buffer));
+        received[i] += read;
+        if (read == 0 and done)
+        {
+          return;
+        }
+      }
+    });
+  }
+  size_t bytes{0};
+  for (uint32_t i = 1; i <= EVENTS; ++i)
+  {
+    ASSERT_EQ(hub.Publish(payload), SUBSCRIBERS);
+    bytes += 4 + std::to_string(i).size() + 1 + 6 + payload.size() + 2;  // "id: <i>\ndata: ..\n\n"
+  }
+  published.store(true);
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+  for (size_t i = 0; i < SUBSCRIBERS; ++i)
+  {
+    EXPECT_EQ(received[i], bytes);
+  }
+  EXPECT_EQ(hub.GetStatistics().delivered, EVENTS * SUBSCRIBERS);
+  EXPECT_EQ(hub.GetStatistics().dropped, 0u);
+}
@@ -0,0 +1,254 @@
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/containers/FrameRing.hpp>
+
+using namespace Esp32Modules::Core::Containers;
+
+namespace
+{
+/** Fills a frame whose content is derived from its sequence number. */
+size_t MakeFrame(const uint32_t sequence, uint8_t* frame)
+{
+  const size_t length = 4 + sequence % 37;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    frame[i] = static_cast<uint8_t>(sequence >> (8 * i));
+  }
+  for (size_t i = 4; i < length; ++i)
+  {
+    frame[i] = static_cast<uint8_t>(sequence * 31 + i);
+  }
+  return length;
+}
+
+/** Checks a popped frame, returns its sequence number. */
+uint32_t CheckFrame(const uint8_t* frame, const size_t length)
+{
+  uint32_t sequence{0};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    sequence |= static_cast<uint32_t>(frame[i]) << (8 * i);
+  }
+  uint8_t expected[64];
+  EXPECT_EQ(MakeFrame(sequence, expected), length) << "sequence " << sequence;
+  for (size_t i = 4; i < length; ++i)
+  {
+    EXPECT_EQ(frame[i], expected[i]) << "sequence " << sequence << " byte " << i;
+  }
+  return sequence;
+}
+}  // namespace
+
+TEST(FrameRingTest, DropNewestKeepsTheQueuedFrames)
+{
+  FrameRing<16> ring;
+  const uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+  EXPECT_TRUE(ring.Push(data, 6));
+  EXPECT_TRUE(ring.Push(data, 6));
+  EXPECT_FALSE(ring.Push(data, 1));  // 16 bytes used.
+  EXPECT_FALSE(ring.Push(data, FrameRing<16>::MAX_FRAME_SIZE + 1));
+
+  uint8_t buffer[8];
+  size_t length{0};
+  ASSERT_TRUE(ring.Pop(buffer, sizeof(buffer), length));
+  EXPECT_EQ(length, 6u);
+  EXPECT_EQ(ring.GetStatistics().dropped, 2u);
+}
+
+TEST(FrameRingTest, DropOldestMakesRoomAcrossTheWrapAround)
+{
+  FrameRing<16> ring{OverflowPolicy::DROP_OLDEST};
+  uint8_t frame[64];
+  uint8_t buffer[64];
+  size_t length{0};
+  for (uint32_t sequence = 0; sequence < 100; ++sequence)
+  {
+    const size_t size = 4 + sequence % 3;
+    MakeFrame(sequence, frame);
+    frame[4] = frame[5] = 0;  // Short frames, the content check only covers the sequence.
+    ASSERT_TRUE(ring.Push(frame, size));
+  }
+  // Only the latest frames fit (6 to 8 bytes each).
+  uint32_t last{0};
+  uint32_t popped{0};
+  while (ring.Pop(buffer, sizeof(buffer), length))
+  {
+    last = buffer[0];
+    ++popped;
+  }
+  EXPECT_EQ(last, 99u);
+  EXPECT_EQ(popped, 2u);
+  const auto statistics = ring.GetStatistics();
+  EXPECT_EQ(statistics.pushed, statistics.popped + statistics.dropped);
+}
+
+TEST(FrameRingTest, MarkersTakeThePlaceOfTheOldestFramesRegardlessOfThePolicy)
+{
+  FrameRing<16> ring;  // DROP_NEWEST.
+  const uint8_t first[6] = {1, 1, 1, 1, 1, 1};
+  const uint8_t second[6] = {2, 2, 2, 2, 2, 2};
+  const uint8_t marker[4] = {9, 9, 9, 9};
+  ASSERT_TRUE(ring.Push(first, 6));
+  ASSERT_TRUE(ring.Push(second, 6));
+  EXPECT_FALSE(ring.Push(marker, 4));  // Full for regular frames...
+  EXPECT_TRUE(ring.PushDroppingOldest(marker, 4, nullptr, 0));  // ...but not for markers.
+  EXPECT_FALSE(ring.PushDroppingOldest(marker, 4, first, FrameRing<16>::MAX_FRAME_SIZE));
+
+  // The marker is queued right behind the frames kept, in order.
+  uint8_t buffer[8];
+  size_t length{0};
+  ASSERT_TRUE(ring.Pop(buffer, sizeof(buffer), length));
+  EXPECT_EQ(length, 6u);
+  EXPECT_EQ(buffer[0], 2u);
+  ASSERT_TRUE(ring.Pop(buffer, sizeof(buffer), length));
+  EXPECT_EQ(length, 4u);
+  EXPECT_EQ(buffer[0], 9u);
+  EXPECT_FALSE(ring.Pop(buffer, sizeof(buffer), length));
+  EXPECT_EQ(ring.GetStatistics().dropped, 3u);  // The first frame, the regular and the oversized.
+}
+
+TEST(FrameRingTest, CountsDroppedAndRejectedFramesPerPolicy)
+{
+  const uint8_t data[6]{};
+  for (const auto policy :
+       {OverflowPolicy::DROP_NEWEST, OverflowPolicy::DROP_OLDEST, OverflowPolicy::REJECT})
+  {
+    FrameRing<16> ring{policy};
+    for (int i = 0; i < 5; ++i)
+    {
+      const bool stored = ring.Push(data, 6);
+      EXPECT_EQ(stored, i < 2 or policy == OverflowPolicy::DROP_OLDEST) << int(policy);
+    }
+    EXPECT_FALSE(ring.Push(data, FrameRing<16>::MAX_FRAME_SIZE + 1));
+
+    const auto statistics = ring.GetStatistics();
+    switch (policy)
+    {
+      case OverflowPolicy::DROP_NEWEST:  // The three new frames and the oversized one.
+        EXPECT_EQ(statistics.pushed, 2u);
+        EXPECT_EQ(statistics.dropped, 4u);
+        EXPECT_EQ(statistics.rejected, 0u);
+        break;
+      case OverflowPolicy::DROP_OLDEST:  // Three queued frames made room, then the oversized one.
+        EXPECT_EQ(statistics.pushed, 5u);
+        EXPECT_EQ(statistics.dropped, 4u);
+        EXPECT_EQ(statistics.rejected, 0u);
+        break;
+      case OverflowPolicy::REJECT:  // Nothing is discarded, the producer is told instead.
+        EXPECT_EQ(statistics.pushed, 2u);
+        EXPECT_EQ(statistics.dropped, 0u);
+        EXPECT_EQ(statistics.rejected, 4u);
+        break;
+    }
+  }
+}
+
+TEST(FrameRingTest, PeakIsTheMaximumNumberOfBytesInUse)
+{
+  FrameRing<64> ring;
+  const uint8_t data[20]{};
+  uint8_t buffer[32];
+  size_t length{0};
+  EXPECT_EQ(ring.GetStatistics().peak, 0u);
+  ring.Push(data, 10);  // 12 bytes including the length prefix.
+  ring.Push(data, 20);  // 34 bytes.
+  EXPECT_EQ(ring.GetStatistics().peak, 34u);
+  EXPECT_EQ(ring.SizeApprox(), 34u);
+  ring.Pop(buffer, sizeof(buffer), length);
+  ring.Pop(buffer, sizeof(buffer), length);
+  ring.Push(data, 4);
+  EXPECT_EQ(ring.GetStatistics().peak, 34u);  // Kept after draining.
+  ring.Push(data, 20);
+  ring.Push(data, 6);  // 6 + 22 + 8 bytes.
+  EXPECT_EQ(ring.GetStatistics().peak, 36u);
+}
+
+TEST(FrameRingTest, PrefixStampsTheFramesForTheConsumer)
+{
+  // Like the BLE receiver: each payload is queued behind the time it was received, so the
+  // consumer can determine the enqueue-to-dispatch latency.
+  FrameRing<256> ring;
+  const uint8_t payload[]{'c', 'm', 'd'};
+  for (uint32_t received : {1000u, 0xFFFFFFF0u})
+  {
+    ASSERT_TRUE(ring.Push(reinterpret_cast<const uint8_t*>(&received), sizeof(received), payload,
+                          sizeof(payload)));
+  }
+  uint8_t buffer[16];
+  size_t length{0};
+  for (const uint32_t expected : {1000u, 0xFFFFFFF0u})
+  {
+    ASSERT_TRUE(ring.Pop(buffer, sizeof(buffer), length));
+    ASSERT_EQ(length, sizeof(uint32_t) + sizeof(payload));
+    uint32_t stamp{0};
+    std::memcpy(&stamp, buffer, sizeof(stamp));
+    EXPECT_EQ(stamp, expected);
+    EXPECT_EQ(0, std::memcmp(buffer + sizeof(stamp), payload, sizeof(payload)));
+    const uint32_t dispatched = expected + 250;  // Wraps around for the second frame.
+    EXPECT_EQ(dispatched - stamp, 250u);
+  }
+}
+
+TEST(FrameRingTest, FramesTooLargeForTheConsumerAreDiscarded)
+{
+  FrameRing<64> ring;
+  const uint8_t data[20]{};
+  ring.Push(data, 20);
+  ring.Push(data, 2);
+  uint8_t buffer[4];
+  size_t length{0};
+  ASSERT_TRUE(ring.Pop(buffer, sizeof(buffer), length));
+  EXPECT_EQ(length, 2u);
+  EXPECT_EQ(ring.GetStatistics().dropped, 1u);
+}
+
+TEST(FrameRingTest, DropOldestWithAConcurrentConsumerNeverYieldsTornFrames)
+{
+  constexpr uint32_t FRAMES{300000};
+  FrameRing<256> ring{OverflowPolicy::DROP_OLDEST};
+  std::atomic<bool> done{false};
+
+  std::thread producer{[&] {
+    uint8_t frame[64];
+    for (uint32_t sequence = 0; sequence < FRAMES; ++sequence)
+    {
+      const size_t length = MakeFrame(sequence, frame);
+      ring.Push(frame, length);
+    }
+    done.store(true);
+  }};
+
+  uint8_t buffer[64];
+  size_t length{0};
+  uint32_t popped{0};
+  int64_t previous{-1};
+  bool finished{false};
+  while (not finished)
+  {
+    finished = done.load();  // Drain once more after the producer finished.
+    while (ring.Pop(buffer, sizeof(buffer), length))
+    {
+      const uint32_t sequence = CheckFrame(buffer, length);
+      ASSERT_GT(static_cast<int64_t>(sequence), previous);  // In order, each frame at most once.
+      previous = sequence;
+      ++popped;
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(previous, FRAMES - 1);  // The latest frame is never dropped.
+  const auto statistics = ring.GetStatistics();
+  EXPECT_EQ(statistics.pushed, FRAMES);
+  EXPECT_EQ(statistics.popped, popped);
+  EXPECT_EQ(statistics.pushed, statistics.popped + statistics.dropped);
+  EXPECT_LE(statistics.peak, 256u);
+}
@@ -0,0 +1,94 @@
+// Standard header
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpBodySink.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+/** Writes the data to the body in segments of the given size (like the client reading a socket). */
+bool WriteInSegments(BodySink& body, const std::vector<uint8_t>& data, const size_t segment)
+{
+  for (size_t offset = 0; offset < data.size(); offset += segment)
+  {
+    const size_t length = std::min(segment, data.size() - offset);
+    if (body.Write(data.data() + offset, length) != length)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+TEST(HttpBodySinkTest, PassesChunksOnAsTheyAreWritten)
+{
+  std::vector<uint8_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::vector<uint8_t> received;
+  size_t chunks{0};
+  size_t largest{0};
+  const ChunkSink sink = [&](const uint8_t* chunk, const size_t length) {
+    received.insert(received.end(), chunk, chunk + length);
+    ++chunks;
+    largest = std::max(largest, length);
+    return true;
+  };
+  BodySink body{sink};
+  ASSERT_TRUE(WriteInSegments(body, data, 1460));
+
+  EXPECT_EQ(received, data);
+  EXPECT_EQ(body.GetWritten(), data.size());
+  EXPECT_EQ(chunks, (data.size() + 1459) / 1460);  // Not buffered nor merged...
+  EXPECT_EQ(largest, 1460u);                       // ...so the size of a chunk is bounded.
+}
+
+TEST(HttpBodySinkTest, SinkAbortsTheTransfer)
+{
+  const std::vector<uint8_t> data(1000, 'x');
+  size_t received{0};
+  const ChunkSink sink = [&received](const uint8_t*, const size_t length) {
+    if (received + length > 300)
+    {
+      return false;
+    }
+    received += length;
+    return true;
+  };
+  BodySink body{sink};
+  EXPECT_FALSE(WriteInSegments(body, data, 100));
+  EXPECT_EQ(received, 300u);
+  EXPECT_EQ(body.GetWritten(), 300u);  // The rejected chunk is not counted.
+}
+
+TEST(HttpBodySinkTest, DrainsWithoutSink)
+{
+  const std::vector<uint8_t> data(5000, 'x');
+  const ChunkSink none{nullptr};
+  BodySink body{none};
+  EXPECT_TRUE(WriteInSegments(body, data, 512));
+  EXPECT_EQ(body.GetWritten(), data.size());
+}
+
+TEST(HttpBodySinkTest, AppendsToAString)
+{
+  std::string result{"stale"};
+  result.clear();  // As done by HttpClient::Get().
+  const ChunkSink sink = BodySink::AppendTo(result);
+  BodySink body{sink};
+  const std::string text{"HTTP bodies arrive in pieces"};
+  const std::vector<uint8_t> data(text.begin(), text.end());
+  ASSERT_TRUE(WriteInSegments(body, data, 5));
+  EXPECT_EQ(result, text);
+}
@@ -0,0 +1,156 @@
+// Standard header
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpBodySource.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+/** Step of a scripted chunk source: the piece to produce, or TRY_AGAIN if empty. */
+struct Step
+{
+  std::string piece;
+  bool tryAgain;
+};
+
+/** Source producing the steps in order (and then 0), counting its executions. */
+ChunkSource Script(const std::vector<Step>& steps, size_t& calls,
+                   std::vector<size_t>* capacities = nullptr)
+{
+  return [steps, &calls, capacities, next = size_t{0}](uint8_t* buffer,
+                                                       const size_t capacity) mutable -> size_t {
+    ++calls;
+    if (capacities)
+    {
+      capacities->push_back(capacity);
+    }
+    if (next == steps.size())
+    {
+      return 0;
+    }
+    const auto& step = steps[next++];
+    if (step.tryAgain)
+    {
+      return BodySource::TRY_AGAIN;
+    }
+    const size_t length = std::min(capacity, step.piece.size());
+    std::memcpy(buffer, step.piece.data(), length);
+    return length;
+  };
+}
+}  // namespace
+
+TEST(HttpBodySourceTest, PassesTryAgainOnWithoutProducingAnything)
+{
+  size_t calls{0};
+  std::atomic<uint32_t> sent{0};
+  const std::vector<Step> steps{{"", true}, {"ab", false}, {"", true}, {"", true}, {"cde", false}};
+  BodySource body{Script(steps, calls), BodySource::UNKNOWN_LENGTH, &sent};
+  uint8_t buffer[16];
+  std::string received;
+  std::vector<size_t> results;
+  while (true)
+  {
+    const size_t length = body.Fill(buffer, sizeof(buffer));
+    results.push_back(length);
+    if (length == 0)
+    {
+      break;
+    }
+    if (length != BodySource::TRY_AGAIN)
+    {
+      received.append(reinterpret_cast<const char*>(buffer), length);
+    }
+  }
+  const std::vector<size_t> expected{BodySource::TRY_AGAIN, 2, BodySource::TRY_AGAIN,
+                                     BodySource::TRY_AGAIN, 3, 0};
+  EXPECT_EQ(expected, results);
+  EXPECT_EQ("abcde", received);
+  EXPECT_EQ(5U, body.GetProduced());
+  EXPECT_EQ(5U, sent.load());
+  EXPECT_EQ(6U, calls);
+}
+
+TEST(HttpBodySourceTest, DoesNotExecuteTheSourceAfterItEndedTheBody)
+{
+  size_t calls{0};
+  BodySource body{Script({{"abc", false}}, calls), BodySource::UNKNOWN_LENGTH};
+  uint8_t buffer[8];
+  EXPECT_EQ(3U, body.Fill(buffer, sizeof(buffer)));
+  EXPECT_EQ(0U, body.Fill(buffer, sizeof(buffer)));
+  EXPECT_EQ(2U, calls);
+  // E.g. a file source closing its file at the end must not be asked again.
+  EXPECT_EQ(0U, body.Fill(buffer, sizeof(buffer)));
+  EXPECT_EQ(0U, body.Fill(buffer, sizeof(buffer)));
+  EXPECT_EQ(2U, calls);
+}
+
+TEST(HttpBodySourceTest, NeverAsksForMoreThanTheAnnouncedLength)
+{
+  size_t calls{0};
+  std::vector<size_t> capacities;
+  BodySource body{Script({{"0123456789", false}, {"abcdefghij", false}, {"", true},
+                          {"ABCDEFGHIJ", false}},
+                         calls, &capacities),
+                  14};
+  uint8_t buffer[10];
+  std::string received;
+  for (size_t length = body.Fill(buffer, sizeof(buffer)); length != 0;
+       length = body.Fill(buffer, sizeof(buffer)))
+  {
+    if (length != BodySource::TRY_AGAIN)
+    {
+      received.append(reinterpret_cast<const char*>(buffer), length);
+    }
+  }
+  EXPECT_EQ("0123456789abcd", received);
+  EXPECT_EQ((std::vector<size_t>{10, 4}), capacities);
+  EXPECT_EQ(2U, calls);  // Complete without asking the source for the end.
+}
+
+TEST(HttpBodySourceTest, ProducesAStringInPieces)
+{
+  std::string text(1000, '\0');
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    text[i] = static_cast<char>('a' + i % 26);
+  }
+  std::atomic<uint32_t> sent{0};
+  BodySource body{std::make_shared<const std::string>(text), &sent};
+  uint8_t buffer[64];
+  std::string received;
+  for (size_t length = body.Fill(buffer, sizeof(buffer)); length != 0;
+       length = body.Fill(buffer, sizeof(buffer)))
+  {
+    ASSERT_NE(BodySource::TRY_AGAIN, length);
+    ASSERT_LE(length, sizeof(buffer));
+    received.append(reinterpret_cast<const char*>(buffer), length);
+  }
+  EXPECT_EQ(text, received);
+  EXPECT_EQ(text.size(), sent.load());
+  EXPECT_EQ(0U, body.Fill(buffer, sizeof(buffer)));
+}
+
+TEST(HttpBodySourceTest, ProducesNothingForAnEmptyBody)
+{
+  uint8_t buffer[8];
+  BodySource empty{std::make_shared<const std::string>()};
+  EXPECT_EQ(0U, empty.Fill(buffer, sizeof(buffer)));
+  BodySource none{std::shared_ptr<const std::string>{}};
+  EXPECT_EQ(0U, none.Fill(buffer, sizeof(buffer)));
+  size_t calls{0};
+  BodySource zero{Script({{"never", false}}, calls), 0};
+  EXPECT_EQ(0U, zero.Fill(buffer, sizeof(buffer)));
+  EXPECT_EQ(0U, calls);
+}
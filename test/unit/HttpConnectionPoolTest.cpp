@@ -0,0 +1,304 @@
+// Standard header
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpConnectionPool.hpp>
+#include <esp32-modules/core/time/SimulatedClock.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+using Esp32Modules::Core::Time::SimulatedClock;
+
+namespace
+{
+/** Observations and behaviour of the fake transports of a pool. */
+struct Network
+{
+  std::vector<std::string> opened;  //!< Hosts connected to, in order.
+  size_t closed{0};                 //!< Number of transports destroyed.
+  std::vector<std::string> begun;   //!< URLs of the requests begun, in order.
+  size_t ended{0};                  //!< Number of requests ended.
+  bool refuse{false};               //!< Lets the factory refuse all origins.
+  bool connectable{true};           //!< Lets connecting succeed.
+  bool beginnable{true};            //!< Lets beginning a request succeed.
+  bool connected{true};             //!< Keeps the connections open.
+};
+
+class FakeTransport : public HttpTransport
+{
+ public:
+  FakeTransport(Network& network, const HttpOrigin& origin) : mNetwork{network}, mOrigin{origin}
+  {
+  }
+  ~FakeTransport() override { ++mNetwork.closed; }
+
+  bool Connect() override
+  {
+    mNetwork.opened.push_back(mOrigin.host);
+    return mNetwork.connectable;
+  }
+  bool Begin(const std::string& url) override
+  {
+    mNetwork.begun.push_back(url);
+    return mNetwork.beginnable;
+  }
+  void End() override { ++mNetwork.ended; }
+  bool Connected() override { return mNetwork.connected; }
+
+ private:
+  Network& mNetwork;
+  const HttpOrigin mOrigin;
+};
+
+HttpConnectionPool::TransportFactory FakeFactory(Network& network)
+{
+  return [&network](const HttpOrigin& origin) -> std::unique_ptr<HttpTransport> {
+    if (network.refuse)
+    {
+      return nullptr;
+    }
+    return std::make_unique<FakeTransport>(network, origin);
+  };
+}
+}  // namespace
+
+TEST(HttpConnectionPoolTest, ParsesTheOriginOfUrls)
+{
+  HttpOrigin origin{};
+  ASSERT_TRUE(ParseOrigin("http://example.com/path?query", origin));
+  EXPECT_FALSE(origin.secure);
+  EXPECT_EQ("example.com", origin.host);
+  EXPECT_EQ(80, origin.port);
+  ASSERT_TRUE(ParseOrigin("https://10.0.0.1:8443", origin));
+  EXPECT_TRUE(origin.secure);
+  EXPECT_EQ("10.0.0.1", origin.host);
+  EXPECT_EQ(8443, origin.port);
+  ASSERT_TRUE(ParseOrigin("https://example.com#top", origin));
+  EXPECT_EQ(443, origin.port);
+
+  EXPECT_FALSE(ParseOrigin("example.com/path", origin));
+  EXPECT_FALSE(ParseOrigin("ftp://example.com", origin));
+  EXPECT_FALSE(ParseOrigin("http:///path", origin));
+  EXPECT_FALSE(ParseOrigin("http://example.com:0/", origin));
+  EXPECT_FALSE(ParseOrigin("http://example.com:65536/", origin));
+  EXPECT_FALSE(ParseOrigin("http://example.com:80x/", origin));
+}
+
+TEST(HttpConnectionPoolTest, ReusesTheConnectionToTheSameOrigin)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+
+  for (int i = 0; i < 3; ++i)
+  {
+    auto* transport = pool.Acquire("http://example.com/" + std::to_string(i));
+    ASSERT_NE(nullptr, transport);
+    pool.Release(*transport);
+    clock.Advance(999);
+  }
+  EXPECT_EQ(std::vector<std::string>{"example.com"}, network.opened);
+  EXPECT_EQ(3U, network.begun.size());
+  EXPECT_EQ(3U, network.ended);
+  EXPECT_EQ(1U, pool.GetConnectionCount());
+
+  // Scheme and port are part of the origin.
+  auto* secure = pool.Acquire("https://example.com/");
+  ASSERT_NE(nullptr, secure);
+  pool.Release(*secure);
+  auto* otherPort = pool.Acquire("http://example.com:8080/");
+  ASSERT_NE(nullptr, otherPort);
+  pool.Release(*otherPort);
+  EXPECT_EQ(3U, network.opened.size());
+
+  const auto statistics = pool.GetStatistics();
+  EXPECT_EQ(5U, statistics.requests);
+  EXPECT_EQ(2U, statistics.reused);
+}
+
+TEST(HttpConnectionPoolTest, ClosesConnectionsIdleForTheTimeout)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+
+  auto* transport = pool.Acquire("http://example.com/");
+  ASSERT_NE(nullptr, transport);
+  clock.Advance(5000);  // Requests in progress are never idle.
+  pool.CloseIdle();
+  EXPECT_EQ(0U, network.closed);
+  pool.Release(*transport);
+
+  clock.Advance(999);
+  pool.CloseIdle();
+  EXPECT_EQ(1U, pool.GetConnectionCount());
+  clock.Advance(1);
+  pool.CloseIdle();
+  EXPECT_EQ(0U, pool.GetConnectionCount());
+  EXPECT_EQ(1U, network.closed);
+
+  // Acquiring closes idle connections first, so the next request connects again.
+  transport = pool.Acquire("http://example.com/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  EXPECT_EQ(2U, network.opened.size());
+  EXPECT_EQ(0U, pool.GetStatistics().reused);
+  EXPECT_EQ(1U, pool.GetStatistics().closed);
+}
+
+TEST(HttpConnectionPoolTest, ClosesConnectionsClosedByTheServer)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+
+  auto* transport = pool.Acquire("http://example.com/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  network.connected = false;
+  transport = pool.Acquire("http://example.com/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  EXPECT_EQ(2U, network.opened.size());
+  EXPECT_EQ(1U, network.closed);
+  EXPECT_EQ(0U, pool.GetStatistics().reused);
+}
+
+TEST(HttpConnectionPoolTest, EvictsTheLeastRecentlyUsedConnectionAtTheCap)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 100000, &clock};
+
+  std::vector<std::string> hosts;
+  for (int i = 0; i < ESP32MODULES_HTTP_MAX_CONNECTIONS; ++i)
+  {
+    hosts.push_back("host" + std::to_string(i));
+    auto* transport = pool.Acquire("http://" + hosts.back() + "/");
+    ASSERT_NE(nullptr, transport);
+    pool.Release(*transport);
+    clock.Advance(10);
+  }
+  // Uses the first host again, so the second one is the least recently used.
+  auto* transport = pool.Acquire("http://host0/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  clock.Advance(10);
+  EXPECT_EQ(static_cast<size_t>(ESP32MODULES_HTTP_MAX_CONNECTIONS), pool.GetConnectionCount());
+  EXPECT_EQ(0U, network.closed);
+
+  transport = pool.Acquire("http://other/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  EXPECT_EQ(1U, network.closed);
+  EXPECT_EQ(static_cast<size_t>(ESP32MODULES_HTTP_MAX_CONNECTIONS), pool.GetConnectionCount());
+  EXPECT_EQ(1U, pool.GetStatistics().closed);
+
+  // The first host is still connected, the second one is not.
+  const auto opened = network.opened.size();
+  transport = pool.Acquire("http://host0/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  EXPECT_EQ(opened, network.opened.size());
+  if (ESP32MODULES_HTTP_MAX_CONNECTIONS > 1)
+  {
+    transport = pool.Acquire("http://host1/");
+    ASSERT_NE(nullptr, transport);
+    pool.Release(*transport);
+    EXPECT_EQ(opened + 1, network.opened.size());
+  }
+}
+
+TEST(HttpConnectionPoolTest, RefusesRequestsIfAllConnectionsAreInUse)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+
+  std::vector<HttpTransport*> transports;
+  for (int i = 0; i < ESP32MODULES_HTTP_MAX_CONNECTIONS; ++i)
+  {
+    transports.push_back(pool.Acquire("http://example.com/"));
+    ASSERT_NE(nullptr, transports.back());
+  }
+  EXPECT_EQ(nullptr, pool.Acquire("http://example.com/"));
+  EXPECT_EQ(nullptr, pool.Acquire("http://other/"));
+  EXPECT_EQ(0U, network.closed);
+
+  pool.Release(*transports.front());
+  EXPECT_EQ(transports.front(), pool.Acquire("http://example.com/"));
+  for (auto* transport : transports)
+  {
+    pool.Release(*transport);
+  }
+  EXPECT_EQ(static_cast<uint32_t>(ESP32MODULES_HTTP_MAX_CONNECTIONS) + 1,
+            pool.GetStatistics().requests);
+}
+
+TEST(HttpConnectionPoolTest, KeepsNoConnectionIfConnectingOrBeginningFails)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+
+  EXPECT_EQ(nullptr, pool.Acquire("not a url"));
+  EXPECT_TRUE(network.opened.empty());
+
+  network.refuse = true;
+  EXPECT_EQ(nullptr, pool.Acquire("https://example.com/"));
+  network.refuse = false;
+
+  network.connectable = false;
+  EXPECT_EQ(nullptr, pool.Acquire("http://example.com/"));
+  EXPECT_EQ(0U, pool.GetConnectionCount());
+  EXPECT_EQ(1U, network.closed);
+  network.connectable = true;
+
+  network.beginnable = false;
+  EXPECT_EQ(nullptr, pool.Acquire("http://example.com/"));
+  EXPECT_EQ(0U, pool.GetConnectionCount());
+  EXPECT_EQ(2U, network.closed);
+  network.beginnable = true;
+
+  auto* transport = pool.Acquire("http://example.com/");
+  ASSERT_NE(nullptr, transport);
+  pool.Release(*transport);
+  EXPECT_EQ(1U, pool.GetStatistics().requests);
+  EXPECT_EQ(0U, pool.GetStatistics().closed);
+}
+
+TEST(HttpConnectionPoolTest, KeepsTheConnectionToAnotherServerIfTheFactoryRefuses)
+{
+  Network network;
+  SimulatedClock clock;
+  HttpConnectionPool pool{FakeFactory(network), 100000, &clock};
+
+  for (int i = 0; i < ESP32MODULES_HTTP_MAX_CONNECTIONS; ++i)
+  {
+    auto* transport = pool.Acquire("http://host" + std::to_string(i) + "/");
+    ASSERT_NE(nullptr, transport);
+    pool.Release(*transport);
+  }
+  network.refuse = true;
+  EXPECT_EQ(nullptr, pool.Acquire("https://other/"));
+  EXPECT_EQ(0U, network.closed);
+  EXPECT_EQ(static_cast<size_t>(ESP32MODULES_HTTP_MAX_CONNECTIONS), pool.GetConnectionCount());
+}
+
+TEST(HttpConnectionPoolTest, ClosesAllConnectionsOnDestruction)
+{
+  Network network;
+  SimulatedClock clock;
+  {
+    HttpConnectionPool pool{FakeFactory(network), 1000, &clock};
+    auto* transport = pool.Acquire("http://example.com/");
+    ASSERT_NE(nullptr, transport);
+    pool.Release(*transport);
+  }
+  EXPECT_EQ(1U, network.closed);
+}
@@ -0,0 +1,104 @@
+// Standard header
+#include <cstddef>
+#include <string>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpContent.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+/** Range parsed from the header (first and last byte), or the outcome if not partial. */
+struct Parsed
+{
+  ByteRange outcome;
+  size_t first;
+  size_t last;
+};
+
+Parsed Parse(const std::string& header, const size_t size)
+{
+  Parsed parsed{ByteRange::FULL, 12345, 12345};
+  parsed.outcome = ParseByteRange(header, size, parsed.first, parsed.last);
+  return parsed;
+}
+}  // namespace
+
+TEST(HttpContentTest, ParsesSingleRanges)
+{
+  auto parsed = Parse("bytes=0-99", 1000);
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 0u);
+  EXPECT_EQ(parsed.last, 99u);
+
+  parsed = Parse("bytes=100-", 1000);  // Open end.
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 100u);
+  EXPECT_EQ(parsed.last, 999u);
+
+  parsed = Parse("bytes=-500", 1000);  // Suffix.
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 500u);
+  EXPECT_EQ(parsed.last, 999u);
+
+  parsed = Parse("bytes=999-999", 1000);  // Last byte only.
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 999u);
+  EXPECT_EQ(parsed.last, 999u);
+}
+
+TEST(HttpContentTest, ClampsRangesToTheContent)
+{
+  auto parsed = Parse("bytes=900-5000", 1000);
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 900u);
+  EXPECT_EQ(parsed.last, 999u);
+
+  parsed = Parse("bytes=-5000", 1000);  // Longer suffix than the content.
+  EXPECT_EQ(parsed.outcome, ByteRange::PARTIAL);
+  EXPECT_EQ(parsed.first, 0u);
+  EXPECT_EQ(parsed.last, 999u);
+}
+
+TEST(HttpContentTest, RejectsUnsatisfiableRanges)
+{
+  EXPECT_EQ(Parse("bytes=1000-", 1000).outcome, ByteRange::UNSATISFIABLE);
+  EXPECT_EQ(Parse("bytes=1000-2000", 1000).outcome, ByteRange::UNSATISFIABLE);
+  EXPECT_EQ(Parse("bytes=-0", 1000).outcome, ByteRange::UNSATISFIABLE);
+  EXPECT_EQ(Parse("bytes=0-", 0).outcome, ByteRange::UNSATISFIABLE);  // Empty content.
+  EXPECT_EQ(Parse("bytes=-5", 0).outcome, ByteRange::UNSATISFIABLE);
+
+  const auto parsed = Parse("bytes=1000-", 1000);
+  EXPECT_EQ(parsed.first, 12345u);  // Only set for partial content.
+  EXPECT_EQ(parsed.last, 12345u);
+}
+
+TEST(HttpContentTest, IgnoresMalformedAndMultipleRanges)
+{
+  for (const char* header : {"", "bytes=", "bytes=-", "bytes=5", "bytes=5-1", "bytes=0-1,5-6",
+                             "items=0-1", "Bytes=0-1", "bytes=a-1", "bytes=1-b", "bytes= 0-1",
+                             "bytes=+1-2", "bytes=-+5", "bytes=0x10-", "bytes=1--2",
+                             "bytes=99999999999999999999999-"})
+  {
+    const auto parsed = Parse(header, 1000);
+    EXPECT_EQ(parsed.outcome, ByteRange::FULL) << header;
+    EXPECT_EQ(parsed.first, 12345u) << header;
+  }
+}
+
+TEST(HttpContentTest, DeterminesContentTypesByExtension)
+{
+  EXPECT_STREQ(GetContentType("/www/index.html"), "text/html");
+  EXPECT_STREQ(GetContentType("/www/app.js"), "application/javascript");
+  EXPECT_STREQ(GetContentType("/www/data.json"), "application/json");
+  EXPECT_STREQ(GetContentType("/fonts/a.woff2"), "font/woff2");  // Not taken for ".woff".
+  EXPECT_STREQ(GetContentType("/fonts/a.woff"), "font/woff");
+  EXPECT_STREQ(GetContentType("/www/app.js.gz"), "application/gzip");
+  EXPECT_STREQ(GetContentType("/www/README"), "application/octet-stream");
+  EXPECT_STREQ(GetContentType("/www/html"), "application/octet-stream");
+  EXPECT_STREQ(GetContentType(""), "application/octet-stream");
+}
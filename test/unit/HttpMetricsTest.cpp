@@ -0,0 +1,275 @@
+// Standard header
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/HttpMetrics.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+/** Renders all metrics at once. */
+std::string RenderAll(const HttpMetrics& metrics)
+{
+  std::string out;
+  size_t cursor{0};
+  while (metrics.Render(cursor, out))
+  {
+  }
+  return out;
+}
+
+/** Renders the metrics into buffers of the given size (like the streamed /metrics response). */
+std::string RenderInBuffers(const HttpMetrics& metrics, const size_t capacity)
+{
+  std::string out;
+  size_t cursor{0};
+  std::string piece;
+  size_t offset{0};
+  std::vector<uint8_t> buffer(capacity);
+  while (true)
+  {
+    size_t length{0};
+    while (length < capacity)
+    {
+      if (offset == piece.size())
+      {
+        piece.clear();
+        offset = 0;
+        if (not metrics.Render(cursor, piece))
+        {
+          break;
+        }
+      }
+      const size_t chunk = std::min(capacity - length, piece.size() - offset);
+      std::memcpy(buffer.data() + length, piece.data() + offset, chunk);
+      length += chunk;
+      offset += chunk;
+    }
+    if (length == 0)
+    {
+      return out;
+    }
+    out.append(reinterpret_cast<const char*>(buffer.data()), length);
+  }
+}
+
+/** Counts the occurrences of the text. */
+size_t Count(const std::string& text, const std::string& part)
+{
+  size_t count{0};
+  for (auto position = text.find(part); position != std::string::npos;
+       position = text.find(part, position + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(HttpMetricsTest, SortsDurationsIntoBucketsIncludingTheirUpperBound)
+{
+  LatencyHistogram histogram;
+  histogram.Record(0);
+  histogram.Record(LatencyHistogram::BOUNDS[0]);
+  histogram.Record(LatencyHistogram::BOUNDS[0] + 1);
+  histogram.Record(LatencyHistogram::BOUNDS[LatencyHistogram::BOUND_COUNT - 1]);
+  histogram.Record(LatencyHistogram::BOUNDS[LatencyHistogram::BOUND_COUNT - 1] + 1);
+  histogram.Record(std::numeric_limits<uint32_t>::max());
+
+  EXPECT_EQ(2U, histogram.GetBucket(0));
+  EXPECT_EQ(1U, histogram.GetBucket(1));
+  EXPECT_EQ(1U, histogram.GetBucket(LatencyHistogram::BOUND_COUNT - 1));
+  EXPECT_EQ(2U, histogram.GetBucket(LatencyHistogram::BOUND_COUNT));  // +Inf
+  uint32_t total{0};
+  for (size_t i = 0; i <= LatencyHistogram::BOUND_COUNT; ++i)
+  {
+    total += histogram.GetBucket(i);
+  }
+  EXPECT_EQ(6U, total);
+  EXPECT_EQ(6U, histogram.GetCount());
+}
+
+TEST(HttpMetricsTest, RendersCumulativeBucketsUpToInfinity)
+{
+  HttpMetrics metrics;
+  auto* endpoint = metrics.Get(HttpMetrics::Side::SERVER, "/sensor");
+  ASSERT_NE(nullptr, endpoint);
+  endpoint->RecordStatus(200);
+  endpoint->RecordStatus(404);
+  endpoint->RecordStatus(-1);
+  endpoint->phases[EndpointMetrics::HANDLER].Record(1000);
+  endpoint->phases[EndpointMetrics::HANDLER].Record(1001);
+  endpoint->phases[EndpointMetrics::HANDLER].Record(6000000);
+
+  const auto text = RenderAll(metrics);
+  const std::string labels{"{side=\"server\",endpoint=\"/sensor\""};
+  EXPECT_NE(std::string::npos, text.find("http_requests_total" + labels + "} 3\n"));
+  EXPECT_NE(std::string::npos, text.find("http_responses_total" + labels + ",class=\"2xx\"} 1\n"));
+  EXPECT_NE(std::string::npos, text.find("http_responses_total" + labels + ",class=\"4xx\"} 1\n"));
+  EXPECT_NE(std::string::npos,
+            text.find("http_responses_total" + labels + ",class=\"error\"} 1\n"));
+  const std::string bucket{"http_duration_seconds_bucket" + labels + ",phase=\"handler\""};
+  EXPECT_NE(std::string::npos, text.find(bucket + ",le=\"0.001\"} 1\n"));
+  EXPECT_NE(std::string::npos, text.find(bucket + ",le=\"0.0025\"} 2\n"));
+  EXPECT_NE(std::string::npos, text.find(bucket + ",le=\"5\"} 2\n"));
+  EXPECT_NE(std::string::npos, text.find(bucket + ",le=\"+Inf\"} 3\n"));
+  EXPECT_NE(std::string::npos,
+            text.find("http_duration_seconds_sum" + labels + ",phase=\"handler\"} 6.002001\n"));
+  EXPECT_NE(std::string::npos,
+            text.find("http_duration_seconds_count" + labels + ",phase=\"handler\"} 3\n"));
+  EXPECT_EQ(1U, Count(text, "# TYPE http_duration_seconds histogram\n"));
+}
+
+TEST(HttpMetricsTest, RendersThePhasesOfEachSide)
+{
+  HttpMetrics metrics;
+  ASSERT_NE(nullptr, metrics.Get(HttpMetrics::Side::SERVER, "/route"));
+  ASSERT_NE(nullptr, metrics.Get(HttpMetrics::Side::CLIENT, "example.com"));
+
+  const auto text = RenderAll(metrics);
+  const std::string server{"http_duration_seconds_count{side=\"server\",endpoint=\"/route\""};
+  const std::string client{
+      "http_duration_seconds_count{side=\"client\",endpoint=\"example.com\""};
+  for (const char* phase : {"handler", "total"})
+  {
+    EXPECT_EQ(1U, Count(text, server + ",phase=\"" + phase + "\"} 0\n"));
+  }
+  for (const char* phase : {"dns", "connect", "request", "transfer"})
+  {
+    EXPECT_EQ(1U, Count(text, client + ",phase=\"" + phase + "\"} 0\n"));
+  }
+  EXPECT_EQ(2U, Count(text, server));
+  EXPECT_EQ(4U, Count(text, client));
+}
+
+TEST(HttpMetricsTest, RenderingInSmallBuffersMatchesRenderingAtOnce)
+{
+  HttpMetrics metrics;
+  for (int i = 0; i < 5; ++i)
+  {
+    auto* endpoint = metrics.Get(i % 2 ? HttpMetrics::Side::CLIENT : HttpMetrics::Side::SERVER,
+                                 "/endpoint/" + std::to_string(i));
+    ASSERT_NE(nullptr, endpoint);
+    endpoint->RecordStatus(200 + i);
+    endpoint->bytesSent += static_cast<uint32_t>(i * 1000);
+    for (size_t phase = 0; phase < EndpointMetrics::PHASE_COUNT; ++phase)
+    {
+      endpoint->phases[phase].Record(static_cast<uint32_t>(i * 12345 + phase));
+    }
+  }
+
+  const auto expected = RenderAll(metrics);
+  ASSERT_FALSE(expected.empty());
+  for (const size_t capacity : {1, 7, 64, 1436})
+  {
+    EXPECT_EQ(expected, RenderInBuffers(metrics, capacity)) << capacity;
+  }
+
+  // Rendering ends for good, even if called again.
+  size_t cursor{0};
+  std::string piece;
+  while (metrics.Render(cursor, piece))
+  {
+  }
+  piece.clear();
+  EXPECT_FALSE(metrics.Render(cursor, piece));
+  EXPECT_TRUE(piece.empty());
+}
+
+TEST(HttpMetricsTest, RendersNothingWithoutEndpoints)
+{
+  HttpMetrics metrics;
+  EXPECT_TRUE(RenderAll(metrics).empty());
+}
+
+TEST(HttpMetricsTest, RefusesEndpointsBeyondTheTable)
+{
+  HttpMetrics metrics;
+  std::vector<EndpointMetrics*> endpoints;
+  for (int i = 0; i < ESP32MODULES_HTTP_MAX_METRICS; ++i)
+  {
+    endpoints.push_back(metrics.Get(i % 2 ? HttpMetrics::Side::CLIENT : HttpMetrics::Side::SERVER,
+                                    "host" + std::to_string(i)));
+    ASSERT_NE(nullptr, endpoints.back());
+  }
+  EXPECT_EQ(static_cast<size_t>(ESP32MODULES_HTTP_MAX_METRICS), metrics.Size());
+  EXPECT_EQ(nullptr, metrics.Get(HttpMetrics::Side::SERVER, "other"));
+  // The same label on the other side is another endpoint.
+  EXPECT_EQ(nullptr, metrics.Get(HttpMetrics::Side::CLIENT, "host0"));
+  // Tracked endpoints are still found.
+  EXPECT_EQ(endpoints.front(), metrics.Get(HttpMetrics::Side::SERVER, "host0"));
+  EXPECT_EQ(endpoints.back(),
+            metrics.Get(HttpMetrics::Side::CLIENT,
+                        "host" + std::to_string(ESP32MODULES_HTTP_MAX_METRICS - 1)));
+
+  const auto text = RenderAll(metrics);
+  EXPECT_EQ(static_cast<size_t>(ESP32MODULES_HTTP_MAX_METRICS),
+            Count(text, "http_requests_total{"));
+  EXPECT_EQ(text, RenderInBuffers(metrics, 13));
+}
+
+TEST(HttpMetricsTest, EscapesAndTruncatesLabels)
+{
+  HttpMetrics metrics;
+  auto* endpoint = metrics.Get(HttpMetrics::Side::SERVER, "/a\"b\\c");
+  ASSERT_NE(nullptr, endpoint);
+  EXPECT_NE(std::string::npos, RenderAll(metrics).find(
+                                   R"(http_requests_total{side="server",endpoint="/a\"b\\c"})"));
+
+  const std::string longLabel(ESP32MODULES_HTTP_METRICS_LABEL_LENGTH * 2, 'x');
+  auto* truncated = metrics.Get(HttpMetrics::Side::CLIENT, longLabel);
+  ASSERT_NE(nullptr, truncated);
+  EXPECT_EQ(std::string(ESP32MODULES_HTTP_METRICS_LABEL_LENGTH - 1, 'x'), truncated->label);
+  // Labels sharing the truncated prefix share the endpoint.
+  EXPECT_EQ(truncated, metrics.Get(HttpMetrics::Side::CLIENT, longLabel + "y"));
+}
+
+TEST(HttpMetricsTest, AddsAnEndpointRequestedConcurrentlyOnce)
+{
+  constexpr size_t THREAD_COUNT{8};
+  constexpr int REQUEST_COUNT{1000};
+  HttpMetrics metrics;
+  std::atomic<bool> go{false};
+  std::vector<EndpointMetrics*> found(THREAD_COUNT, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREAD_COUNT; ++t)
+  {
+    threads.emplace_back([&metrics, &go, &found, t] {
+      while (not go.load())
+      {
+      }
+      for (int i = 0; i < REQUEST_COUNT; ++i)
+      {
+        auto* endpoint = metrics.Get(HttpMetrics::Side::SERVER, "/shared");
+        endpoint->RecordStatus(200);
+        endpoint->phases[EndpointMetrics::HANDLER].Record(10);
+        found[t] = endpoint;
+      }
+    });
+  }
+  go.store(true);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(1U, metrics.Size());
+  for (auto* endpoint : found)
+  {
+    EXPECT_EQ(found.front(), endpoint);
+  }
+  EXPECT_EQ(THREAD_COUNT * REQUEST_COUNT, found.front()->requests.load());
+  EXPECT_EQ(THREAD_COUNT * REQUEST_COUNT,
+            found.front()->phases[EndpointMetrics::HANDLER].GetCount());
+}
@@ -0,0 +1,57 @@
+// Standard header
+#include <chrono>
+#include <cstdint>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/low-power/LightSleep.hpp>
+#include <esp32-modules/core/scheduling/IdlePolicy.hpp>
+#include <esp32-modules/core/time/SimulatedClock.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core;
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+TEST(IdlePolicyTest, SleepsLightOrDeepDependingOnTheGap)
+{
+  Time::SimulatedClock clock;
+  TicklessIdlePolicy policy{clock, 2 * TASK_SECOND, 5 * TASK_MILLISECOND};
+
+  policy.OnIdle(4);                // Too short to be worth it.
+  policy.OnIdle(NO_TASK_PENDING);  // Nothing would wake us up.
+  EXPECT_EQ(clock.GetStatistics().lightSleeps, 0u);
+  EXPECT_EQ(clock.Millis(), 0u);
+
+  policy.OnIdle(5);
+  policy.OnIdle(2 * TASK_SECOND - 1);
+  EXPECT_EQ(clock.GetStatistics().lightSleeps, 2u);
+  EXPECT_EQ(clock.GetStatistics().deepSleeps, 0u);
+
+  policy.OnIdle(2 * TASK_SECOND);
+  EXPECT_EQ(clock.GetStatistics().deepSleeps, 1u);
+  EXPECT_EQ(clock.Millis(), 4 * TASK_SECOND + 4);
+  EXPECT_EQ(clock.GetStatistics().sleptDuration, 4 * TASK_SECOND + 4);
+}
+
+TEST(IdlePolicyTest, SchedulerSleepsExactlyUntilTheNextTask)
+{
+  SchedulerHarness harness;
+  harness.Scheduler().AddCyclicTask(40 * TASK_MILLISECOND, [&harness] { harness.Work(7000); });
+
+  harness.RunFor(TASK_SECOND);
+
+  // The task takes 7 ms of each period, the remaining 33 ms are slept in one go.
+  const auto& statistics = harness.Clock().GetStatistics();
+  EXPECT_EQ(statistics.lightSleeps, 25u);
+  EXPECT_EQ(statistics.sleptDuration, 40u + 24 * 33);
+}
+
+TEST(IdlePolicyTest, HostLightSleepBlocksForTheDuration)
+{
+  const auto start = std::chrono::steady_clock::now();
+  LowPower::LightSleepFor(std::chrono::milliseconds{5});
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{5});
+}
@@ -0,0 +1,111 @@
+// Standard header
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/InplaceFunction.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+bool gCountAllocations{false};  //!< Enables counting in the global operator new.
+uint32_t gAllocations{0};       //!< Allocations while counting.
+
+/** Counts the heap allocations in its scope. */
+class AllocationCounter
+{
+ public:
+  AllocationCounter()
+  {
+    gAllocations = 0;
+    gCountAllocations = true;
+  }
+  ~AllocationCounter() { gCountAllocations = false; }
+
+  uint32_t Count() const { return gAllocations; }
+};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  if (gCountAllocations)
+  {
+    ++gAllocations;
+  }
+  if (void* memory = std::malloc(size ? size : 1))
+  {
+    return memory;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+TEST(InplaceFunctionTest, StoresCapturesInPlaceAndDestroysThem)
+{
+  auto shared = std::make_shared<int>(42);
+  {
+    InplaceFunction<int(int), 32> function{[shared](const int value) { return *shared + value; }};
+    EXPECT_EQ(shared.use_count(), 2);
+    EXPECT_EQ(function(1), 43);
+
+    InplaceFunction<int(int), 32> moved{std::move(function)};
+    EXPECT_FALSE(function);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(shared.use_count(), 2);  // Moved, not copied.
+    EXPECT_EQ(moved(2), 44);
+
+    moved = nullptr;
+    EXPECT_FALSE(moved);
+    EXPECT_EQ(shared.use_count(), 1);
+
+    function = [shared](const int value) { return value; };
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(InplaceFunctionTest, TasksWithFullCapturesDoNotAllocate)
+{
+  SchedulerHarness harness;
+  auto& scheduler = harness.Scheduler();
+  std::array<uint32_t, 4> counters{};
+  uint32_t* a = &counters[0];
+  uint32_t* b = &counters[1];
+  uint32_t* c = &counters[2];
+  uint32_t* d = &counters[3];
+  static_assert(4 * sizeof(void*) <= ESP32MODULES_SCHEDULER_CALLBACK_SIZE);
+
+  {
+    AllocationCounter reference;  // Makes sure allocations are actually counted.
+    std::function<void()> allocating{[a, b, c, d] { ++*a, ++*b, ++*c, ++*d; }};
+    EXPECT_EQ(reference.Count(), 1u);
+  }
+
+  AllocationCounter allocations;
+  for (int round = 0; round < 100; ++round)
+  {
+    scheduler.AddOneShotTask(1, [a, b, c, d] { ++*a, ++*b, ++*c, ++*d; });
+    const TaskId cyclic = scheduler.AddCyclicTask(1, [a] { ++*a; });
+    const TaskId aborted = scheduler.AddOneShotTask(5, [b] { ++*b; });
+    harness.RunFor(1);
+    scheduler.AbortTask(cyclic);
+    scheduler.AbortTask(aborted);
+  }
+  EXPECT_EQ(allocations.Count(), 0u);
+  EXPECT_EQ(counters[0], 200u);
+  EXPECT_EQ(counters[1], 100u);
+  EXPECT_EQ(counters[3], 100u);
+}
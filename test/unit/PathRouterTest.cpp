@@ -0,0 +1,114 @@
+// Standard header
+#include <string>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/PathRouter.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+TEST(PathRouterTest, MatchesLiteralsAndCaptures)
+{
+  PathRouter router;
+  const auto sensor = router.Add("/sensor/{id}");
+  const auto value = router.Add("/sensor/{id}/value");
+  const auto all = router.Add("/sensor/all");
+  const auto root = router.Add("/");
+  const auto pair = router.Add("/x/{a}/y/{b}");
+  EXPECT_EQ(router.Size(), 5u);
+
+  RouteMatch match{};
+  ASSERT_TRUE(router.Match("/sensor/42", match));
+  EXPECT_EQ(match.route, sensor);
+  EXPECT_EQ(match.captureCount, 1u);
+  EXPECT_EQ(match.GetCapture("id"), "42");
+
+  ASSERT_TRUE(router.Match("/sensor/42/value", match));
+  EXPECT_EQ(match.route, value);
+  EXPECT_EQ(match.GetCapture("id"), "42");
+
+  ASSERT_TRUE(router.Match("/sensor/all", match));  // The literal takes precedence.
+  EXPECT_EQ(match.route, all);
+  EXPECT_EQ(match.captureCount, 0u);
+
+  ASSERT_TRUE(router.Match("/x/1/y/2", match));
+  EXPECT_EQ(match.route, pair);
+  EXPECT_EQ(match.GetCapture("a"), "1");
+  EXPECT_EQ(match.GetCapture("b"), "2");
+  EXPECT_TRUE(match.GetCapture("c").empty());
+
+  ASSERT_TRUE(router.Match("/", match));
+  EXPECT_EQ(match.route, root);
+}
+
+TEST(PathRouterTest, CapturesReferToThePath)
+{
+  PathRouter router;
+  router.Add("/files/{name}");
+  const std::string path{"/files/readme.txt"};
+  RouteMatch match{};
+  ASSERT_TRUE(router.Match(path, match));
+  EXPECT_EQ(match.captureValues[0].data(), path.data() + 7);  // Not copied.
+  EXPECT_EQ(match.captureNames[0], "name");
+}
+
+TEST(PathRouterTest, IgnoresEmptySegmentsAndTheQuery)
+{
+  PathRouter router;
+  const auto value = router.Add("/sensor/{id}/value");
+  const auto root = router.Add("/");
+  RouteMatch match{};
+  ASSERT_TRUE(router.Match("//sensor//7/value/", match));
+  EXPECT_EQ(match.route, value);
+  EXPECT_EQ(match.GetCapture("id"), "7");
+  ASSERT_TRUE(router.Match("/sensor/7/value?unit=celsius&x=/y", match));
+  EXPECT_EQ(match.route, value);
+  EXPECT_EQ(match.GetCapture("id"), "7");
+  ASSERT_TRUE(router.Match("", match));
+  EXPECT_EQ(match.route, root);
+  ASSERT_TRUE(router.Match("?x=1", match));
+  EXPECT_EQ(match.route, root);
+}
+
+TEST(PathRouterTest, RejectsPathsWithoutRoute)
+{
+  PathRouter router;
+  router.Add("/sensor/{id}");
+  router.Add("/sensor/all/value");
+  RouteMatch match{};
+  EXPECT_FALSE(router.Match("/sensor", match));      // Too short.
+  EXPECT_FALSE(router.Match("/sensor/1/2", match));  // Too long.
+  EXPECT_FALSE(router.Match("/nope", match));
+  EXPECT_FALSE(router.Match("/", match));
+  // No backtracking: the literal "all" is followed, which has no route on its own.
+  EXPECT_FALSE(router.Match("/sensor/all", match));
+
+  const PathRouter empty;
+  EXPECT_FALSE(empty.Match("/", match));
+}
+
+TEST(PathRouterTest, RejectsMalformedPatterns)
+{
+  PathRouter router;
+  const auto sensor = router.Add("/sensor/{id}");
+  EXPECT_EQ(router.Add("/sensor/{id}"), sensor);  // Already added.
+  EXPECT_EQ(router.Add("/sensor/{other}"), sensor);  // Same shape, the first names are kept.
+  EXPECT_EQ(router.Add("/bad{x}"), PathRouter::NO_ROUTE);
+  EXPECT_EQ(router.Add("/{}"), PathRouter::NO_ROUTE);
+  EXPECT_EQ(router.Add("/{open"), PathRouter::NO_ROUTE);
+
+  std::string tooMany;
+  for (int i = 0; i <= ESP32MODULES_HTTP_MAX_CAPTURES; ++i)
+  {
+    tooMany += "/{c" + std::to_string(i) + "}";
+  }
+  EXPECT_EQ(router.Add(tooMany), PathRouter::NO_ROUTE);
+  EXPECT_EQ(router.Size(), 1u);
+
+  RouteMatch match{};
+  ASSERT_TRUE(router.Match("/sensor/1", match));
+  EXPECT_EQ(match.GetCapture("id"), "1");
+  EXPECT_TRUE(match.GetCapture("other").empty());
+}
@@ -0,0 +1,146 @@
+// Standard header
+#include <memory>
+#include <string>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/ResponseCache.hpp>
+
+using namespace Esp32Modules::Connectivity::Http;
+
+namespace
+{
+std::shared_ptr<const std::string> MakeBody(const std::string& body)
+{
+  return std::make_shared<const std::string>(body);
+}
+
+/** Budget fitting the given number of entries with keys of 2 and bodies of 100 bytes. */
+size_t BudgetFor(const size_t entries)
+{
+  const auto etag = ResponseCache::MakeETag(std::string(100, 'x'));
+  return entries * (sizeof(ResponseCache::Entry) + 2 + etag.size() + 4 + 100);
+}
+}  // namespace
+
+TEST(ResponseCacheTest, ServesTheBodyUntilTheVersionChanges)
+{
+  ResponseCache cache{};
+  EXPECT_EQ(nullptr, cache.Find("/a", 1));
+  const auto body = MakeBody("{\"value\":1}");
+  const auto* stored = cache.Store("/a", 1, "application/json", body);
+  ASSERT_NE(nullptr, stored);
+  EXPECT_EQ(ResponseCache::MakeETag(*body), stored->etag);
+
+  const auto* found = cache.Find("/a", 1);
+  ASSERT_NE(nullptr, found);
+  EXPECT_EQ(body, found->body);  // Shared, not copied.
+  EXPECT_EQ("application/json", found->contentType);
+  EXPECT_EQ(nullptr, cache.Find("/b", 1));
+
+  // Bumping the version invalidates the entry.
+  EXPECT_EQ(nullptr, cache.Find("/a", 2));
+  const auto size = cache.GetSize();
+  ASSERT_NE(nullptr, cache.Store("/a", 2, "application/json", MakeBody("{\"value\":2}")));
+  EXPECT_EQ(size, cache.GetSize());  // Replaced, not added.
+  EXPECT_EQ(nullptr, cache.Find("/a", 1));
+  EXPECT_NE(nullptr, cache.Find("/a", 2));
+
+  const auto statistics = cache.GetStatistics();
+  EXPECT_EQ(2U, statistics.hits);
+  EXPECT_EQ(4U, statistics.misses);
+  EXPECT_EQ(0U, statistics.evictions);
+}
+
+TEST(ResponseCacheTest, DerivesTheETagFromTheBody)
+{
+  const auto etag = ResponseCache::MakeETag("body");
+  EXPECT_EQ('"', etag.front());
+  EXPECT_EQ('"', etag.back());
+  EXPECT_EQ(etag, ResponseCache::MakeETag("body"));
+  EXPECT_NE(etag, ResponseCache::MakeETag("Body"));
+  EXPECT_NE(etag, ResponseCache::MakeETag("body "));
+
+  // The same body rendered for a new version keeps its ETag, a changed one does not.
+  ResponseCache cache{};
+  const auto first = cache.Store("/a", 1, "text/plain", MakeBody("same"))->etag;
+  EXPECT_EQ(first, cache.Store("/a", 2, "text/plain", MakeBody("same"))->etag);
+  EXPECT_NE(first, cache.Store("/a", 3, "text/plain", MakeBody("changed"))->etag);
+}
+
+TEST(ResponseCacheTest, EvictsTheLeastRecentlyUsedEntriesToStayWithinTheBudget)
+{
+  ResponseCache cache{BudgetFor(3)};
+  for (const char* key : {"/a", "/b", "/c"})
+  {
+    ASSERT_NE(nullptr, cache.Store(key, 1, "text", MakeBody(std::string(100, key[1]))));
+  }
+  EXPECT_EQ(BudgetFor(3), cache.GetSize());
+  ASSERT_NE(nullptr, cache.Find("/a", 1));  // Makes "/b" the least recently used one.
+
+  ASSERT_NE(nullptr, cache.Store("/d", 1, "text", MakeBody(std::string(100, 'd'))));
+  EXPECT_EQ(1U, cache.GetStatistics().evictions);
+  EXPECT_LE(cache.GetSize(), BudgetFor(3));
+  EXPECT_EQ(nullptr, cache.Find("/b", 1));
+  EXPECT_NE(nullptr, cache.Find("/a", 1));
+  EXPECT_NE(nullptr, cache.Find("/c", 1));
+  EXPECT_NE(nullptr, cache.Find("/d", 1));
+
+  // A larger body evicts as many entries as needed.
+  ASSERT_NE(nullptr, cache.Store("/e", 1, "text", MakeBody(std::string(250, 'e'))));
+  EXPECT_LE(cache.GetSize(), BudgetFor(3));
+  EXPECT_EQ(3U, cache.GetStatistics().evictions);
+  EXPECT_EQ(nullptr, cache.Find("/a", 1));
+  EXPECT_EQ(nullptr, cache.Find("/c", 1));
+  EXPECT_NE(nullptr, cache.Find("/d", 1));
+}
+
+TEST(ResponseCacheTest, RefusesBodiesExceedingTheBudgetOnTheirOwn)
+{
+  ResponseCache cache{BudgetFor(2)};
+  ASSERT_NE(nullptr, cache.Store("/a", 1, "text", MakeBody(std::string(100, 'a'))));
+  const auto size = cache.GetSize();
+  EXPECT_EQ(nullptr, cache.Store("/b", 1, "text", MakeBody(std::string(BudgetFor(2), 'b'))));
+  // Nothing is evicted for a body that would not fit anyway.
+  EXPECT_EQ(size, cache.GetSize());
+  EXPECT_NE(nullptr, cache.Find("/a", 1));
+  EXPECT_EQ(0U, cache.GetStatistics().evictions);
+}
+
+TEST(ResponseCacheTest, MatchesTheETagsListedByIfNoneMatch)
+{
+  const std::string etag{"\"1234abcd-10\""};
+  EXPECT_TRUE(ResponseCache::MatchesETag("\"1234abcd-10\"", etag));
+  EXPECT_TRUE(ResponseCache::MatchesETag("\"other\", \"1234abcd-10\"", etag));
+  EXPECT_TRUE(ResponseCache::MatchesETag(" \"other\" ,\t\"1234abcd-10\" ", etag));
+  EXPECT_TRUE(ResponseCache::MatchesETag("\"a,b\",\"1234abcd-10\"", etag));
+
+  EXPECT_FALSE(ResponseCache::MatchesETag("", etag));
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"other\"", etag));
+  // Exact comparison: neither substrings nor tags containing the ETag match.
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"1234abcd-1\"", etag));
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"x1234abcd-10\"", etag));
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"1234abcd-10\"x\"\"", "\"1234abcd-10\"x\""));
+  EXPECT_FALSE(ResponseCache::MatchesETag("1234abcd-10", etag));
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"1234abcd-10", etag));
+}
+
+TEST(ResponseCacheTest, ComparesETagsWeaklyForIfNoneMatch)
+{
+  EXPECT_TRUE(ResponseCache::MatchesETag("W/\"1234abcd-10\"", "\"1234abcd-10\""));
+  EXPECT_TRUE(ResponseCache::MatchesETag("\"1234abcd-10\"", "W/\"1234abcd-10\""));
+  EXPECT_TRUE(ResponseCache::MatchesETag("\"a\", W/\"1234abcd-10\"", "W/\"1234abcd-10\""));
+  EXPECT_FALSE(ResponseCache::MatchesETag("W/\"other\"", "\"1234abcd-10\""));
+  EXPECT_FALSE(ResponseCache::MatchesETag("w/\"1234abcd-10\"", "\"1234abcd-10\""));
+}
+
+TEST(ResponseCacheTest, MatchesAnyETagWithAWildcard)
+{
+  EXPECT_TRUE(ResponseCache::MatchesETag("*", "\"1234abcd-10\""));
+  EXPECT_TRUE(ResponseCache::MatchesETag(" * ", "\"1234abcd-10\""));
+  // Only as the whole value, not as an entity tag of a list.
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"*\"", "\"1234abcd-10\""));
+  EXPECT_FALSE(ResponseCache::MatchesETag("\"other\", *", "\"1234abcd-10\""));
+}
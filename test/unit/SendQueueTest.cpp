@@ -0,0 +1,124 @@
+// Standard header
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/connectivity/SendQueue.hpp>
+
+using namespace Esp32Modules::Connectivity;
+
+namespace
+{
+/** Transport recording the chunks, completions are signaled by the test. */
+struct FakeTransport
+{
+  std::vector<std::string> chunks;  //!< Chunks taken.
+  bool busy{false};                 //!< Rejects chunks while set (e.g. congested).
+
+  bool operator()(const uint8_t* chunk, const size_t length)
+  {
+    if (busy)
+    {
+      return false;
+    }
+    chunks.emplace_back(reinterpret_cast<const char*>(chunk), length);
+    return true;
+  }
+};
+
+using Queue = SendQueue<256, 20, 64>;
+
+bool Enqueue(Queue& queue, const std::string& message)
+{
+  return queue.Enqueue(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+}
+}  // namespace
+
+TEST(SendQueueTest, FlushStallsAtMaxInFlightUntilChunksComplete)
+{
+  FakeTransport transport;
+  Queue queue{[&transport](const uint8_t* chunk, const size_t length) {
+                return transport(chunk, length);
+              },
+              2};
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_TRUE(Enqueue(queue, std::string(20, static_cast<char>('a' + i))));
+  }
+
+  EXPECT_EQ(queue.Flush(), 2u);  // Not all five chunks in one burst.
+  EXPECT_EQ(transport.chunks.size(), 2u);
+  EXPECT_EQ(queue.GetStatistics().stalls, 1u);
+  EXPECT_EQ(queue.Flush(), 0u);  // Still nothing completed.
+  EXPECT_EQ(queue.GetStatistics().stalls, 2u);
+
+  queue.OnSent();
+  EXPECT_EQ(queue.Flush(), 1u);
+  queue.OnSent();
+  queue.OnSent();
+  queue.OnSent();  // More completions than chunks in flight do not raise the limit.
+  EXPECT_EQ(queue.Flush(), 2u);
+  EXPECT_EQ(transport.chunks.size(), 5u);
+  EXPECT_EQ(transport.chunks[4], std::string(20, 'e'));
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(SendQueueTest, RejectedChunksAreRetriedWithoutLosingCredits)
+{
+  FakeTransport transport;
+  Queue queue{[&transport](const uint8_t* chunk, const size_t length) {
+                return transport(chunk, length);
+              },
+              1};
+  ASSERT_TRUE(Enqueue(queue, "hello"));
+  transport.busy = true;
+  EXPECT_EQ(queue.Flush(), 0u);
+  EXPECT_EQ(queue.Flush(), 0u);
+  transport.busy = false;
+  EXPECT_EQ(queue.Flush(), 1u);
+  EXPECT_EQ(transport.chunks, std::vector<std::string>{"hello"});
+  EXPECT_EQ(queue.GetStatistics().stalls, 2u);
+}
+
+TEST(SendQueueTest, CoalescesSmallMessagesAndSplitsLargeOnes)
+{
+  FakeTransport transport;
+  Queue queue{[&transport](const uint8_t* chunk, const size_t length) {
+                return transport(chunk, length);
+              },
+              100};
+  ASSERT_TRUE(Enqueue(queue, "one\n"));
+  ASSERT_TRUE(Enqueue(queue, "two\n"));
+  ASSERT_TRUE(Enqueue(queue, "a message which fits into a chunk? no\n"));
+  ASSERT_TRUE(Enqueue(queue, "sixteen bytes..\n"));
+  ASSERT_TRUE(Enqueue(queue, "end\n"));
+  EXPECT_FALSE(Enqueue(queue, std::string(65, 'x')));
+  EXPECT_FALSE(Enqueue(queue, ""));
+
+  queue.Flush();
+  EXPECT_EQ(transport.chunks,
+            (std::vector<std::string>{"one\ntwo\na message wh", "ich fits into a chun",
+                                      "k? no\n", "sixteen bytes..\nend\n"}));
+  EXPECT_EQ(queue.GetStatistics().rejected, 2u);
+  EXPECT_EQ(queue.GetStatistics().messages, 5u);
+}
+
+TEST(SendQueueTest, ResetForgetsChunksInFlightAndThePartialMessage)
+{
+  FakeTransport transport;
+  Queue queue{[&transport](const uint8_t* chunk, const size_t length) {
+                return transport(chunk, length);
+              },
+              1};
+  queue.SetChunkSize(4);
+  ASSERT_TRUE(Enqueue(queue, "abcdefgh"));
+  ASSERT_TRUE(Enqueue(queue, "next"));
+  EXPECT_EQ(queue.Flush(), 1u);  // "abcd", then out of credits.
+  queue.Reset();
+  EXPECT_EQ(queue.Flush(), 1u);
+  EXPECT_EQ(transport.chunks, (std::vector<std::string>{"abcd", "next"}));
+}
@@ -0,0 +1,139 @@
+// Standard header
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/TaskEvent.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+// Built with ESP32MODULES_SCHEDULER_PROFILING to cover the latency statistics.
+static_assert(sizeof(TaskEvent::Statistics) > 2 * sizeof(uint32_t));
+
+TEST(TaskEventTest, SignalsRunBeforeTimedTasksInOrderOfSignaling)
+{
+  SchedulerHarness harness;
+  std::vector<int> order;
+  TaskEvent first{harness.Scheduler(), [&order] { order.push_back(1); }};
+  TaskEvent second{harness.Scheduler(), [&order] { order.push_back(2); }};
+  harness.Scheduler().AddOneShotTask(0, [&order] { order.push_back(0); });
+  harness.Clock().Advance(1);
+
+  second.Signal();
+  first.Signal();
+  second.Signal();  // Coalesced.
+  EXPECT_TRUE(first.IsPending());
+  EXPECT_EQ(harness.Scheduler().TimeUntilNextTask(), 0u);
+  ASSERT_TRUE(harness.Pass());
+  EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+  EXPECT_FALSE(second.IsPending());
+  EXPECT_EQ(second.GetStatistics().signals, 2u);
+  EXPECT_EQ(second.GetStatistics().executions, 1u);
+}
+
+TEST(TaskEventTest, SignalsFromWithinTheTaskRequestAnotherPass)
+{
+  SchedulerHarness harness;
+  uint32_t executions{0};
+  TaskEvent* self{nullptr};
+  TaskEvent event{harness.Scheduler(), [&] {
+                    if (++executions < 3)
+                    {
+                      self->Signal();
+                    }
+                  }};
+  self = &event;
+  event.Signal();
+  EXPECT_TRUE(harness.Pass());
+  EXPECT_EQ(executions, 1u);  // The loop is not starved by re-signaling.
+  EXPECT_TRUE(harness.Pass());
+  EXPECT_TRUE(harness.Pass());
+  EXPECT_EQ(executions, 3u);
+  EXPECT_GT(harness.Scheduler().TimeUntilNextTask(), 0u);
+}
+
+TEST(TaskEventTest, DestroyedEventsAreWithdrawn)
+{
+  SchedulerHarness harness;
+  uint32_t executions{0};
+  TaskEvent kept{harness.Scheduler(), [&executions] { ++executions; }};
+  {
+    TaskEvent destroyed{harness.Scheduler(), [] { FAIL(); }};
+    destroyed.Signal();
+    kept.Signal();
+  }
+  harness.Pass();
+  EXPECT_EQ(executions, 1u);
+}
+
+TEST(TaskEventTest, LatencyIsMeasuredFromTheFirstSignal)
+{
+  SchedulerHarness harness;
+  TaskEvent event{harness.Scheduler(), [&harness] { harness.Work(50); }};
+  event.Signal();
+  harness.Work(250);
+  event.Signal();  // Coalesced, does not restart the measurement.
+  harness.Work(100);
+  harness.Pass();
+  event.Signal();
+  harness.Work(10);
+  harness.Pass();
+
+  const auto statistics = event.GetStatistics();
+  EXPECT_EQ(statistics.executions, 2u);
+  EXPECT_EQ(statistics.maxLatency, 350u);
+  EXPECT_EQ(statistics.totalLatency, 360u);
+}
+
+TEST(TaskEventTest, ConcurrentSignalsAreNeitherLostNorDuplicated)
+{
+  constexpr uint32_t SIGNALS{20000};
+  constexpr int THREADS{4};
+  SchedulerHarness harness;
+  harness.Scheduler().SetIdlePolicy(nullptr);  // Keep passing while the threads signal.
+  std::vector<uint32_t> executions(THREADS, 0);
+  std::vector<std::unique_ptr<TaskEvent>> events;
+  for (int i = 0; i < THREADS; ++i)
+  {
+    events.push_back(std::make_unique<TaskEvent>(harness.Scheduler(),
+                                                 [&executions, i] { ++executions[i]; }));
+  }
+  std::atomic<int> running{THREADS};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREADS; ++i)
+  {
+    threads.emplace_back([&, i] {
+      for (uint32_t n = 0; n < SIGNALS; ++n)
+      {
+        events[i]->Signal();
+      }
+      running.fetch_sub(1);
+    });
+  }
+  while (running.load() > 0)
+  {
+    harness.Scheduler().ExecuteNext();
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  harness.Scheduler().ExecuteNext();
+
+  for (int i = 0; i < THREADS; ++i)
+  {
+    const auto statistics = events[i]->GetStatistics();
+    EXPECT_EQ(statistics.signals, SIGNALS);
+    EXPECT_EQ(statistics.executions, executions[i]);
+    EXPECT_GE(executions[i], 1u);
+    EXPECT_LE(executions[i], SIGNALS);
+    EXPECT_FALSE(events[i]->IsPending());
+  }
+}
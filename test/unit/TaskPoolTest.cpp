@@ -0,0 +1,133 @@
+// Standard header
+#include <cstdint>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/TaskPool.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+/** Counts its instances to check that the pool constructs and destroys in place. */
+struct Counted
+{
+  explicit Counted(int& instances) : mInstances{instances} { ++mInstances; }
+  ~Counted() { --mInstances; }
+
+  int& mInstances;
+};
+}  // namespace
+
+TEST(TaskPoolTest, ReleasedSlotsAreReusedWithANewGeneration)
+{
+  int instances{0};
+  using Pool = TaskPool<Counted, 2>;
+  Pool pool;
+  const auto first = pool.Emplace(instances);
+  const auto second = pool.Emplace(instances);
+  EXPECT_EQ(pool.Emplace(instances), Pool::INVALID_ID);  // Exhausted.
+  EXPECT_EQ(instances, 2);
+
+  EXPECT_TRUE(pool.Release(first));
+  EXPECT_EQ(instances, 1);
+  EXPECT_FALSE(pool.Release(first));
+  const auto reused = pool.Emplace(instances);
+  EXPECT_EQ(reused & 0xFFFF, first & 0xFFFF);  // Same slot...
+  EXPECT_NE(reused, first);                    // ...but the stale id does not address it.
+  EXPECT_EQ(pool.Get(first), nullptr);
+  EXPECT_NE(pool.Get(reused), nullptr);
+  EXPECT_NE(pool.Get(second), nullptr);
+  EXPECT_EQ(pool.Size(), 2u);
+  EXPECT_EQ(pool.HighWaterMark(), 2u);
+}
+
+TEST(TaskPoolTest, GenerationWrapsAroundWithoutHandingOutInvalidIds)
+{
+  int instances{0};
+  using Pool = TaskPool<Counted, 1>;
+  Pool pool;
+  const auto initial = pool.Emplace(instances);
+  EXPECT_EQ(initial >> 16, 1u);
+  pool.Release(initial);
+
+  auto id = Pool::INVALID_ID;
+  for (uint32_t i = 2; i <= 0xFFFF; ++i)
+  {
+    id = pool.Emplace(instances);
+    ASSERT_EQ(id >> 16, i);
+    ASSERT_TRUE(pool.Release(id));
+  }
+  // Generation 0 is skipped, so the next id is not INVALID_ID even for slot 0.
+  id = pool.Emplace(instances);
+  EXPECT_NE(id, Pool::INVALID_ID);
+  EXPECT_EQ(id >> 16, 1u);
+  // Ids are only unique within 65535 generations of a slot.
+  EXPECT_EQ(id, initial);
+  pool.Release(id);
+  EXPECT_EQ(instances, 0);
+}
+
+TEST(TaskPoolTest, RejectsIdsOutOfRange)
+{
+  int instances{0};
+  using Pool = TaskPool<Counted, 4>;
+  Pool pool;
+  pool.Emplace(instances);
+  EXPECT_EQ(pool.Get(Pool::INVALID_ID), nullptr);
+  EXPECT_EQ(pool.Get((1u << 16) | 4), nullptr);
+  EXPECT_EQ(pool.Get((1u << 16) | 0xFFFF), nullptr);
+  EXPECT_FALSE(pool.Release((1u << 16) | 3));  // Free slot.
+}
+
+TEST(TaskPoolTest, DestroysObjectsStillAlive)
+{
+  int instances{0};
+  {
+    TaskPool<Counted, 8> pool;
+    for (int i = 0; i < 5; ++i)
+    {
+      pool.Emplace(instances);
+    }
+    pool.ForEach([&pool](const auto id, Counted&) {
+      if ((id & 0xFFFF) % 2 == 0)
+      {
+        pool.Release(id);  // Releasing during the iteration is allowed.
+      }
+    });
+    EXPECT_EQ(instances, 2);
+  }
+  EXPECT_EQ(instances, 0);
+}
+
+TEST(TaskPoolTest, SchedulerRecyclesSlotsRightAfterTheTasksFinished)
+{
+  SchedulerHarness harness;
+  auto& scheduler = harness.Scheduler();
+  // Far more one shot tasks over time than the pool has slots.
+  uint32_t runs{0};
+  for (uint32_t i = 0; i < 10 * MAX_TASKS; ++i)
+  {
+    ASSERT_NE(scheduler.AddOneShotTask(1, [&runs] { ++runs; }), INVALID_TASKID);
+    harness.RunFor(1);
+    ASSERT_EQ(scheduler.GetPoolStatistics().used, 0u);
+  }
+  EXPECT_EQ(runs, 10u * MAX_TASKS);
+  EXPECT_EQ(scheduler.GetPoolStatistics().highWaterMark, 1u);
+
+  // A full pool rejects further tasks until one is aborted.
+  std::vector<TaskId> ids;
+  for (uint32_t i = 0; i < MAX_TASKS; ++i)
+  {
+    ids.push_back(scheduler.AddCyclicTask(TASK_SECOND, [] {}));
+  }
+  EXPECT_EQ(scheduler.AddCyclicTask(TASK_SECOND, [] {}), INVALID_TASKID);
+  EXPECT_TRUE(scheduler.AbortTask(ids.front()));
+  EXPECT_NE(scheduler.AddCyclicTask(TASK_SECOND, [] {}), INVALID_TASKID);
+  EXPECT_FALSE(scheduler.AbortTask(ids.front()));  // Stale id of the recycled slot.
+}
@@ -0,0 +1,114 @@
+// Standard header
+#include <cstdint>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/TaskProfile.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+/** Copies the profiles of all tasks (the main task first). */
+std::vector<CooperativeScheduler::TaskProfileSnapshot> Snapshot(CooperativeScheduler& scheduler)
+{
+  std::vector<CooperativeScheduler::TaskProfileSnapshot> snapshots(MAX_TASKS + 1);
+  snapshots.resize(scheduler.GetTaskProfiles(snapshots.data(), MAX_TASKS + 1));
+  return snapshots;
+}
+}  // namespace
+
+TEST(TaskProfileTest, LatenciesAreSortedIntoPowerOfTwoBuckets)
+{
+  TaskProfile profile{};
+  for (const uint32_t latency : {0u, 1u, 2u, 3u, 4u, 7u, 8u, 63u, 64u, 100000u})
+  {
+    profile.Record(latency, 0);
+  }
+  const uint16_t expected[TaskProfile::LATENCY_BUCKETS]{1, 1, 2, 2, 1, 0, 1, 2};
+  for (uint8_t i = 0; i < TaskProfile::LATENCY_BUCKETS; ++i)
+  {
+    EXPECT_EQ(profile.latencyHistogram[i], expected[i]) << "bucket " << int{i};
+  }
+
+  TaskProfile saturated{};
+  for (uint32_t i = 0; i < UINT16_MAX + 10u; ++i)
+  {
+    saturated.Record(0, 0);
+  }
+  EXPECT_EQ(saturated.latencyHistogram[0], UINT16_MAX);
+  EXPECT_EQ(saturated.runs, UINT16_MAX + 10u);
+}
+
+TEST(TaskProfileTest, RecordsExecutionTimesAndOverruns)
+{
+  SchedulerHarness harness;
+  auto& scheduler = harness.Scheduler();
+  const uint32_t work[]{1000, 3000, 2000};
+  uint32_t run{0};
+  const TaskId id = scheduler.AddCyclicTask(
+      10, [&] { harness.Work(work[run++ % 3]); }, 2);  // Timeout of 2 ms.
+  harness.RunFor(35);
+  ASSERT_EQ(run, 3u);
+
+  const auto snapshots = Snapshot(scheduler);
+  ASSERT_EQ(snapshots.size(), 2u);
+  EXPECT_EQ(snapshots[0].id, INVALID_TASKID);  // The main task comes first.
+  EXPECT_EQ(snapshots[0].profile.runs, 0u);
+  EXPECT_EQ(snapshots[1].id, id);
+  const auto& profile = snapshots[1].profile;
+  EXPECT_EQ(profile.timeout, 2u);
+  EXPECT_EQ(profile.runs, 3u);
+  EXPECT_EQ(profile.minExecutionTime, 1000u);
+  EXPECT_EQ(profile.maxExecutionTime, 3000u);
+  EXPECT_EQ(profile.AverageExecutionTime(), 2000u);
+  EXPECT_EQ(profile.overruns, 1u);  // Only the run taking 3 ms, taking 2 ms is within.
+  EXPECT_EQ(profile.latencyHistogram[0], 3u);  // Nothing delayed the starts.
+}
+
+TEST(TaskProfileTest, RecordsTheStartLatencyCausedByOtherTasks)
+{
+  SchedulerHarness harness;
+  auto& scheduler = harness.Scheduler();
+  scheduler.AddOneShotTask(10, [&harness] { harness.Work(5000); });
+  const TaskId delayed = scheduler.AddCyclicTask(10, [] {});
+  harness.RunFor(10);
+
+  const auto snapshots = Snapshot(scheduler);
+  ASSERT_EQ(snapshots.size(), 2u);  // The one shot task is gone.
+  EXPECT_EQ(snapshots[1].id, delayed);
+  const auto& profile = snapshots[1].profile;
+  EXPECT_EQ(profile.runs, 1u);
+  EXPECT_EQ(profile.latencyHistogram[3], 1u);  // Started 5 ms late (4-7 ms).
+}
+
+TEST(TaskProfileTest, ResetKeepsTheTimeouts)
+{
+  SchedulerHarness harness;
+  auto& scheduler = harness.Scheduler();
+  scheduler.AddCyclicTask(1, [&harness] { harness.Work(100); }, 50);
+  harness.RunFor(10);
+  ASSERT_GT(Snapshot(scheduler)[1].profile.runs, 0u);
+
+  scheduler.ResetTaskProfiles();
+  const auto snapshots = Snapshot(scheduler);
+  ASSERT_EQ(snapshots.size(), 2u);
+  for (const auto& snapshot : snapshots)
+  {
+    EXPECT_EQ(snapshot.profile.runs, 0u);
+    EXPECT_EQ(snapshot.profile.totalExecutionTime, 0u);
+    EXPECT_EQ(snapshot.profile.maxExecutionTime, 0u);
+    EXPECT_EQ(snapshot.profile.latencyHistogram[0], 0u);
+  }
+  EXPECT_EQ(snapshots[1].profile.timeout, 50u);
+
+  CooperativeScheduler::TaskProfileSnapshot single{};
+  EXPECT_EQ(scheduler.GetTaskProfiles(&single, 1), 1u);  // Bounded by the buffer.
+  EXPECT_EQ(single.id, INVALID_TASKID);
+  EXPECT_EQ(scheduler.GetTaskProfiles(nullptr, 0), 0u);
+}
@@ -0,0 +1,212 @@
+// Standard header
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/TimingWheel.hpp>
+
+using Esp32Modules::Core::Scheduling::TimingWheel;
+using Tick = TimingWheel::Tick;
+
+namespace
+{
+struct TestTimer : public TimingWheel::Timer
+{
+  size_t index{0};
+};
+
+/** Pops all expired timers and returns their indices. */
+std::set<size_t> PopAll(TimingWheel& wheel)
+{
+  std::set<size_t> expired;
+  while (auto* timer = wheel.PopExpired())
+  {
+    expired.insert(static_cast<TestTimer*>(timer)->index);
+  }
+  return expired;
+}
+}  // namespace
+
+TEST(TimingWheelTest, TimersExpireAtTheirExactTickOnEachLevel)
+{
+  // Deltas at the slot and level boundaries (each level covers 6 more bits).
+  for (const Tick delta : {1u, 2u, 63u, 64u, 65u, 4095u, 4096u, 4097u, 262143u, 262144u,
+                           16777216u + 3u, 1073741824u + 7u, 0x7FFFFFFFu})
+  {
+    for (const Tick start : {0u, 1000u, 0xFFFFFF00u})
+    {
+      TimingWheel wheel{start};
+      TestTimer timer;
+      wheel.Schedule(timer, start + delta);
+
+      Tick next{0};
+      ASSERT_TRUE(wheel.NextExpiry(next));
+      EXPECT_EQ(next, start + delta) << "delta " << delta << " start " << start;
+
+      wheel.Advance(start + delta - 1);  // Cascades to lower levels, must not expire early.
+      EXPECT_EQ(wheel.PopExpired(), nullptr) << "delta " << delta << " start " << start;
+      EXPECT_TRUE(timer.IsScheduled());
+      ASSERT_TRUE(wheel.NextExpiry(next));
+      EXPECT_EQ(next, start + delta);
+
+      wheel.Advance(start + delta);
+      EXPECT_EQ(wheel.PopExpired(), &timer) << "delta " << delta << " start " << start;
+      EXPECT_FALSE(timer.IsScheduled());
+      EXPECT_FALSE(wheel.NextExpiry(next));
+    }
+  }
+}
+
+TEST(TimingWheelTest, ClosestSlotWrapsAroundTheLevel)
+{
+  // Now in the last slot of level 0, the next timers are in the slots "behind" it.
+  TimingWheel wheel{63};
+  TestTimer early;
+  TestTimer late;
+  wheel.Schedule(late, 63 + 62);
+  wheel.Schedule(early, 63 + 2);
+
+  Tick next{0};
+  ASSERT_TRUE(wheel.NextExpiry(next));
+  EXPECT_EQ(next, 65u);
+  wheel.Advance(65);
+  EXPECT_EQ(wheel.PopExpired(), &early);
+  EXPECT_EQ(wheel.PopExpired(), nullptr);
+  ASSERT_TRUE(wheel.NextExpiry(next));
+  EXPECT_EQ(next, 125u);
+  wheel.Advance(125);
+  EXPECT_EQ(wheel.PopExpired(), &late);
+}
+
+TEST(TimingWheelTest, OverdueAndFarTimersExpireImmediately)
+{
+  TimingWheel wheel{1000};
+  TestTimer now;
+  TestTimer overdue;
+  TestTimer far;
+  wheel.Schedule(now, 1000);
+  wheel.Schedule(overdue, 999);
+  wheel.Schedule(far, 1000 + 0x80000000u);  // Indistinguishable from an overdue timer.
+
+  EXPECT_EQ(wheel.ExpiredCount(), 3u);
+  EXPECT_EQ(wheel.PopExpired(), &now);  // In order of scheduling.
+  EXPECT_EQ(wheel.PopExpired(), &overdue);
+  EXPECT_EQ(wheel.PopExpired(), &far);
+  EXPECT_EQ(wheel.ExpiredCount(), 0u);
+}
+
+TEST(TimingWheelTest, TimersWithTheSameExpiryKeepTheirOrder)
+{
+  for (const Tick delta : {1u, 100u, 5000u, 300000u})
+  {
+    TimingWheel wheel{0};
+    std::vector<TestTimer> timers(5);
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+      timers[i].index = i;
+      wheel.Schedule(timers[i], delta);
+    }
+    wheel.Advance(delta);
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+      auto* timer = static_cast<TestTimer*>(wheel.PopExpired());
+      ASSERT_NE(timer, nullptr);
+      EXPECT_EQ(timer->index, i) << "delta " << delta;
+    }
+  }
+}
+
+TEST(TimingWheelTest, CancelledTimersNeverExpire)
+{
+  TimingWheel wheel{0};
+  TestTimer kept;
+  TestTimer cancelled;
+  TestTimer expiredCancelled;
+  wheel.Schedule(kept, 5000);
+  wheel.Schedule(cancelled, 5000);  // Same slot as the kept timer.
+  wheel.Schedule(expiredCancelled, 0);
+  wheel.Cancel(cancelled);
+  wheel.Cancel(expiredCancelled);
+  wheel.Cancel(cancelled);  // No-op.
+
+  EXPECT_EQ(wheel.ExpiredCount(), 0u);
+  wheel.Advance(5000);
+  EXPECT_EQ(wheel.PopExpired(), &kept);
+  EXPECT_EQ(wheel.PopExpired(), nullptr);
+}
+
+TEST(TimingWheelTest, MatchesReferenceModelForRandomTimersAndSteps)
+{
+  for (const Tick start : {0u, 0xFFFF0000u})
+  {
+    std::mt19937 random{start + 42};
+    TimingWheel wheel{start};
+    std::vector<TestTimer> timers(2000);
+    Tick now = start;
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+      timers[i].index = i;
+      // Mix of short and long delays to exercise all levels.
+      const uint32_t bits = 1 + random() % 24;
+      wheel.Schedule(timers[i], now + 1 + random() % (1u << bits));
+    }
+
+    std::set<size_t> pending;
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+      pending.insert(i);
+    }
+    while (not pending.empty())
+    {
+      Tick next{0};
+      ASSERT_TRUE(wheel.NextExpiry(next));
+      Tick expected = timers[*pending.begin()].Expiry();
+      for (const size_t i : pending)
+      {
+        if (timers[i].Expiry() - now < expected - now)
+        {
+          expected = timers[i].Expiry();
+        }
+      }
+      ASSERT_EQ(next, expected);
+
+      // Advance in single ticks, to the next expiry or in large jumps.
+      const uint32_t mode = random() % 3;
+      const Tick step = (mode == 0) ? 1 : (mode == 1) ? (next - now) : (random() % 100000);
+      now += step;
+      wheel.Advance(now);
+
+      std::set<size_t> due;
+      for (const size_t i : pending)
+      {
+        if (timers[i].Expiry() - start <= now - start)
+        {
+          due.insert(i);
+        }
+      }
+      ASSERT_EQ(PopAll(wheel), due) << "now " << now;
+      for (const size_t i : due)
+      {
+        pending.erase(i);
+        // Reschedule some timers from the "callback" like cyclic tasks do.
+        if (random() % 4 == 0 and timers[i].Expiry() - start < 0x10000000u)
+        {
+          wheel.Schedule(timers[i], timers[i].Expiry() + 1 + random() % 5000);
+          if (timers[i].Expiry() - now > 0 and timers[i].Expiry() - now <= 0x7FFFFFFF)
+          {
+            pending.insert(i);
+          }
+          else
+          {
+            ASSERT_EQ(wheel.PopExpired(), &timers[i]);  // Already overdue.
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,196 @@
+// Standard header
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Third-party header
+#include <gtest/gtest.h>
+
+// Project header
+#include <esp32-modules/core/scheduling/WorkStealingDeque.hpp>
+#include <esp32-modules/core/scheduling/WorkStealingExecutor.hpp>
+#include <harness/SchedulerHarness.hpp>
+
+using namespace Esp32Modules::Core::Scheduling;
+using Esp32Modules::Test::SchedulerHarness;
+
+namespace
+{
+/** Waits (in real time) until the condition holds, returns false on timeout. */
+template <typename Condition>
+bool WaitFor(Condition condition)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (not condition())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+}  // namespace
+
+TEST(WorkStealingTest, OwnerPopsNewestAndThievesStealOldest)
+{
+  WorkStealingDeque<int, 4> deque;
+  int items[5] = {0, 1, 2, 3, 4};
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(deque.Push(&items[i]));
+  }
+  EXPECT_FALSE(deque.Push(&items[4]));  // Full.
+  EXPECT_EQ(deque.SizeApprox(), 4u);
+
+  EXPECT_EQ(deque.Pop(), &items[3]);
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Steal(), &items[1]);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+
+  // Indices keep growing, the ring buffer wraps around.
+  for (int round = 0; round < 10; ++round)
+  {
+    ASSERT_TRUE(deque.Push(&items[round % 5]));
+    ASSERT_EQ(deque.Steal(), &items[round % 5]);
+  }
+}
+
+TEST(WorkStealingTest, ConcurrentThievesTakeEachItemExactlyOnce)
+{
+  constexpr uint32_t ITEMS{200000};
+  constexpr int THIEVES{3};
+  WorkStealingDeque<uint32_t, 64> deque;
+  std::vector<uint32_t> values(ITEMS);
+  for (uint32_t i = 0; i < ITEMS; ++i)
+  {
+    values[i] = i;  // Written up front, ThreadSanitizer does not follow the fences of the deque.
+  }
+  auto taken = std::make_unique<std::atomic<uint8_t>[]>(ITEMS);
+  std::atomic<uint32_t> total{0};
+  std::atomic<bool> done{false};
+
+  auto take = [&](uint32_t* item) {
+    taken[*item].fetch_add(1);
+    total.fetch_add(1);
+  };
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < THIEVES; ++i)
+  {
+    thieves.emplace_back([&] {
+      while (not done.load())
+      {
+        if (auto* item = deque.Steal())
+        {
+          take(item);
+        }
+      }
+    });
+  }
+  for (uint32_t i = 0; i < ITEMS; ++i)
+  {
+    while (not deque.Push(&values[i]))
+    {
+      if (auto* item = deque.Pop())  // The owner helps while the deque is full.
+      {
+        take(item);
+      }
+    }
+    if (i % 7 == 0)
+    {
+      if (auto* item = deque.Pop())
+      {
+        take(item);
+      }
+    }
+  }
+  while (auto* item = deque.Pop())
+  {
+    take(item);
+  }
+  ASSERT_TRUE(WaitFor([&] { return total.load() == ITEMS; }));
+  done.store(true);
+  for (auto& thief : thieves)
+  {
+    thief.join();
+  }
+
+  for (uint32_t i = 0; i < ITEMS; ++i)
+  {
+    ASSERT_EQ(taken[i].load(), 1u) << "item " << i;
+  }
+}
+
+TEST(WorkStealingTest, CompletionsRunInTheCooperativeLoop)
+{
+  SchedulerHarness harness;
+  WorkStealingExecutor executor{harness.Scheduler(), 10 * TASK_MILLISECOND};
+  constexpr uint32_t JOBS{WorkStealingExecutor::MAX_JOBS};
+  std::atomic<uint32_t> worked{0};
+  uint32_t completed{0};
+  const auto loop = std::this_thread::get_id();
+  bool completedInLoop{true};
+
+  for (uint32_t i = 0; i < JOBS; ++i)
+  {
+    ASSERT_NE(executor.Post([&worked] { worked.fetch_add(1); },
+                            [&] {
+                              ++completed;
+                              completedInLoop &= (std::this_thread::get_id() == loop);
+                            }),
+              INVALID_JOBID);
+  }
+  EXPECT_EQ(executor.Post([] {}), INVALID_JOBID);  // All job slots in use.
+
+  ASSERT_TRUE(WaitFor([&] { return worked.load() == JOBS; }));
+  EXPECT_EQ(completed, 0u);  // Only in the cooperative loop.
+  harness.RunFor(10 * TASK_MILLISECOND);
+  EXPECT_EQ(completed, JOBS);
+  EXPECT_TRUE(completedInLoop);
+
+  uint32_t executed{0};
+  for (uint8_t i = 0; i < WorkStealingExecutor::WORKERS; ++i)
+  {
+    executed += executor.GetWorkerStatistics(i).executed;
+  }
+  EXPECT_EQ(executed, JOBS);
+  EXPECT_NE(executor.Post([] {}), INVALID_JOBID);  // Slots are free again.
+}
+
+TEST(WorkStealingTest, IdleWorkersStealFromABusyOne)
+{
+  static_assert(WorkStealingExecutor::WORKERS == 2);
+  SchedulerHarness harness;
+  WorkStealingExecutor executor{harness.Scheduler()};
+  constexpr uint32_t JOBS{16};
+  std::atomic<uint32_t> others{0};
+
+  // The first job blocks its worker until all other jobs (posted to the same worker) are done.
+  std::atomic<bool> blocking{false};
+  executor.Post(
+      [&] {
+        blocking.store(true);
+        WaitFor([&] { return others.load() == JOBS - 1; });
+      },
+      nullptr, 0);
+  ASSERT_TRUE(WaitFor([&] { return blocking.load(); }));
+  // Steals are counted before the job runs, so the blocked worker is known by now.
+  const uint8_t blocked = (executor.GetWorkerStatistics(1).stolen == 1) ? 1 : 0;
+  const uint8_t thief = 1 - blocked;
+  for (uint32_t i = 1; i < JOBS; ++i)
+  {
+    executor.Post([&others] { others.fetch_add(1); }, nullptr, blocked);
+  }
+
+  ASSERT_TRUE(WaitFor([&] { return others.load() == JOBS - 1; }));
+  EXPECT_EQ(executor.GetWorkerStatistics(thief).executed, JOBS - 1);
+  EXPECT_EQ(executor.GetWorkerStatistics(thief).stolen, JOBS - 1);
+  ASSERT_TRUE(WaitFor([&] { return executor.GetWorkerStatistics(blocked).executed == 1; }));
+  EXPECT_EQ(executor.ProcessCompletions(), JOBS);
+}